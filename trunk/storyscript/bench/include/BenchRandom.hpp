@@ -0,0 +1,43 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.  Full license information is included in the file in the top directory named "license".
+
+NOTES: A small random number generator for the benchmark tools.
+*/
+
+#if !defined(SS_BenchRandom)
+#define SS_BenchRandom
+
+#include <boost/cstdint.hpp>
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+ NOTES: A xorshift generator.  Unlike rand(), it gives the same numbers
+		everywhere, so a seed always makes the same corpus, and the same
+		walk through it.
+*/
+class BenchRandom
+{
+public:
+	BenchRandom( unsigned long Seed = 1 )
+		: mState( (boost::uint32_t)Seed ? (boost::uint32_t)Seed : 1 ) {}
+
+	boost::uint32_t Next()
+	{
+		mState ^= mState << 13;
+		mState ^= mState >> 17;
+		mState ^= mState << 5;
+		return mState;
+	}
+
+	//Returns a number from 0 to N-1.
+	unsigned long Below( unsigned long N ){ return N ? Next() % N : 0; }
+
+private:
+	boost::uint32_t mState;
+};
+
+
+
+#endif
@@ -0,0 +1,94 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.  Full license information is included in the file in the top directory named "license".
+
+NOTES: Times benchmarks, and compares them against a baseline.
+*/
+
+#if !defined(SS_Benchmark)
+#define SS_Benchmark
+
+#include <boost/function.hpp>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+//The timings taken for one benchmark.
+struct BenchResult
+{
+	std::string Name;
+	std::string Unit;
+
+	//One timing per sample, sorted.
+	std::vector<double> Samples;
+
+	//Returns the P'th percentile (0-100) of the samples.
+	double GetPercentile( double P ) const;
+	double GetMedian() const { return GetPercentile( 50 ); }
+};
+
+
+//Median time of each benchmark, by name.
+typedef std::map< std::string, double > Baseline;
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+ NOTES: Runs benchmarks and keeps their timings.
+
+		Fast operations are run in batches, each long enough for the clock
+		to measure, and timed per unit of work (per word, per evaluation,
+		and so on).  Slow ones, like whole scripts, are timed one call at
+		a time.  Either way the first call is not counted, so nothing is
+		charged for warming up.
+*/
+class Benchmark
+{
+public:
+	Benchmark();
+
+	//How many samples Run takes of each benchmark.
+	void SetSamples( unsigned int Samples );
+
+	//How long (in microseconds) each of Run's batches should take at least.
+	void SetMinBatchTime( unsigned int Microseconds );
+
+	//Only benchmarks with Filter in their name are run.
+	void SetFilter( const std::string& Filter );
+	bool IsWanted( const std::string& Name ) const;
+
+	//Times Op in batches.  Op returns how many units of work it did.
+	//Timings are in nanoseconds per unit.
+	void Run( const std::string& Name, const std::string& Unit,
+			  boost::function<unsigned long ()> Op );
+
+	//Times Runs calls of Op, in milliseconds per call.
+	void RunEach( const std::string& Name, unsigned int Runs,
+				  boost::function<void ()> Op );
+
+	const std::vector<BenchResult>& GetResults() const;
+
+	//Reads a baseline written by WriteBaseline.  Returns false if it can't be read.
+	static bool ReadBaseline( const std::string& FileName, Baseline& B );
+	bool WriteBaseline( const std::string& FileName ) const;
+
+	//Prints the results, compared against the baseline (if there is one).
+	//A median more than Tolerance percent slower than the baseline's is
+	//a regression.  Returns the number of regressions.
+	unsigned int Report( std::ostream& Out, const Baseline* pBaseline, double Tolerance ) const;
+
+private:
+	void AddResult( BenchResult& R );
+
+	unsigned int mSamples;
+	unsigned int mMinBatchTime;
+	std::string mFilter;
+
+	std::vector<BenchResult> mResults;
+};
+
+
+
+#endif
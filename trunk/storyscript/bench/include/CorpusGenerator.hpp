@@ -0,0 +1,83 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.  Full license information is included in the file in the top directory named "license".
+
+NOTES: Writes made-up conversations, as big as you like, for load tests.
+*/
+
+#if !defined(SS_CorpusGenerator)
+#define SS_CorpusGenerator
+
+#include "BenchRandom.hpp"
+
+#include <string>
+
+
+//What the corpus should look like.
+struct CorpusSettings
+{
+	CorpusSettings();
+
+	unsigned int Files;       //Not counting main.ssconv.
+	unsigned int Blocks;      //In each file.
+	unsigned int Branching;   //Choices in each block's 'next'.
+	unsigned int Complexity;  //Operators in each block's expression.
+	unsigned int StringSize;  //Characters in each line of dialogue.
+	unsigned int UseDepth;    //Files in each chain of 'use's.
+	unsigned long Seed;
+};
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+ NOTES: The files are split into chains, UseDepth long, where each file
+		uses the next one.  main.ssconv uses the first file of every
+		chain, and its 'start' block leads into each of them.
+
+		A block's choices can be in its own file or any file further down
+		its chain, since those are the ones it can see.  The last block
+		of the last file in a chain ends the conversation.  Everything
+		else goes on forever, so there is no end to where a walk can go.
+
+		Each file's 'use' comes after its blocks, so the first block of
+		main.ssconv is the first block loaded.
+*/
+class CorpusGenerator
+{
+public:
+	CorpusGenerator( const CorpusSettings& S );
+
+	//Writes main.ssconv and the rest of the files into Dir, which has
+	//to exist already.  Returns false if a file can't be written.
+	bool Write( const std::string& Dir );
+
+	//What the last Write wrote.
+	unsigned long GetBlockCount() const;
+	unsigned long GetByteCount() const;
+
+private:
+	bool WriteFile( const std::string& Dir, const std::string& Name, const std::string& Text );
+
+	std::string MakeMain();
+	std::string MakeFile( unsigned int File );
+	std::string MakeBlock( unsigned int File, unsigned int Block );
+	std::string MakeExpression( unsigned int File );
+	std::string MakeLine();
+
+	unsigned int GetChainStart( unsigned int File ) const;
+	unsigned int GetChainEnd( unsigned int File ) const;
+
+	static std::string GetFileName( unsigned int File );
+	static std::string GetBlockName( unsigned int File, unsigned int Block );
+	static std::string GetVariableName( unsigned int File, unsigned int Variable );
+
+	CorpusSettings mS;
+	BenchRandom mRandom;
+
+	unsigned long mBlockCount;
+	unsigned long mByteCount;
+};
+
+
+
+#endif
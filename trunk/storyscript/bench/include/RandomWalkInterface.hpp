@@ -0,0 +1,46 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.  Full license information is included in the file in the top directory named "license".
+
+NOTES: An interface that makes its choices at random.
+*/
+
+#if !defined(SS_RandomWalkInterface)
+#define SS_RandomWalkInterface
+
+#include "BenchRandom.hpp"
+
+#include <Interface.hpp>
+#include <set>
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+ NOTES: Plays the player by picking any of the choices, and keeps count
+		of what it has seen.  Nothing is printed.
+*/
+class RandomWalkInterface : public SS::NullInterface
+{
+public:
+	RandomWalkInterface( SS::Interpreter& I, unsigned long Seed );
+
+	unsigned int PresentChoice( const SS::BlockList& Choices );
+
+	unsigned long GetLines() const;
+	unsigned long GetChoices() const;
+	unsigned long GetBlocksSeen() const;
+
+protected:
+	void SayBlock( const SS::BlockPtr pBlock );
+
+private:
+	BenchRandom mRandom;
+
+	unsigned long mLines;
+	unsigned long mChoices;
+	std::set<const SS::Block*> mSeen;
+};
+
+
+
+#endif
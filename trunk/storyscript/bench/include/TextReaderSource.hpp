@@ -0,0 +1,45 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.  Full license information is included in the file in the top directory named "license".
+
+NOTES: A reader source that reads a script out of a string, for the benchmarks.
+*/
+
+#if !defined(SS_TextReaderSource)
+#define SS_TextReaderSource
+
+#include <ReaderSource.hpp>
+
+namespace SS{
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+ NOTES: Hands the tokenizer lines straight out of the string, the way
+		ReaderSourceFile does with a mapped file, so the benchmarks time
+		the tokenizer and not the copying.
+*/
+class TextReaderSource : public ReaderSource
+{
+public:
+	TextReaderSource( const String& Name, const String& Text );
+
+	String GetName() const;
+
+private:
+	TextReaderSource();
+	TextReaderSource( const TextReaderSource& );
+	TextReaderSource& operator=( const TextReaderSource& );
+
+	String GetNextLine();
+	void GetNextLine( String& Storage, const Char*& pLine, size_t& Length );
+
+	String mName;
+	String mText;
+	size_t mPos;
+};
+
+}
+
+
+
+#endif
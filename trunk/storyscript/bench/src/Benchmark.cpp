@@ -0,0 +1,243 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.  Full license information is included in the file in the top directory named "license".
+
+NOTES: Times benchmarks, and compares them against a baseline.
+*/
+
+#include "Benchmark.hpp"
+
+#include <HelperFuncs.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: Nearest-rank percentile.  With the handful of samples a benchmark
+	   takes, interpolating wouldn't tell us anything more.
+*/
+double BenchResult::GetPercentile( double P ) const
+{
+	if( Samples.empty() ) return 0;
+
+	size_t Rank = (size_t)std::ceil( P / 100 * Samples.size() );
+	if( Rank > 0 ) Rank--;
+	if( Rank >= Samples.size() ) Rank = Samples.size() - 1;
+
+	return Samples[Rank];
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: Constructor
+*/
+Benchmark::Benchmark()
+	: mSamples( 15 ), mMinBatchTime( 20000 )
+{
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: Settings
+*/
+void Benchmark::SetSamples( unsigned int Samples )
+{
+	mSamples = Samples ? Samples : 1;
+}
+
+void Benchmark::SetMinBatchTime( unsigned int Microseconds )
+{
+	mMinBatchTime = Microseconds;
+}
+
+void Benchmark::SetFilter( const std::string& Filter )
+{
+	mFilter = Filter;
+}
+
+bool Benchmark::IsWanted( const std::string& Name ) const
+{
+	return Name.find( mFilter ) != std::string::npos;
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: Works out how many calls make a batch, then times mSamples batches.
+*/
+void Benchmark::Run( const std::string& Name, const std::string& Unit,
+					 boost::function<unsigned long ()> Op )
+{
+	if( !IsWanted( Name ) ) return;
+
+	//Warm up.
+	Op();
+
+	unsigned long Calls = 0;
+	boost::uint64_t Start = SS::GetMicroseconds();
+	do{
+		Op();
+		Calls++;
+	}while( SS::GetMicroseconds() - Start < mMinBatchTime );
+
+	BenchResult R;
+	R.Name = Name;
+	R.Unit = Unit;
+
+	unsigned int i;
+	for( i = 0; i < mSamples; i++ )
+	{
+		unsigned long Units = 0;
+		unsigned long j;
+
+		Start = SS::GetMicroseconds();
+		for( j = 0; j < Calls; j++ ) Units += Op();
+		boost::uint64_t Time = SS::GetMicroseconds() - Start;
+
+		R.Samples.push_back( Units ? (double)Time * 1000 / Units : 0 );
+	}
+
+	AddResult( R );
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: Times each call on its own.
+*/
+void Benchmark::RunEach( const std::string& Name, unsigned int Runs,
+						 boost::function<void ()> Op )
+{
+	if( !IsWanted( Name ) ) return;
+
+	//Warm up.
+	Op();
+
+	BenchResult R;
+	R.Name = Name;
+	R.Unit = "ms/run";
+
+	unsigned int i;
+	for( i = 0; i < Runs; i++ )
+	{
+		boost::uint64_t Start = SS::GetMicroseconds();
+		Op();
+		R.Samples.push_back( (double)(SS::GetMicroseconds() - Start) / 1000 );
+	}
+
+	AddResult( R );
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: Keeps a finished benchmark.
+*/
+void Benchmark::AddResult( BenchResult& R )
+{
+	std::sort( R.Samples.begin(), R.Samples.end() );
+	mResults.push_back( R );
+}
+
+const std::vector<BenchResult>& Benchmark::GetResults() const
+{
+	return mResults;
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: The baseline is just a name and a median on each line.  Lines
+	   starting with '#' are comments.
+*/
+bool Benchmark::ReadBaseline( const std::string& FileName, Baseline& B )
+{
+	std::ifstream File( FileName.c_str() );
+	if( !File ) return false;
+
+	std::string Line;
+	while( std::getline( File, Line ) )
+	{
+		if( Line.empty() || Line[0] == '#' ) continue;
+
+		std::istringstream Fields( Line );
+		std::string Name;
+		double Median;
+		if( Fields >> Name >> Median ) B[Name] = Median;
+	}
+
+	return true;
+}
+
+bool Benchmark::WriteBaseline( const std::string& FileName ) const
+{
+	std::ofstream File( FileName.c_str() );
+	if( !File ) return false;
+
+	File << "# ssbench baseline: benchmark, median\n";
+
+	size_t i;
+	for( i = 0; i < mResults.size(); i++ ){
+		File << mResults[i].Name << " " << std::setprecision( 6 ) << mResults[i].GetMedian() << "\n";
+	}
+
+	return (bool)File;
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: One line per benchmark: its median and 10th and 90th percentiles,
+	   and how the median compares to the baseline's.
+*/
+unsigned int Benchmark::Report( std::ostream& Out, const Baseline* pBaseline, double Tolerance ) const
+{
+	unsigned int Regressions = 0;
+
+	Out << std::left << std::setw( 28 ) << "benchmark" << std::right
+		<< std::setw( 10 ) << "unit"
+		<< std::setw( 12 ) << "median"
+		<< std::setw( 12 ) << "p10"
+		<< std::setw( 12 ) << "p90";
+	if( pBaseline ) Out << std::setw( 12 ) << "baseline" << std::setw( 10 ) << "change";
+	Out << "\n";
+
+	Out << std::fixed << std::setprecision( 2 );
+
+	size_t i;
+	for( i = 0; i < mResults.size(); i++ )
+	{
+		const BenchResult& R = mResults[i];
+
+		Out << std::left << std::setw( 28 ) << R.Name << std::right
+			<< std::setw( 10 ) << R.Unit
+			<< std::setw( 12 ) << R.GetMedian()
+			<< std::setw( 12 ) << R.GetPercentile( 10 )
+			<< std::setw( 12 ) << R.GetPercentile( 90 );
+
+		if( pBaseline )
+		{
+			Baseline::const_iterator j = pBaseline->find( R.Name );
+			if( j == pBaseline->end() || j->second <= 0 ) Out << std::setw( 12 ) << "-" << "       new";
+			else
+			{
+				double Change = (R.GetMedian() - j->second) / j->second * 100;
+
+				Out << std::setw( 12 ) << j->second
+					<< std::setw( 9 ) << std::showpos << Change << std::noshowpos << "%";
+
+				if( Change > Tolerance )
+				{
+					Out << "  REGRESSION";
+					Regressions++;
+				}
+				else if( Change < -Tolerance ) Out << "  faster";
+			}
+		}
+
+		Out << "\n";
+	}
+
+	Out.unsetf( std::ios::floatfield );
+	return Regressions;
+}
@@ -0,0 +1,270 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.  Full license information is included in the file in the top directory named "license".
+
+NOTES: Writes made-up conversations, as big as you like, for load tests.
+*/
+
+#include "CorpusGenerator.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+
+//Variables declared at the top of each file.
+static const unsigned int CORPUS_VARIABLES = 8;
+
+//What the dialogue is made of.
+static const char* const CORPUS_WORDS[] = {
+	"the", "a", "king", "ghost", "sword", "castle", "night", "said",
+	"walks", "never", "again", "why", "madness", "quiet", "speak", "cause"
+};
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: Constructors
+*/
+CorpusSettings::CorpusSettings()
+	: Files( 10 ), Blocks( 100 ), Branching( 3 ), Complexity( 4 ),
+	  StringSize( 80 ), UseDepth( 3 ), Seed( 1 )
+{
+}
+
+CorpusGenerator::CorpusGenerator( const CorpusSettings& S )
+	: mS( S ), mRandom( S.Seed ), mBlockCount( 0 ), mByteCount( 0 )
+{
+	if( mS.Blocks == 0 ) mS.Blocks = 1;
+	if( mS.Branching == 0 ) mS.Branching = 1;
+	if( mS.UseDepth == 0 ) mS.UseDepth = 1;
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: Writes the whole corpus.
+*/
+bool CorpusGenerator::Write( const std::string& Dir )
+{
+	mRandom = BenchRandom( mS.Seed );
+	mBlockCount = 0;
+	mByteCount = 0;
+
+	if( !WriteFile( Dir, "main.ssconv", MakeMain() ) ) return false;
+
+	unsigned int i;
+	for( i = 0; i < mS.Files; i++ ){
+		if( !WriteFile( Dir, GetFileName( i ), MakeFile( i ) ) ) return false;
+	}
+
+	return true;
+}
+
+bool CorpusGenerator::WriteFile( const std::string& Dir, const std::string& Name, const std::string& Text )
+{
+	std::ofstream File( (Dir + "/" + Name).c_str() );
+	if( !File ) return false;
+
+	File << Text;
+	mByteCount += (unsigned long)Text.length();
+
+	return (bool)File;
+}
+
+unsigned long CorpusGenerator::GetBlockCount() const
+{
+	return mBlockCount;
+}
+
+unsigned long CorpusGenerator::GetByteCount() const
+{
+	return mByteCount;
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: main.ssconv is just a way in to every chain.
+*/
+std::string CorpusGenerator::MakeMain()
+{
+	std::ostringstream Out;
+
+	Out << "/*\n"
+		<< "\tMade by ssgen: " << mS.Files << " files of " << mS.Blocks << " blocks,\n"
+		<< "\t" << mS.Branching << " choices a block, chains of " << mS.UseDepth << " files,\n"
+		<< "\tseed " << mS.Seed << ".\n"
+		<< "*/\n\n";
+
+	Out << "start{\n"
+		<< "\t\"" << MakeLine() << "\";\n";
+
+	unsigned int i;
+	if( mS.Files == 0 ) Out << "\tnext = end;\n";
+	else
+	{
+		Out << "\tnext = (";
+		for( i = 0; i < mS.Files; i += mS.UseDepth ){
+			Out << (i ? ", " : "") << GetBlockName( i, 0 );
+		}
+		Out << ");\n";
+	}
+	Out << "}\n\n";
+	mBlockCount++;
+
+	for( i = 0; i < mS.Files; i += mS.UseDepth ){
+		Out << "use \"" << GetFileName( i ) << "\";\n";
+	}
+
+	return Out.str();
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: A file's variables, its blocks, then the next file in its chain.
+*/
+std::string CorpusGenerator::MakeFile( unsigned int File )
+{
+	std::ostringstream Out;
+
+	Out << "//" << GetFileName( File ) << ": " << GetBlockName( File, 0 )
+		<< " to " << GetBlockName( File, mS.Blocks - 1 ) << ".\n\n";
+
+	unsigned int i;
+	for( i = 0; i < CORPUS_VARIABLES; i++ ){
+		Out << "var " << GetVariableName( File, i ) << " = " << mRandom.Below( 9 ) + 1 << ";\n";
+	}
+	Out << "\n\n";
+
+	for( i = 0; i < mS.Blocks; i++ ) Out << MakeBlock( File, i );
+
+	if( File < GetChainEnd( File ) ){
+		Out << "\nuse \"" << GetFileName( File + 1 ) << "\";\n";
+	}
+
+	return Out.str();
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: A line of dialogue, a visit count, something to work out, and
+	   where to go next.
+*/
+std::string CorpusGenerator::MakeBlock( unsigned int File, unsigned int Block )
+{
+	std::ostringstream Out;
+
+	Out << GetBlockName( File, Block ) << "{\n"
+		<< "\t\"" << MakeLine() << "\";\n"
+		<< "\t" << GetVariableName( File, 0 ) << " += 1;\n"
+		<< "\tvar t = " << MakeExpression( File ) << ";\n";
+
+	if( File == GetChainEnd( File ) && Block == mS.Blocks - 1 ) Out << "\tnext = end;\n";
+	else
+	{
+		unsigned int Files = GetChainEnd( File ) - File + 1;
+
+		Out << "\tnext = (";
+		unsigned int i;
+		for( i = 0; i < mS.Branching; i++ ){
+			Out << (i ? ", " : "")
+				<< GetBlockName( File + mRandom.Below( Files ), mRandom.Below( mS.Blocks ) );
+		}
+		Out << ");\n";
+	}
+
+	Out << "}\n\n";
+	mBlockCount++;
+
+	return Out.str();
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: Adds, subtracts and multiplies the file's variables, the variables
+	   of files further down the chain, and small numbers.  Nothing that
+	   could divide by zero.
+*/
+std::string CorpusGenerator::MakeExpression( unsigned int File )
+{
+	static const char* const Operators[] = { " + ", " - ", " * " };
+
+	unsigned int Files = GetChainEnd( File ) - File + 1;
+	std::ostringstream Out;
+
+	unsigned int i;
+	for( i = 0; i <= mS.Complexity; i++ )
+	{
+		if( i ) Out << Operators[mRandom.Below( 3 )];
+
+		bool Parens = i < mS.Complexity && mRandom.Below( 3 ) == 0;
+		if( Parens ) Out << "(";
+
+		if( mRandom.Below( 4 ) == 0 ) Out << mRandom.Below( 100 );
+		else Out << GetVariableName( File + mRandom.Below( Files ), mRandom.Below( CORPUS_VARIABLES ) );
+
+		if( Parens )
+		{
+			Out << Operators[mRandom.Below( 3 )] << mRandom.Below( 9 ) + 1 << ")";
+		}
+	}
+
+	return Out.str();
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: Words picked at random, StringSize characters' worth.
+*/
+std::string CorpusGenerator::MakeLine()
+{
+	std::string Line;
+	while( Line.length() < mS.StringSize )
+	{
+		if( !Line.empty() ) Line += ' ';
+		Line += CORPUS_WORDS[mRandom.Below( sizeof(CORPUS_WORDS) / sizeof(CORPUS_WORDS[0]) )];
+	}
+
+	Line.resize( mS.StringSize );
+	return Line;
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: Where a file's chain begins and ends.
+*/
+unsigned int CorpusGenerator::GetChainStart( unsigned int File ) const
+{
+	return File - File % mS.UseDepth;
+}
+
+unsigned int CorpusGenerator::GetChainEnd( unsigned int File ) const
+{
+	unsigned int End = GetChainStart( File ) + mS.UseDepth - 1;
+	return End < mS.Files ? End : mS.Files - 1;
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: Names.  Block and variable names carry their file's number so
+	   they are unique over the whole corpus.
+*/
+std::string CorpusGenerator::GetFileName( unsigned int File )
+{
+	std::ostringstream Out;
+	Out << "part" << std::setw( 3 ) << std::setfill( '0' ) << File << ".ssconv";
+	return Out.str();
+}
+
+std::string CorpusGenerator::GetBlockName( unsigned int File, unsigned int Block )
+{
+	std::ostringstream Out;
+	Out << "f" << File << "b" << Block;
+	return Out.str();
+}
+
+std::string CorpusGenerator::GetVariableName( unsigned int File, unsigned int Variable )
+{
+	std::ostringstream Out;
+	Out << "f" << File << "v" << Variable;
+	return Out.str();
+}
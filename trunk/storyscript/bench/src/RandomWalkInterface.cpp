@@ -0,0 +1,59 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.  Full license information is included in the file in the top directory named "license".
+
+NOTES: An interface that makes its choices at random.
+*/
+
+#include "RandomWalkInterface.hpp"
+
+#include <Block.hpp>
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: Constructor
+*/
+RandomWalkInterface::RandomWalkInterface( SS::Interpreter& I, unsigned long Seed )
+	: SS::NullInterface( I ), mRandom( Seed ), mLines( 0 ), mChoices( 0 )
+{
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: Any choice will do.
+*/
+unsigned int RandomWalkInterface::PresentChoice( const SS::BlockList& Choices )
+{
+	mChoices++;
+	return (unsigned int)mRandom.Below( (unsigned long)Choices.size() );
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: Counts the line instead of saying it.
+*/
+void RandomWalkInterface::SayBlock( const SS::BlockPtr pBlock )
+{
+	mLines++;
+	mSeen.insert( pBlock.get() );
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: Counts
+*/
+unsigned long RandomWalkInterface::GetLines() const
+{
+	return mLines;
+}
+
+unsigned long RandomWalkInterface::GetChoices() const
+{
+	return mChoices;
+}
+
+unsigned long RandomWalkInterface::GetBlocksSeen() const
+{
+	return (unsigned long)mSeen.size();
+}
@@ -0,0 +1,74 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.  Full license information is included in the file in the top directory named "license".
+
+NOTES: A reader source that reads a script out of a string, for the benchmarks.
+*/
+
+#include "TextReaderSource.hpp"
+
+using namespace SS;
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: Constructor
+*/
+TextReaderSource::TextReaderSource( const String& Name, const String& Text )
+	: mName( Name ), mText( Text ), mPos( 0 )
+{
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: Only here because ReaderSource requires it.  The other GetNextLine
+	   is the one that gets called.
+*/
+String TextReaderSource::GetNextLine()
+{
+	String Storage;
+	const Char* pLine;
+	size_t Length;
+	GetNextLine( Storage, pLine, Length );
+
+	return String( pLine, Length );
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: Returns the next line, newline and all, without copying it.
+*/
+void TextReaderSource::GetNextLine( String& Storage, const Char*& pLine, size_t& Length )
+{
+	if( mPos >= mText.length() )
+	{
+		pLine = 0;
+		Length = 0;
+		return;
+	}
+
+	size_t End = mText.find( '\n', mPos );
+	if( End == String::npos )
+	{
+		//The tokenizer expects every line to have a line-break.
+		Storage.assign( mText, mPos, String::npos );
+		Storage += TXT("\n");
+		mPos = mText.length();
+
+		pLine = Storage.data();
+		Length = Storage.length();
+		return;
+	}
+
+	pLine = mText.data() + mPos;
+	Length = End + 1 - mPos;
+	mPos = End + 1;
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NOTES: Returns the name it was given.  It becomes the name of its scope.
+*/
+String TextReaderSource::GetName() const
+{
+	return mName;
+}
@@ -0,0 +1,301 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.  Full license information is included in the file in the top directory named "license".
+
+NOTES: Benchmarks the interpreter: the example scripts, run start to finish,
+	   and a few of the things they spend their time on.  The results can be
+	   saved as a baseline, and later runs compared against it.
+*/
+
+
+#include <iostream>
+#include <cstdlib>
+
+#include "GetPot.hpp"
+
+#include "Benchmark.hpp"
+#include "TextReaderSource.hpp"
+
+#include <Interpreter.hpp>
+#include <Interface.hpp>
+#include <Expression.hpp>
+#include <Scope.hpp>
+#include <Variable.hpp>
+#include <CreationFuncs.hpp>
+#include <ParserAnomaly.hpp>
+#include <SymbolTable.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+
+
+//The scripts that are timed, from cli/examples.
+static const char* const BENCH_SCRIPTS[] = {
+	"ackermann.ssconv",
+	"takfp.ssconv",
+	"PerformanceFactorial.ssconv"
+};
+
+typedef boost::shared_ptr<SS::Expression> ExpressionPtr;
+
+//The number of variables in the scope the lookups are done in.
+static const unsigned int BENCH_SCOPE_SIZE = 64;
+
+
+//Runs a script from start to finish, with nobody watching.
+static void RunScript( const SS::String& FileName )
+{
+	SS::Interpreter I;
+	SS::NullInterface N( I );
+	N.StartConversation( FileName );
+}
+
+
+//Reads every word in a source.
+static unsigned long ReadWords( SS::ReaderSource& Source )
+{
+	unsigned long Words = 0;
+	while( !(Source.GetNextWord() == SS::EOF_WORD) ) Words++;
+	return Words;
+}
+
+//Tokenizes Text from scratch.
+static unsigned long Tokenize( const SS::String* pText )
+{
+	SS::TextReaderSource Source( TXT("bench"), *pText );
+	return ReadWords( Source );
+}
+
+//Reads words that have already been tokenized.
+static unsigned long Reread( SS::ReaderSource* pSource )
+{
+	pSource->GotoPos( 0 );
+	return ReadWords( *pSource );
+}
+
+
+//Builds an expression out of the words in Text.
+static ExpressionPtr MakeExpression( SS::Interpreter& I, const SS::String& Text )
+{
+	SS::TextReaderSource Source( TXT("expression"), Text );
+	ExpressionPtr pExpression( new SS::Expression( I ) );
+
+	const SS::Word* pWord;
+	while( !(*(pWord = &Source.GetNextWord()) == SS::EOF_WORD) &&
+		   pWord->Type != SS::WORDTYPE_TERMINAL )
+	{
+		pExpression->push_back( *pWord );
+	}
+
+	return pExpression;
+}
+
+static unsigned long Evaluate( ExpressionPtr pExpression )
+{
+	pExpression->Evaluate();
+	return 1;
+}
+
+
+//Looks up every variable in the scope, by name and by symbol.
+static unsigned long LookupByName( SS::ScopePtr pScope, const std::vector<SS::CompoundString>* pNames )
+{
+	size_t i;
+	for( i = 0; i < pNames->size(); i++ ) pScope->GetScopeObject( (*pNames)[i] );
+	return (unsigned long)pNames->size();
+}
+
+static unsigned long LookupBySymbol( SS::ScopePtr pScope, const std::vector<SS::CompoundSymbol>* pSymbols )
+{
+	size_t i;
+	for( i = 0; i < pSymbols->size(); i++ ) pScope->GetScopeObject( (*pSymbols)[i] );
+	return (unsigned long)pSymbols->size();
+}
+
+
+//Number crunching, the way Expression does it.
+static unsigned long Add( SS::VariablePtr pX, SS::VariablePtr pY ){ *pX + *pY; return 1; }
+static unsigned long Multiply( SS::VariablePtr pX, SS::VariablePtr pY ){ *pX * *pY; return 1; }
+static unsigned long Divide( SS::VariablePtr pX, SS::VariablePtr pY ){ *pX / *pY; return 1; }
+static unsigned long Power( SS::VariablePtr pX, SS::VariablePtr pY ){ pX->operator_pow( *pY ); return 1; }
+
+static SS::VariablePtr MakeNumber( const SS::String& Number )
+{
+	return SS::CreateVariable<SS::Variable>( SS::String(), false, SS::StringType2NumType( Number ) );
+}
+
+
+
+int main( int argc, char* argv[] )
+{
+	GetPot cl( argc, argv );
+
+	if( cl.search( 2, "--help", "-h" ) )
+	{
+		std::cout << "Usage: ssbench [OPTIONS]\n";
+		std::cout << "Options are:\n";
+		std::cout << " --scripts DIR           Where the example scripts are.  (Default: ../cli/examples)\n";
+		std::cout << " --runs N                Times to run each script.  (Default: 5)\n";
+		std::cout << " --samples N             Samples to take of everything else.  (Default: 15)\n";
+		std::cout << " --filter TEXT           Only run benchmarks with TEXT in their name.\n";
+		std::cout << " --baseline FILE         Compare against FILE, or save to it if there isn't one yet.\n";
+		std::cout << " --save FILE             Save the results to FILE as the new baseline.\n";
+		std::cout << " --tolerance PCT         How much slower than the baseline is a regression.  (Default: 10)\n";
+		std::cout << "\nExits with 1 if anything regressed, 2 if a benchmark failed.\n";
+		return 0;
+	}
+
+	std::string ScriptDir = "../cli/examples";
+	if( cl.search( "--scripts" ) ) ScriptDir = cl.next( ScriptDir.c_str() );
+
+	int Runs = 5;
+	if( cl.search( "--runs" ) ) Runs = cl.next( Runs );
+
+	int Samples = 15;
+	if( cl.search( "--samples" ) ) Samples = cl.next( Samples );
+
+	std::string Filter;
+	if( cl.search( "--filter" ) ) Filter = cl.next( "" );
+
+	std::string BaselineFile;
+	if( cl.search( "--baseline" ) ) BaselineFile = cl.next( "" );
+
+	std::string SaveFile;
+	if( cl.search( "--save" ) ) SaveFile = cl.next( "" );
+
+	double Tolerance = 10;
+	if( cl.search( "--tolerance" ) ) Tolerance = cl.next( Tolerance );
+
+
+	Benchmark B;
+	B.SetSamples( Samples > 0 ? Samples : 1 );
+	B.SetFilter( Filter );
+
+	try{
+		/*
+			This interpreter is what the micro-benchmarks work in.  Making it
+			also sets up the tables the tokenizer needs, so it comes first.
+			(The setup script has to outlive it.)
+		*/
+		boost::scoped_ptr<SS::TextReaderSource> pSetupSource;
+		SS::Interpreter I;
+		SS::NullInterface N( I );
+
+
+		/*
+			Whole scripts.
+		*/
+		size_t i;
+		for( i = 0; i < sizeof(BENCH_SCRIPTS) / sizeof(BENCH_SCRIPTS[0]); i++ )
+		{
+			std::string Name = BENCH_SCRIPTS[i];
+			Name = "script." + Name.substr( 0, Name.find( '.' ) );
+
+			SS::String FileName = SS::NormalizeString( ScriptDir + "/" + BENCH_SCRIPTS[i] );
+			B.RunEach( Name, Runs > 0 ? Runs : 1, boost::bind( RunScript, FileName ) );
+		}
+
+
+		/*
+			The tokenizer.  The text is made up, but looks like the examples.
+		*/
+		SS::String Text;
+		unsigned int j;
+		for( j = 0; j < 200; j++ )
+		{
+			SS::String N = boost::lexical_cast<SS::String>( j );
+			Text += TXT("block") + N + TXT("{\n");
+			Text += TXT("\tvar tmp = in[0] * 2.5 + ") + N + TXT(";\n");
+			Text += TXT("\tif( tmp > 10 and tmp != 42 ) then out = tmp;\n");
+			Text += TXT("\telse out = block") + N + TXT("( tmp - 1 ) . \"a string\";\n");
+			Text += TXT("\tnext = end;\n}\n\n");
+		}
+
+		I.MakeCurrent();
+		B.Run( "word.tokenize", "ns/word", boost::bind( Tokenize, &Text ) );
+
+		SS::TextReaderSource Tokenized( TXT("bench"), Text );
+		ReadWords( Tokenized );
+		B.Run( "word.reread", "ns/word", boost::bind( Reread, &Tokenized ) );
+
+
+		/*
+			Everything else needs a script loaded to work in.
+		*/
+		SS::String Setup = TXT("var a = 12; var b = 30; var c = 7;\n"
+							   "var x = 1.5; var y = 2.25;\n");
+		for( j = 0; j < BENCH_SCOPE_SIZE; j++ ){
+			Setup += TXT("var v") + boost::lexical_cast<SS::String>( j ) + TXT(" = 0;\n");
+		}
+
+		pSetupSource.reset( new SS::TextReaderSource( TXT("bench"), Setup ) );
+		I.SetSource( *pSetupSource );
+		I.MakeCurrent();
+
+		B.Run( "expr.integer", "ns/eval", boost::bind( Evaluate, MakeExpression( I, TXT("(a + b) * c - a;") ) ) );
+		B.Run( "expr.real", "ns/eval", boost::bind( Evaluate, MakeExpression( I, TXT("x * y + x / y;") ) ) );
+		B.Run( "expr.compare", "ns/eval", boost::bind( Evaluate, MakeExpression( I, TXT("a < b and c > 3;") ) ) );
+
+
+		SS::ScopePtr pScope = I.GetCurrentScope();
+		std::vector<SS::CompoundString> Names;
+		std::vector<SS::CompoundSymbol> Symbols;
+		for( j = 0; j < BENCH_SCOPE_SIZE; j++ )
+		{
+			Names.push_back( SS::CompoundString( 1, TXT("v") + boost::lexical_cast<SS::String>( j ) ) );
+			Symbols.push_back( SS::CompoundSymbol() );
+			SS::SymbolTable::Instance().Intern( Names.back(), Symbols.back() );
+		}
+
+		B.Run( "scope.byname", "ns/lookup", boost::bind( LookupByName, pScope, &Names ) );
+		B.Run( "scope.bysymbol", "ns/lookup", boost::bind( LookupBySymbol, pScope, &Symbols ) );
+
+
+		//Fractions, so it's MPFR doing the work and not the inline integers.
+		SS::VariablePtr pX = MakeNumber( TXT("1.000001") );
+		SS::VariablePtr pY = MakeNumber( TXT("3.14159265358979") );
+
+		B.Run( "num.add", "ns/op", boost::bind( Add, pX, pY ) );
+		B.Run( "num.multiply", "ns/op", boost::bind( Multiply, pX, pY ) );
+		B.Run( "num.divide", "ns/op", boost::bind( Divide, pX, pY ) );
+		B.Run( "num.power", "ns/op", boost::bind( Power, pY, pX ) );
+	}
+	catch( SS::ParserAnomaly E )
+	{
+		std::cerr << "Benchmark failed: " << SS::NarrowizeString( E.ErrorDesc )
+				  << " (" << SS::NarrowizeString( E.ScriptFile ) << ":" << E.ScriptLine << ")\n";
+		return 2;
+	}
+
+
+	/*
+		Report, and compare.
+	*/
+	Baseline Base;
+	bool HaveBaseline = false;
+	if( !BaselineFile.empty() )
+	{
+		HaveBaseline = Benchmark::ReadBaseline( BaselineFile, Base );
+		if( !HaveBaseline && SaveFile.empty() ) SaveFile = BaselineFile;
+	}
+
+	unsigned int Regressions = B.Report( std::cout, HaveBaseline ? &Base : 0, Tolerance );
+
+	if( !SaveFile.empty() )
+	{
+		if( B.WriteBaseline( SaveFile ) ) std::cout << "\nSaved the baseline to " << SaveFile << ".\n";
+		else std::cerr << "\nCouldn't write " << SaveFile << ".\n";
+	}
+
+	if( Regressions )
+	{
+		std::cout << "\n" << Regressions << " benchmark(s) more than " << Tolerance
+				  << "% slower than the baseline.\n";
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,84 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.  Full license information is included in the file in the top directory named "license".
+
+NOTES: Writes a made-up corpus of conversations, for sswalk to walk through.
+*/
+
+
+#include <iostream>
+#include <string>
+
+#include "GetPot.hpp"
+
+#include "CorpusGenerator.hpp"
+
+#include <Defines.hpp>
+
+#if defined(PLAT_WIN32)
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
+
+//Makes the directory, if it isn't there already.
+static void MakeDirectory( const std::string& Dir )
+{
+#if defined(PLAT_WIN32)
+	_mkdir( Dir.c_str() );
+#else
+	mkdir( Dir.c_str(), 0755 );
+#endif
+}
+
+
+
+int main( int argc, char* argv[] )
+{
+	GetPot cl( argc, argv );
+	CorpusSettings S;
+
+	if( cl.search( 2, "--help", "-h" ) )
+	{
+		std::cout << "Usage: ssgen [OPTIONS]\n";
+		std::cout << "Options are:\n";
+		std::cout << " --out DIR               Where to write the corpus.  (Default: corpus)\n";
+		std::cout << " --files N               Files, besides main.ssconv.  (Default: " << S.Files << ")\n";
+		std::cout << " --blocks N              Blocks in each file.  (Default: " << S.Blocks << ")\n";
+		std::cout << " --branching N           Choices in each block's 'next'.  (Default: " << S.Branching << ")\n";
+		std::cout << " --complexity N          Operators in each block's expression.  (Default: " << S.Complexity << ")\n";
+		std::cout << " --string-size N         Characters in each line of dialogue.  (Default: " << S.StringSize << ")\n";
+		std::cout << " --use-depth N           Files in each chain of 'use's.  (Default: " << S.UseDepth << ")\n";
+		std::cout << " --seed N                Same seed, same corpus.  (Default: " << S.Seed << ")\n";
+		return 0;
+	}
+
+	std::string Dir = "corpus";
+	if( cl.search( "--out" ) ) Dir = cl.next( Dir.c_str() );
+
+	if( cl.search( "--files" ) ) S.Files = cl.next( (int)S.Files );
+	if( cl.search( "--blocks" ) ) S.Blocks = cl.next( (int)S.Blocks );
+	if( cl.search( "--branching" ) ) S.Branching = cl.next( (int)S.Branching );
+	if( cl.search( "--complexity" ) ) S.Complexity = cl.next( (int)S.Complexity );
+	if( cl.search( "--string-size" ) ) S.StringSize = cl.next( (int)S.StringSize );
+	if( cl.search( "--use-depth" ) ) S.UseDepth = cl.next( (int)S.UseDepth );
+	if( cl.search( "--seed" ) ) S.Seed = cl.next( (int)S.Seed );
+
+
+	MakeDirectory( Dir );
+
+	CorpusGenerator G( S );
+	if( !G.Write( Dir ) )
+	{
+		std::cerr << "Couldn't write the corpus to " << Dir << ".\n";
+		return 1;
+	}
+
+	std::cout << "Wrote " << S.Files + 1 << " files, " << G.GetBlockCount() << " blocks, "
+			  << G.GetByteCount() << " bytes to " << Dir << ".\n";
+
+	return 0;
+}
@@ -0,0 +1,145 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.  Full license information is included in the file in the top directory named "license".
+
+NOTES: Loads a conversation and takes random walks through it, timing both.
+	   Meant for corpora written by ssgen, but any conversation will do.
+*/
+
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+
+#include "GetPot.hpp"
+
+#include "RandomWalkInterface.hpp"
+
+#include <Block.hpp>
+#include <Defines.hpp>
+#include <HelperFuncs.hpp>
+#include <Interpreter.hpp>
+#include <ParserAnomaly.hpp>
+
+#if defined(PLAT_WIN32)
+#include <direct.h>
+#else
+#include <unistd.h>
+#endif
+
+
+//'use' looks for files from the working directory, so we go to where
+//the conversation is.  Returns the file's name without the directory.
+static std::string GoToDirectory( const std::string& FileName )
+{
+	std::string::size_type Slash = FileName.find_last_of( "/\\" );
+	if( Slash == std::string::npos ) return FileName;
+
+	std::string Dir = FileName.substr( 0, Slash );
+	if( Dir.empty() ) Dir = "/";
+
+#if defined(PLAT_WIN32)
+	_chdir( Dir.c_str() );
+#else
+	if( chdir( Dir.c_str() ) != 0 ) std::cerr << "Couldn't go to " << Dir << ".\n";
+#endif
+
+	return FileName.substr( Slash + 1 );
+}
+
+
+
+int main( int argc, char* argv[] )
+{
+	GetPot cl( argc, argv );
+
+	if( argc < 2 || cl.search( 2, "--help", "-h" ) )
+	{
+		std::cout << "Usage: sswalk FILE [OPTIONS]\n";
+		std::cout << "Options are:\n";
+		std::cout << " --walks N               Walks to take.  (Default: 100)\n";
+		std::cout << " --steps N               Most lines in a walk.  (Default: 200)\n";
+		std::cout << " --seed N                Same seed, same walks.  (Default: 1)\n";
+		std::cout << " --trace FILE            Saves a timeline to FILE, for chrome://tracing or Perfetto.\n";
+		return 0;
+	}
+
+	int Walks = 100;
+	if( cl.search( "--walks" ) ) Walks = cl.next( Walks );
+
+	int Steps = 200;
+	if( cl.search( "--steps" ) ) Steps = cl.next( Steps );
+
+	int Seed = 1;
+	if( cl.search( "--seed" ) ) Seed = cl.next( Seed );
+
+	std::string TraceFile;
+	if( cl.search( "--trace" ) ) TraceFile = cl.next( "" );
+
+	std::string FileName = argv[1];
+
+	//Opened now, before we go to the conversation's directory.
+	std::ofstream Trace;
+	if( !TraceFile.empty() )
+	{
+		Trace.open( TraceFile.c_str() );
+		if( !Trace ){
+			std::cerr << "Couldn't write " << TraceFile << ".\n";
+			return 1;
+		}
+	}
+
+
+	SS::Interpreter I;
+	RandomWalkInterface W( I, (unsigned long)Seed );
+	if( !TraceFile.empty() ) I.SetTracing( true );
+
+	int Result = 0;
+	try{
+		SS::String File = SS::NormalizeString( GoToDirectory( FileName ) );
+
+		boost::uint64_t Start = SS::GetMicroseconds();
+		I.OpenFile( File );
+		boost::uint64_t LoadTime = SS::GetMicroseconds() - Start;
+
+		Start = SS::GetMicroseconds();
+
+		int i, j;
+		for( i = 0; i < Walks; i++ )
+		{
+			I.Start( I.GetFirstBlock() );
+			for( j = 0; j < Steps; j++ )
+			{
+				SS::StepState State = I.Step();
+
+				if( State == SS::STEP_FINISHED ) break;
+				if( State == SS::STEP_CHOICE ){
+					I.ResumeWithChoice( W.PresentChoice( I.GetPendingChoices() ) );
+				}
+			}
+		}
+
+		boost::uint64_t WalkTime = SS::GetMicroseconds() - Start;
+
+
+		std::cout << std::fixed << std::setprecision( 1 );
+		std::cout << "Loaded " << FileName << " in " << (double)LoadTime / 1000 << " ms.\n";
+		std::cout << Walks << " walks: " << W.GetLines() << " lines, " << W.GetChoices() << " choices, "
+				  << W.GetBlocksSeen() << " different blocks, in " << (double)WalkTime / 1000 << " ms";
+		if( W.GetLines() ) std::cout << " (" << (double)WalkTime / W.GetLines() << " us/line)";
+		std::cout << ".\n";
+	}
+	catch( SS::ParserAnomaly E )
+	{
+		std::cerr << "Walk failed: " << SS::NarrowizeString( E.ErrorDesc )
+				  << " (" << SS::NarrowizeString( E.ScriptFile ) << ":" << E.ScriptLine << ")\n";
+		Result = 2;
+	}
+
+	//Even if it failed; that's when it's most interesting.
+	if( Trace.is_open() ) I.GetTracer().Write( Trace );
+
+	return Result;
+}
@@ -8,6 +8,7 @@ NOTES: This little program is to provide a console based interface for the S^2 i
 
 
 #include <iostream>
+#include <fstream>
 #include <ctime>
 #include <vector>
 
@@ -15,7 +16,18 @@ NOTES: This little program is to provide a console based interface for the S^2 i
 
 #include "Console.hpp"
 #include "ConsoleInterface.hpp"
+#include "NumPool.hpp"
 
+#include <boost/lexical_cast.hpp>
+
+
+//Right-aligns a number in a column of the given width.
+static SS::String PadNumber( boost::uint64_t N, size_t Width )
+{
+	SS::String S = boost::lexical_cast<SS::String>( N );
+	if( S.length() < Width ) S.insert( 0, Width - S.length(), ' ' );
+	return S;
+}
 
 
 
@@ -55,6 +67,17 @@ int main( int argc, char* argv[] )
 		CON << TXT("                         Currently a little buggy, but works well for files.\n");
 		CON << TXT(" -n, --no-color          Don't print any color at all.\n");
 		CON << TXT(" -v, --verbose       	 Adds some extra info, mainly with error output.\n");
+		CON << TXT(" --bytecode              Compile blocks and run them on the byte code VM.\n");
+		CON << TXT(" --cache                 Save tokenized files to .ssc files and reuse them.\n");
+		CON << TXT(" --num-stats             Prints how many numbers were allocated and reused.\n");
+		CON << TXT(" --memoize               Remember what pure blocks return, instead of rerunning them.\n");
+		CON << TXT(" --memo-stats            Prints how often remembered results were used.\n");
+		CON << TXT(" --profile               Prints how much time each block took, when done.\n");
+		CON << TXT(" --line-profile          Prints each file, with how often each line ran, when done.\n");
+		CON << TXT(" --trace FILE            Saves a timeline to FILE, for chrome://tracing or Perfetto.\n");
+		CON << TXT(" --max-statements N      Stop a line that runs more than N statements.\n");
+		CON << TXT(" --max-time MS           Stop a line that runs longer than MS milliseconds.\n");
+		CON << TXT(" --max-stack-segments N  Let deep recursion use up to N 1M stack segments (0 for no limit).\n");
 		CON << TXT(" --version               Prints the version number, contact info, etc.\n");
 		
 		delete pCON;
@@ -98,6 +121,47 @@ int main( int argc, char* argv[] )
 		CON.UseColor( false );		
 	}
 	
+	//Test for the byte code VM
+	bool UseByteCode = false;
+	if( cl.search( "--bytecode" ) ) UseByteCode = true;
+	
+	//Test for the token cache
+	bool UseTokenCache = false;
+	if( cl.search( "--cache" ) ) UseTokenCache = true;
+	
+	//Test for number pool stats
+	bool NumStats = false;
+	if( cl.search( "--num-stats" ) ) NumStats = true;
+	
+	//Test for memoization
+	bool Memoize = false;
+	if( cl.search( "--memoize" ) ) Memoize = true;
+	
+	bool MemoStats = false;
+	if( cl.search( "--memo-stats" ) ) MemoStats = true;
+
+	//Test for profiling
+	bool Profile = false;
+	if( cl.search( "--profile" ) ) Profile = true;
+	
+	bool LineProfile = false;
+	if( cl.search( "--line-profile" ) ) LineProfile = true;
+	
+	//Test for tracing
+	std::string TraceFile;
+	if( cl.search( "--trace" ) ) TraceFile = cl.next( "" );
+	
+	//Test for statement and time budgets
+	int MaxStatements = 0;
+	if( cl.search( "--max-statements" ) ) MaxStatements = cl.next( 0 );
+	
+	int MaxTime = 0;
+	if( cl.search( "--max-time" ) ) MaxTime = cl.next( 0 );
+	
+	//Test for a stack segment limit
+	int MaxStackSegments = -1;
+	if( cl.search( "--max-stack-segments" ) ) MaxStackSegments = cl.next( -1 );
+	
 	//Test for block name
 	SS::String BlockName;
 	if( cl.search( 2, "--block", "-b" ) )
@@ -124,9 +188,83 @@ int main( int argc, char* argv[] )
 	
 
 	if( Verbose ) Test.GetInterpreter().SetVerbose( true );
+	if( UseByteCode ) Test.GetInterpreter().SetUseByteCode( true );
+	if( UseTokenCache ) Test.GetInterpreter().SetUseTokenCache( true );
+	if( Memoize ) Test.GetInterpreter().SetMemoizeBlocks( true );
+	if( Profile ) Test.GetInterpreter().SetProfiling( true );
+	if( LineProfile ) Test.GetInterpreter().SetLineProfiling( true );
+	if( !TraceFile.empty() ) Test.GetInterpreter().SetTracing( true );
+	if( MaxStatements > 0 ) Test.GetInterpreter().SetStatementBudget( MaxStatements );
+	if( MaxTime > 0 ) Test.GetInterpreter().SetTimeBudget( MaxTime );
+	if( MaxStackSegments >= 0 ) Test.GetInterpreter().SetMaxStackSegments( MaxStackSegments );
 		
 	Test.StartConversation( FileName, BlockName );
 
+	if( NumStats )
+	{
+		//The interpreter's own pool; its context isn't current out here.
+		const SS::NumPool& Pool = Test.GetInterpreter().GetContext().GetNumPool();
+		
+		CON << TXT("\nmpfr_t: ") << Pool.GetMpfrCounters().Inits << TXT(" initialized, ")
+		    << Pool.GetMpfrCounters().Reuses << TXT(" reused, ")
+		    << Pool.GetMpfrCounters().Clears << TXT(" freed\n");
+		CON << TXT("mpz_t:  ") << Pool.GetMpzCounters().Inits << TXT(" initialized, ")
+		    << Pool.GetMpzCounters().Reuses << TXT(" reused, ")
+		    << Pool.GetMpzCounters().Clears << TXT(" freed\n");
+	}
+	
+	if( MemoStats )
+	{
+		const SS::MemoStats& Stats = Test.GetInterpreter().GetMemoStats();
+		
+		CON << TXT("\nmemo:   ") << Stats.Hits << TXT(" hits, ")
+		    << Stats.Misses << TXT(" misses, ")
+		    << Stats.Entries << TXT(" kept, ")
+		    << Stats.Flushes << TXT(" flushes\n");
+	}
+	
+	if( Profile )
+	{
+		std::vector<SS::BlockProfile> Report;
+		Test.GetInterpreter().GetProfiler().GetReport( Report );
+		
+		//Times are in microseconds, objects are ScopeObjects created.
+		CON << TXT("\n     calls    incl(us)    excl(us)     objects  block\n");
+		size_t i;
+		for( i = 0; i < Report.size(); i++ )
+		{
+			CON << PadNumber( Report[i].Calls, 10 )
+			    << PadNumber( Report[i].InclusiveTime, 12 )
+			    << PadNumber( Report[i].ExclusiveTime, 12 )
+			    << PadNumber( Report[i].Allocations, 12 )
+			    << TXT("  ") << Report[i].Name << TXT("\n");
+		}
+	}
+	
+	if( LineProfile )
+	{
+		const SS::LineProfiler& Lines = Test.GetInterpreter().GetLineProfiler();
+		std::vector<SS::String> Files;
+		Lines.GetFiles( Files );
+		
+		size_t i;
+		for( i = 0; i < Files.size(); i++ )
+		{
+			SS::String Listing;
+			Lines.GetListing( Files[i], Listing );
+			CON << TXT("\n") << Files[i] << TXT(":\n") << Listing;
+		}
+	}
+	
+	if( !TraceFile.empty() )
+	{
+		std::ofstream Trace( TraceFile.c_str() );
+		Test.GetInterpreter().GetTracer().Write( Trace );
+		
+		if( !Trace ){
+			CON << TXT("\nCouldn't write the trace to ") << SS::NormalizeString( TraceFile ) << TXT(".\n");
+		}
+	}
 	
 	CON.SetTextFGColor( ColorCyan );
 	
@@ -89,6 +89,10 @@ public:
 
 	/// Meaning is dependent on the user.
 	unsigned int ErrorCode;
+
+private:
+	/// What what() returns.  (Each exception has its own, so threads don't share one.)
+	mutable std::string mNarrowWhat;
 };
 
 
@@ -18,6 +18,7 @@ directory named "license".
 #include "Interpreter.hpp"
 //#include "ScriptFile.hpp"
 #include "Bookmark.hpp"
+#include "ByteCode.hpp"
 #include "Unicode.hpp"
 
 #include "CreationFuncs.hpp"
@@ -96,6 +97,12 @@ public:
 	*/
 	unsigned int GetListIndex() const;
 	
+	/// Returns the block's compiled body, or an empty pointer if it hasn't been compiled.
+	ByteCodePtr GetByteCode() const;
+	
+	/// Sets the block's compiled body.
+	void SetByteCode( ByteCodePtr pCode );
+	
 
 	//Add/Set SpeechFileName //I will do this later when I actually have to worry about sound.
 	
@@ -115,6 +122,9 @@ private:
 	/// The block order.  (See GetListIndex.)
 	BlockIndex mListIndex;
 	
+	/// The compiled body.  (See Interpreter::GetByteCode.)
+	ByteCodePtr mpByteCode;
+	
 	Interpreter* mpI;
 
 	//SS::String mSpeechFileName;
@@ -0,0 +1,113 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+/**
+	\file ByteCode.hpp
+	\brief Declarations for ByteCode.
+*/
+
+#if !defined(SS_ByteCode)
+#define SS_ByteCode
+
+#include "Types.hpp"
+#include "Word.hpp"
+#include "ReaderSource.hpp"
+
+#include <vector>
+
+namespace SS{
+
+class Expression;
+
+///The instructions understood by the interpreter's block VM.
+enum OpCode
+{
+	OP_EVAL,         ///< Evaluate an expression statement.
+	OP_JUMP,         ///< Jump to Arg.
+	OP_JUMPIFFALSE,  ///< Evaluate the condition, jump to Arg if it is false.
+	OP_JUMPIFTRUE,   ///< Evaluate the condition, jump to Arg if it is true.
+	OP_SKIPSTATIC,   ///< Jump to Arg if 'static' statements are being skipped.
+	OP_DECLAREBLOCK, ///< Register the block in ByteCode::Declarations[Arg].
+	OP_RETURN        ///< Leave the block.
+};
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief A single VM instruction.
+*/
+struct Instruction
+{
+	///Constructor
+	Instruction( OpCode Op, ReaderPos Pos,
+				 boost::shared_ptr<Expression> pExpression = boost::shared_ptr<Expression>(),
+				 size_t Arg = 0 )
+		: Op( Op ), Arg( Arg ), Pos( Pos ), pExpression( pExpression ) {}
+
+	///What to do.
+	OpCode Op;
+	///Jump target (as an instruction index), or a declaration index.
+	size_t Arg;
+	///Where the token-walking parser would be in the source at this point.
+	ReaderPos Pos;
+	///The expression to evaluate, if any.
+	boost::shared_ptr<Expression> pExpression;
+};
+
+struct ByteCode;
+
+///Shared pointer to compiled ByteCode.
+typedef boost::shared_ptr<const ByteCode> ByteCodePtr;
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief A block declared inside another block.
+*/
+struct BlockDeclaration
+{
+	///Constructor
+	BlockDeclaration() : HasDocString( false ) {}
+
+	///The block's identifier.
+	CompoundString Id;
+	///True if the block had a doc string.
+	bool HasDocString;
+	///The block's doc string.
+	String DocString;
+	///The block's own compiled body.
+	ByteCodePtr pCode;
+};
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief A compiled block body.
+
+	Blocks are compiled the first time they are run (if LangOpts::UseByteCode
+	is set) so that the interpreter doesn't have to walk through the
+	words again every time.  Control flow is turned into jumps.
+
+	\sa Interpreter
+*/
+struct ByteCode
+{
+	///Constructor
+	ByteCode() : UseTokenWalker( false ) {}
+
+	///The instructions, always ending with OP_RETURN.
+	std::vector<Instruction> Instructions;
+	///Blocks declared in the body.
+	std::vector<BlockDeclaration> Declarations;
+	///True if the body couldn't be compiled and has to be run by Interpreter::Parse.
+	bool UseTokenWalker;
+};
+
+
+} //namespace SS
+#endif
@@ -59,7 +59,7 @@ class Interpreter;
 	\param x The name of your class
 */
 #define SS_FRIENDIFY_GENERIC_CREATOR(x) \
-friend boost::shared_ptr<x> CreateGeneric<x> ( SS_DECLARE_BASE_ARGS )
+friend boost::intrusive_ptr<x> CreateGeneric<x> ( SS_DECLARE_BASE_ARGS )
 
 /**
 	\brief Macro of befriending the CreateBasic function.
@@ -69,7 +69,7 @@ friend boost::shared_ptr<x> CreateGeneric<x> ( SS_DECLARE_BASE_ARGS )
 	\param x The name of your class
 */
 #define SS_FRIENDIFY_BASIC_CREATOR(x) \
-friend boost::shared_ptr<x> CreateBasic<x> ()
+friend boost::intrusive_ptr<x> CreateBasic<x> ()
 
 /**
 	\brief Macro of befriending the CreateVariable function.
@@ -79,10 +79,10 @@ friend boost::shared_ptr<x> CreateBasic<x> ()
 	\param x The name of your class
 */
 #define SS_FRIENDIFY_VARIABLE_CREATOR(x) \
-friend boost::shared_ptr<x> CreateVariable<x> ( SS_DECLARE_BASE_ARGS, const Variable& );\
-friend boost::shared_ptr<x> CreateVariable<x> ( SS_DECLARE_BASE_ARGS, const NumType& );\
-friend boost::shared_ptr<x> CreateVariable<x> ( SS_DECLARE_BASE_ARGS, const StringType& );\
-friend boost::shared_ptr<x> CreateVariable<x> ( SS_DECLARE_BASE_ARGS, const BoolType& )
+friend boost::intrusive_ptr<x> CreateVariable<x> ( SS_DECLARE_BASE_ARGS, const Variable& );\
+friend boost::intrusive_ptr<x> CreateVariable<x> ( SS_DECLARE_BASE_ARGS, const NumType& );\
+friend boost::intrusive_ptr<x> CreateVariable<x> ( SS_DECLARE_BASE_ARGS, const StringType& );\
+friend boost::intrusive_ptr<x> CreateVariable<x> ( SS_DECLARE_BASE_ARGS, const BoolType& )
 
 /**
 	\brief Macro of befriending the CreateBlock function.
@@ -92,7 +92,7 @@ friend boost::shared_ptr<x> CreateVariable<x> ( SS_DECLARE_BASE_ARGS, const Bool
 	\param x The name of your class
 */
 #define SS_FRIENDIFY_BLOCK_CREATOR(x) \
-friend boost::shared_ptr<x> CreateBlock<x> ( SS_DECLARE_BASE_ARGS, Interpreter& I, \
+friend boost::intrusive_ptr<x> CreateBlock<x> ( SS_DECLARE_BASE_ARGS, Interpreter& I, \
 const Bookmark& Position, BlockIndex ListIndex )
 
 
@@ -105,7 +105,7 @@ const Bookmark& Position, BlockIndex ListIndex )
 	\sa CreationFuncs
 */
 template <typename T > extern
-boost::shared_ptr<T> CreateGeneric( Interpreter& I );
+boost::intrusive_ptr<T> CreateGeneric( Interpreter& I );
 
 
 /**
@@ -119,7 +119,7 @@ boost::shared_ptr<T> CreateGeneric( Interpreter& I );
 	\sa CreationFuncs
 */
 template <typename T > extern
-boost::shared_ptr<T> CreateGeneric( const SS::String& Name = SS::String(),
+boost::intrusive_ptr<T> CreateGeneric( const SS::String& Name = SS::String(),
                                     bool Const = false );
 /**
 	\brief Create new instances of ScopeObject derivatives.
@@ -128,7 +128,7 @@ boost::shared_ptr<T> CreateGeneric( const SS::String& Name = SS::String(),
 	
 	\sa CreationFuncs
 */
-template <typename T > extern boost::shared_ptr<T> CreateBasic( );
+template <typename T > extern boost::intrusive_ptr<T> CreateBasic( );
 
 
 /**
@@ -143,7 +143,7 @@ template <typename T > extern boost::shared_ptr<T> CreateBasic( );
 	\sa CreationFuncs
 */
 template <typename T > extern
-boost::shared_ptr<T> CreateVariable( const SS::String& Name,
+boost::intrusive_ptr<T> CreateVariable( const SS::String& Name,
                                      bool Const, const Variable& V );
 
 /**
@@ -158,7 +158,7 @@ boost::shared_ptr<T> CreateVariable( const SS::String& Name,
 	\sa CreationFuncs
 */
 template <typename T > extern
-boost::shared_ptr<T> CreateVariable( SS_DECLARE_BASE_ARGS, const NumType& N );
+boost::intrusive_ptr<T> CreateVariable( SS_DECLARE_BASE_ARGS, const NumType& N );
 
 /**
 	\brief Create new instances of ScopeObject derivatives.
@@ -172,7 +172,7 @@ boost::shared_ptr<T> CreateVariable( SS_DECLARE_BASE_ARGS, const NumType& N );
 	\sa CreationFuncs
 */
 template <typename T > extern
-boost::shared_ptr<T> CreateVariable( SS_DECLARE_BASE_ARGS, const StringType& S );
+boost::intrusive_ptr<T> CreateVariable( SS_DECLARE_BASE_ARGS, const StringType& S );
 
 /**
 	\brief Create new instances of ScopeObject derivatives.
@@ -186,7 +186,7 @@ boost::shared_ptr<T> CreateVariable( SS_DECLARE_BASE_ARGS, const StringType& S )
 	\sa CreationFuncs
 */
 template <typename T > extern
-boost::shared_ptr<T> CreateVariable( SS_DECLARE_BASE_ARGS, const BoolType& B );
+boost::intrusive_ptr<T> CreateVariable( SS_DECLARE_BASE_ARGS, const BoolType& B );
 
 
 /**
@@ -203,7 +203,7 @@ boost::shared_ptr<T> CreateVariable( SS_DECLARE_BASE_ARGS, const BoolType& B );
 	\sa CreationFuncs
 */
 template <typename T > extern
-boost::shared_ptr<T> CreateBlock( SS_DECLARE_BASE_ARGS, Interpreter& I, const Bookmark& Position, BlockIndex Index );
+boost::intrusive_ptr<T> CreateBlock( SS_DECLARE_BASE_ARGS, Interpreter& I, const Bookmark& Position, BlockIndex Index );
 
 }//end namespace SS
 #endif
@@ -57,20 +57,14 @@ class SS_API boost::detail::shared_count;
 class SS_API boost::detail::weak_count;
 
 
-EXPIMP_TEMPLATE template class SS_API boost::shared_ptr<ScopeObject>;
+EXPIMP_TEMPLATE template class SS_API boost::intrusive_ptr<ScopeObject>;
 //EXPIMP_TEMPLATE template class SS_API boost::shared_ptr<ScriptFile>;
-EXPIMP_TEMPLATE template class boost::shared_ptr<Scope>;
-EXPIMP_TEMPLATE template class boost::shared_ptr<Variable>;
-EXPIMP_TEMPLATE template class SS_API boost::shared_ptr<Block>;
+EXPIMP_TEMPLATE template class boost::intrusive_ptr<Scope>;
+EXPIMP_TEMPLATE template class boost::intrusive_ptr<Variable>;
+EXPIMP_TEMPLATE template class SS_API boost::intrusive_ptr<Block>;
 EXPIMP_TEMPLATE template class SS_API boost::shared_ptr<Interpreter>;
 
 
-EXPIMP_TEMPLATE template class SS_API boost::weak_ptr<ScopeObject>;
-EXPIMP_TEMPLATE template class boost::weak_ptr<Scope>;
-EXPIMP_TEMPLATE template class boost::weak_ptr<Variable>;
-EXPIMP_TEMPLATE template class boost::weak_ptr<Block>;
-
-
 //For Scope
 EXPIMP_TEMPLATE template class SS_API std::allocator<ScopeObjectPtr>;
 EXPIMP_TEMPLATE template class SS_API std::vector<ScopeObjectPtr>;
@@ -103,7 +97,7 @@ EXPIMP_TEMPLATE template class SS_API std::vector<unsigned long>;
 
 
 class SS_API boost::detail::shared_count;
-EXPIMP_TEMPLATE template class SS_API boost::shared_ptr<Scope>;
+EXPIMP_TEMPLATE template class SS_API boost::intrusive_ptr<Scope>;
 
 }
 
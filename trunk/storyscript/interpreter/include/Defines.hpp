@@ -31,6 +31,13 @@ namespace SS{
     #define PLAT_LINUX
 #endif
 
+//Gives every thread its own copy of a (plain old data) variable.
+#if defined(_MSC_VER)
+	#define SS_THREAD_LOCAL __declspec(thread)
+#else
+	#define SS_THREAD_LOCAL __thread
+#endif
+
 /*
 Determines what type of structure is used for scopes.
 The default is std::map, which is a standard and works just fine.
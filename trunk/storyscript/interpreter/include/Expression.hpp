@@ -24,13 +24,15 @@ namespace SS{
 	
 
 class Interpreter;
+class Immediate;
 
 //~~~~~~~CLASS~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 /**
 	\brief Wrapper class responsible for executing expressions.
 	
-	Expressions are held as a list of words.  When an expression is executed
-	(via Evaluate), it gets divided and conquered.
+	Expressions are held as a list of words.  The first time an expression is
+	executed (via Evaluate), it gets divided and conquered into a tree of
+	operator nodes.  From then on it is the tree that gets executed.
 	
 */
 class Expression
@@ -52,6 +54,57 @@ private:
 		size_t Lower, Upper;
 	};
 	
+	/**
+		\brief A node in the compiled operator tree.
+		
+		Each node knows what sort of operation it is, which word it came from,
+		and the bounds of its operands.  Operand nodes are compiled the first
+		time they are actually needed (so an untaken short-circuit never gets
+		compiled against identifiers that don't exist yet), and after that
+		they never change.
+	*/
+	struct Node
+	{
+		/// What a node does when it gets evaluated.
+		enum NodeType
+		{
+			NODE_IDENTIFIER, ///< A lone identifier.  The object comes from the object cache.
+			NODE_LITERAL,    ///< A lone literal.  A copy of the pre-parsed literal is returned.
+			NODE_EMPTYLIST,  ///< The empty list literal.
+			NODE_FUNCTION,   ///< An Operator or Block applied to the right operand.
+			NODE_UNARYOP,    ///< A hard-coded unary operator.
+			NODE_BINARYOP    ///< A hard-coded binary operator.
+		};
+		
+		Node( NodeType T, const Bounds& B )
+			: Type(T), Op(EXTRA_NULL), Index(B.Lower), Range(B),
+			  LiteralPrecision(0), LiteralBase(0) {}
+		
+		NodeType  Type;
+		ExtraDesc Op;    ///< The operator (for operator nodes).
+		size_t    Index; ///< Absolute index of the operator/identifier/literal word.
+		Bounds    Range; ///< The words the node was compiled from.
+		
+		Bounds Left;  ///< Bounds of the left operand.  (Empty if there is none.)
+		Bounds Right; ///< Bounds of the right operand.  (Empty if there is none.)
+		
+		mutable boost::shared_ptr<const Node> pLeft;  ///< Compiled left operand.
+		mutable boost::shared_ptr<const Node> pRight; ///< Compiled right operand.
+		
+		/**
+			\brief The pre-parsed literal, for literal nodes.
+			
+			This is never handed out directly; it only gets duplicated.
+		*/
+		mutable VariablePtr pLiteral;
+		
+		/// The precision and base the literal was parsed with.
+		mutable unsigned long LiteralPrecision, LiteralBase;
+	};
+	
+	/// Pointer to a Node.
+	typedef boost::shared_ptr<const Node> NodePtr;
+	
 	/// Default constructor (Don't use.)
 	Expression();
 	
@@ -77,6 +130,16 @@ public:
 	*/
 	void SetStatic( bool flag = true ) const;
 	
+	/**
+		\brief Sets where the expression starts in its script.
+		
+		This is only used by the LineProfiler.
+	*/
+	void SetLocation( const SS::String& FileName, unsigned long Line );
+	
+	///Returns the line the expression starts on.  (0 if it isn't known.)
+	unsigned long GetLine() const;
+	
 	/**
 		\brief Retrieves of specific word.
 		
@@ -121,57 +184,39 @@ public:
 	VariableBasePtr Evaluate() const;
 
 private:
-	/**
-		\brief Copy constructor
-		
-		\param E The other expression.
-		\param B The sub-expression of to 'copy' over.
-	*/
-	Expression( const Expression& E, const Bounds& B );
+	/// Evaluate, without anything counting it.
+	VariableBasePtr EvaluateUncounted() const;
 	
+
 	/// Precedence level for operators.
 	typedef unsigned int               OperatorPrecedence;
 	
 	/// The actual list of Words.
 	typedef std::vector<Word> WordList;
 	
-	/// Object Cache: Objects are cached to reduce redundant lookups.
-	typedef std::map<size_t, ScopeObjectPtr> ObjectCache;
-	
-	/// Pointer to an Object Cache
-	typedef boost::shared_ptr<ObjectCache> ObjectCachePtr;
-	
-	/// Comparison function used by PrecedenceList
-	struct BoundsCompare
-	{
-		//How this is done is more or less arbitrary
-		bool operator()( const Bounds& B1, const Bounds& B2 ) const
-		{
-			if( B1.Lower < B2.Lower ) return true;
-			else if( B1.Lower == B2.Lower )
-			{
-				if( B1.Upper < B2.Upper ) return true;
-				else return false;		
-			}
-			else return false;			
-		}		
-	};
-	
-	
 	/**
-		\brief Cache of precedence indexes. 
+		\brief Object Cache: Objects are cached to reduce redundant lookups.
 		
-		The low precedence operator for each sub-expression is cached so
-		when the expression is evaluated again, it doesn't have to go through
-		of calculating the low precedence expression.
+		Indexed by absolute word index.  Words that aren't identifiers are null.
 	*/
-	typedef std::map< Bounds, unsigned long, BoundsCompare > PrecedenceList;
+	typedef std::vector<ScopeObjectPtr> ObjectCache;
 	
-	/// Pointer to PrecedenceList
-	typedef boost::shared_ptr<PrecedenceList> PrecedenceListPtr;
+	/**
+		\brief The compiled operator tree.
+		
+		Built the first time the expression is evaluated, and thrown out
+		whenever the word list changes.
+	*/
+	mutable NodePtr mpRoot;
 	
-	/// The expression's precedence cache.
-	mutable PrecedenceListPtr mpPrecedenceList;
+	/**
+		\brief The last lookup of each identifier.
+		
+		Indexed like ObjectCache, and thrown out along with the root.
+		
+		\sa Interpreter::GetScopeObject_NoThrow
+	*/
+	mutable std::vector<ScopeResolution> mResolutions;
 	
 	
 	/// Has the same effect as operator[].
@@ -179,20 +224,64 @@ private:
 	/// Has the same effect as operator[].
 	const Word& GetWord( unsigned long ) const;
 	
+	/**
+		\brief Compiles a (sub-)expression into a node.
+		
+		Strips outlying parenthesis, pre-parses lone literals, and finds
+		the low precedence operator.  The operands are left for later.
+		
+		\param B The bounds of the sub-expression.
+		
+		\param O The object cache for the current evaluation.
+		
+		\return The new node.
+	*/
+	NodePtr CompileNode( Bounds B, const ObjectCache& O ) const;
+	
 	/**
 		\brief The 'real' evaluate function.
 		
-		This a recursive function that gets called by the public
-		Evaluate function.
+		This a recursive function that walks the operator tree.
 		
-		\param TopLevel This is true if it is being called by Evaluate, and
-		false if it is being called recursionally.
+		\param N The node to evaluate.
 		
-		\param O A pointer to the object cache for the expression.
+		\param O The object cache for the current evaluation.
 		
-		\return The result of the expression.
+		\param Out Where the result of the node is put.
+	*/
+	void EvaluateNode( const Node& N, ObjectCache& O, Immediate& Out ) const;
+	
+	/**
+		\brief Evaluates one of a node's operands, compiling it first if need be.
+		
+		\param N The parent node.
+		
+		\param LeftSide True for the left operand, false for the right.
+		
+		\param O The object cache for the current evaluation.
+		
+		\param Out Where the result of the operand is put.
+	*/
+	void EvaluateOperand( const Node& N, bool LeftSide, ObjectCache& O, Immediate& Out ) const;
+	
+	///An EvaluateNode call, gathered up so it can be handed to another stack segment.
+	struct NodeCall
+	{
+		const Expression* pThis;
+		const Node* pNode;
+		ObjectCache* pObjects;
+		Immediate* pOut;
+	};
+	
+	///Runs an EvaluateNode call.  (pCall is a NodeCall.)
+	static void EvaluateNodeOnSegment( void* pCall );
+	
+	/**
+		\brief Makes the pre-parsed copy of a literal for a literal node.
+		
+		\param N The literal node.
 	*/
-	VariableBasePtr InternalEvaluate( bool TopLevel = true, ObjectCachePtr O = ObjectCachePtr() ) const;
+	void ParseLiteral( const Node& N ) const;
 	
 	/**
 		\brief Maps unary operator words to their actual function calls.
@@ -201,9 +290,11 @@ private:
 		
 		\param Right The r-value of the unary operator.
 		
+		\param B The bounds of the sub-expression, for error reporting.
+		
 		\return The result of the operation.
 	*/
-	VariableBasePtr EvaluateUnaryOp ( ExtraDesc Op, VariableBasePtr Right ) const;
+	VariableBasePtr EvaluateUnaryOp ( ExtraDesc Op, VariableBasePtr Right, const Bounds& B ) const;
 	
 	/**
 		\brief Maps binary operator words to their actual function calls.
@@ -217,15 +308,34 @@ private:
 		\return The result of the operation.
 	*/
 	VariableBasePtr EvaluateBinaryOp( ExtraDesc Op, VariableBasePtr Left, VariableBasePtr Right ) const;
+	
+	/**
+		\brief Performs a binary operator on Immediates.
+		
+		Operators that can be done on the values alone are, and so are
+		assignments to plain Variables.  Everything else is made into
+		objects and handed to the function above.
+		
+		\param Op The binary operator.
+		
+		\param Left The l-value of the binary operator.
+		
+		\param Right The r-value of the binary operator.
+		
+		\param Out Where the result is put.
+	*/
+	void EvaluateBinaryOp( ExtraDesc Op, Immediate& Left, Immediate& Right, Immediate& Out ) const;
 
 	/**
 		\brief Finds the operator with the lowest precedence.
 		
+		\param B The bounds of the sub-expression to look in.
+		
 		\param O The object cache for the expression.
 		
-		\return The index to the low precedence operator.
+		\return The absolute index to the low precedence operator.
 	*/
-	size_t CalculateLowPrecedenceOperator( ObjectCachePtr O ) const;
+	size_t CalculateLowPrecedenceOperator( const Bounds& B, const ObjectCache& O ) const;
 	
 	/**
 		\brief Retrieves the precedence level for a given word.
@@ -243,7 +353,7 @@ private:
 		
 		\param O The object cache to use.
 	*/		
-	void CacheIdentifierObjects( ObjectCachePtr O ) const;
+	void CacheIdentifierObjects( ObjectCache& O ) const;
 	
 	/**
 		\brief Checks the expression for any obvious errors.
@@ -255,15 +365,21 @@ private:
 	/// Flag specifying whether the syntax has already been checked or not.
 	mutable bool mSyntaxChecked;
 	
-	/// Removes any useless outlying parentheses from the expression.
-	bool StripOutlyingParenthesis() const;
+	/// Removes any useless outlying parentheses from the given bounds.
+	bool StripOutlyingParenthesis( Bounds& B ) const;
 	
 	/// Throws a specially formatted expression anomaly.
 	void ThrowExpressionAnomaly( const SS::String& Desc, AnomalyCode Code ) const;
 	
+	/// Throws a specially formatted expression anomaly about a sub-expression.
+	void ThrowExpressionAnomaly( const SS::String& Desc, AnomalyCode Code, const Bounds& B ) const;
+	
 	/// Converts the expression to a (hopefully) human readable form.
 	SS::String DumpToString() const;
 	
+	/// Converts a sub-expression to a (hopefully) human readable form.
+	SS::String DumpToString( const Bounds& B ) const;
+	
 	/**
 		\brief Convert a local index to a absolute index.
 		
@@ -307,6 +423,14 @@ private:
 		\sa GetStatic SetStatic
 	*/
 	mutable bool mStatic;
+	
+	/**
+		\brief Where the expression starts.
+		
+		\sa SetLocation
+	*/
+	SS::String mFileName;
+	unsigned long mLine;
 };
 
 }
@@ -11,6 +11,8 @@ NOTES: Contains misc. functions that I haven't found a better place for yet.
 #if !defined(SS_HelperFuncs)
 #define SS_HelperFuncs
 
+#include <boost/cstdint.hpp>
+
 //
 
 namespace SS{
@@ -52,6 +54,9 @@ namespace SS{
 
 	//bool IsSingleListStatement( const Expression& );
 	
+	//A steady clock in microseconds.  Only good for measuring how long something took.
+	boost::uint64_t SS_API GetMicroseconds();
+
 	//Totally out there...
 	unsigned int RoundAndCast( double );
 	
@@ -0,0 +1,219 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+/**
+	\file Immediate.hpp
+	\brief Declarations for Immediate and ImmediateStack.
+*/
+
+#if !defined(SS_Immediate)
+#define SS_Immediate
+
+#include "Variable.hpp"
+#include "Word.hpp"
+#include "DLLExport.hpp"
+
+#include <deque>
+
+namespace SS{
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief A value produced part way through evaluating an expression.
+
+	Creating a whole Variable (scope and all) for every intermediate
+	result is expensive, so the hard-coded operators work on these
+	instead.  An Immediate either holds a value itself, in the same three
+	parts a Variable does, or it refers to an object.  Plain Variables
+	are read straight out of the object; anything else has to go through
+	its own operators.
+
+	An Immediate only becomes a real Variable (see GetObject) when
+	something needs an object: a function argument, a list, the final
+	result, and so on.
+
+	The conversions and operators here have to behave exactly like
+	Variable's do, so keep them in step.
+
+	\sa ImmediateStack Expression
+*/
+class SS_API Immediate
+{
+public:
+	///Constructor
+	Immediate();
+
+	///Drops any object and value.
+	void Clear();
+
+	///Refer to an object.
+	void SetObject( const VariableBasePtr& pObject );
+
+	/**
+		\brief Copy the value of a Variable.
+
+		\param V The Variable to copy.
+		\param Const True if the Variable made by GetObject should be constant.
+	*/
+	void SetValue( const Variable& V, bool Const = false );
+
+	///Hold a boolean value.
+	void SetBool( BoolType B );
+
+	/**
+		\brief Returns true if this holds a value, or refers to a plain Variable.
+
+		Only these can be used by the operator functions below.
+	*/
+	bool IsValue() const { return !mpObject || mpVariable; }
+
+	///Returns true if this holds its own value rather than referring to an object.
+	bool HoldsValue() const { return !mpObject; }
+
+	///Returns the object, if it is a plain Variable.
+	Variable* GetVariable() const { return mpVariable; }
+
+	/**
+		\brief Returns the object, making a Variable for the value if need be.
+
+		Once a Variable has been made, this refers to it from then on.
+	*/
+	VariableBasePtr GetObject();
+
+	///Returns the preferred type. (IsValue must be true.)
+	VarType GetVariableType() const;
+	///Returns the BoolType component. (IsValue must be true.)
+	BoolType GetBoolData();
+	///Returns the StringType component. (IsValue must be true.)
+	const StringType& GetStringData();
+
+	/**
+		\brief Returns the NumType component, as an operator sees it.
+
+		Variable's operators work on the copies VariableBase::GetNumData
+		returns, which are at MPFR's default precision, so this rounds to
+		that as well.
+	*/
+	const NumType& GetOperandNum();
+
+	/**
+		\brief Performs a hard-coded binary operator on two values.
+
+		The result is put in this Immediate, which shouldn't be either
+		of the operands.
+
+		\param Op The operator.
+		\param L The left operand.
+		\param R The right operand.
+		\return False if the operator isn't one that can be done here.
+	*/
+	bool BinaryOp( ExtraDesc Op, Immediate& L, Immediate& R );
+
+	/**
+		\brief Performs a hard-coded unary operator on a value.
+
+		\param Op The operator.
+		\param R The operand.
+		\return False if the operator isn't one that can be done here.
+	*/
+	bool UnaryOp( ExtraDesc Op, Immediate& R );
+
+	/**
+		\brief Stores the value in a plain Variable, like Variable::operator= would.
+
+		\param V The Variable to assign to.
+	*/
+	void AssignTo( Variable& V );
+
+private:
+	///Starts a new numeric result at the default precision and returns it.
+	NumType& SetNum();
+	///Starts a new string result and returns it.
+	StringType& SetString();
+
+	///Returns the NumType component, converting if need be.
+	const NumType& GetNumData();
+
+	///The object being referred to, if any.
+	VariableBasePtr mpObject;
+	///The object, if it is a plain Variable.
+	Variable* mpVariable;
+
+	///True if the Variable made by GetObject should be constant.
+	bool mConst;
+
+	///The current preferred type.
+	VarType mCurrentType;
+
+	NumType    mNumPart;    ///< The NumType component
+	BoolType   mBoolPart;   ///< The BoolType component
+	StringType mStringPart; ///< The StringType component
+
+	///Where GetOperandNum rounds to.
+	NumType mOperandNum;
+};
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief A stack of reusable Immediates.
+
+	Expressions can be evaluated inside other expressions (when a block
+	is called), so each evaluation takes what it needs from here and gives
+	it back when it's done.  Slots are never freed, so their numbers don't
+	have to be allocated again.
+
+	\sa ImmediateSlot
+*/
+class SS_API ImmediateStack
+{
+public:
+	///Constructor
+	ImmediateStack() : mTop( 0 ) {}
+
+	///Takes the next slot.
+	Immediate& Push();
+
+	///Gives back the last slot taken.
+	void Pop();
+
+private:
+	///The slots.  (A deque so they stay put as it grows.)
+	std::deque<Immediate> mSlots;
+	///The number of slots in use.
+	size_t mTop;
+};
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief Takes an Immediate from an ImmediateStack for as long as it exists.
+*/
+class ImmediateSlot
+{
+public:
+	///Constructor
+	explicit ImmediateSlot( ImmediateStack& S ) : mStack( S ), mImmediate( S.Push() ) {}
+	///Destructor
+	~ImmediateSlot() { mStack.Pop(); }
+
+	Immediate& operator*() { return mImmediate; }
+	Immediate* operator->() { return &mImmediate; }
+
+private:
+	ImmediateSlot( const ImmediateSlot& );
+	ImmediateSlot& operator=( const ImmediateSlot& );
+
+	ImmediateStack& mStack;
+	Immediate& mImmediate;
+};
+
+
+} //namespace SS
+#endif
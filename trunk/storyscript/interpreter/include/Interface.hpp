@@ -131,18 +131,21 @@ protected:
 	If there are only certain functions you don't want to define, you can simply
 	derive your interface from this.
 */
-class SS_API NullInterface
+class SS_API NullInterface : public Interface
 {
 public:
 	///Constructor
-	NullInterface();
+	NullInterface( Interpreter& I );
 	///Destructor
 	virtual ~NullInterface() {}
 	
-	virtual unsigned int PresentChoice( const std::vector<BlockPtr>& Choices );
+	///Always picks the first choice.
+	virtual unsigned int PresentChoice( const BlockList& Choices );
 	
-	virtual void HandleParserAnomaly();
+	///Re-throws the anomaly.
+	virtual void HandleParserAnomaly( ParserAnomaly A );
 	
+	///Throws the message away.
 	virtual void LogMessage( const SS::String&, bool = false );
 	
 protected:
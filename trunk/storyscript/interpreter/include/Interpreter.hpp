@@ -150,6 +150,23 @@ directory named "license".
 /// */
 /// AnInterface.StartConversation( "AVeryInterestingConversation.ssconv" );
 ///	\endcode
+///
+///6. Or, if you can't wait around for the player, step through it.
+///\code
+/// AnInterpreter.OpenFile( "AVeryInterestingConversation.ssconv" );
+/// AnInterpreter.Start( AnInterpreter.GetFirstBlock() );
+///
+/// /*
+///	Then, whenever it suits you (once a frame, say)...
+/// */
+/// if( AnInterpreter.Step() == SS::STEP_CHOICE )
+/// {
+///	/*
+///		Show AnInterpreter.GetPendingChoices(), and once the player picks one
+///		call AnInterpreter.ResumeWithChoice( Choice ).
+///	*/
+/// }
+///\endcode
 ///	
 	
 
@@ -168,10 +185,19 @@ directory named "license".
 //#include "ScriptFile.hpp"
 #include "Types.hpp"
 #include "Expression.hpp"
+#include "Immediate.hpp"
 
 #include "Bookmark.hpp"
+#include "ByteCode.hpp"
 #include "ReaderSourceFile.hpp"
+#include "ScriptImage.hpp"
+#include "StackSegment.hpp"
+#include "MemoCache.hpp"
+#include "Profiler.hpp"
+#include "LineProfiler.hpp"
+#include "Tracer.hpp"
 #include "Word.hpp"
+#include "RuntimeContext.hpp"
 
 
 #include <map>
@@ -183,6 +209,38 @@ namespace SS
 class Interface;
 
 
+/**
+	\brief Where a conversation being run with Interpreter::Step is at.
+*/
+enum StepState
+{
+	STEP_RUNNING,  ///< There are more lines to say.  Call Step again.
+	STEP_CHOICE,   ///< Waiting for a choice.  Call ResumeWithChoice.
+	STEP_FINISHED  ///< The conversation is over (or was never started).
+};
+
+
+/**
+	\brief One block call on the Interpreter's call stack.
+	
+	\sa Interpreter::GetCallStack
+*/
+struct CallFrame
+{
+	///The block being run.
+	BlockPtr pBlock;
+	///Where the caller was, along with its instance and static scopes.
+	Bookmark ReturnPos;
+	///The block's instance scope.  (Where 'in', 'out', and non-statics live.)
+	ScopePtr pInstance;
+	///The 'out' in the instance scope.
+	VariablePtr pOut;
+};
+
+///The blocks being run, outermost first.
+typedef std::vector<CallFrame> CallStack;
+
+
 
 //~~~~~~~CLASS~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 /**
@@ -225,6 +283,216 @@ public:
 	*/ 
 	void SetVerbose( bool Flag = true );
 	
+	/**
+		\brief Checks if blocks are being run as byte code.
+		
+		\return True if blocks are compiled and run by the VM, false if
+			they are run straight from the source words.
+	*/
+	bool IsUsingByteCode() const;
+	
+	/**
+		\brief Turns the byte code VM on/off.
+		
+		\param Flag True for on, False for off.
+	*/
+	void SetUseByteCode( bool Flag = true );
+	
+	/**
+		\brief Checks if the results of pure blocks are remembered.
+		
+		\sa SetMemoizeBlocks
+	*/
+	bool IsMemoizingBlocks() const;
+	
+	/**
+		\brief Turns memoization of pure blocks on/off.
+		
+		When on, a block called as a function is checked (once) to see
+		if it is pure: if it only uses 'in', 'out', its own 'var's,
+		constants, SS:Math, and other pure blocks, and has no statics or
+		blocks declared in it.  Its 'out' for each 'in' is then remembered,
+		and later calls with the same 'in' don't run the block at all.
+		Anything that prints, reads the time, or touches any other
+		variable is run every time.
+		
+		The number of results kept is set by LangOpts::MemoCacheSize.
+		
+		\param Flag True for on, False for off.
+	*/
+	void SetMemoizeBlocks( bool Flag = true );
+	
+	///Returns the memoization counters.
+	const MemoStats& GetMemoStats() const;
+	
+	/**
+		\brief Checks if blocks are being profiled.
+		
+		\sa SetProfiling
+	*/
+	bool IsProfiling() const;
+	
+	/**
+		\brief Turns the block profiler on/off.
+		
+		When on, every block run is timed, and the ScopeObjects it creates
+		are counted.  Turning it on starts the profile over.
+		
+		\param Flag True for on, False for off.
+		\sa GetProfiler
+	*/
+	void SetProfiling( bool Flag = true );
+	
+	///Returns the block profiler.
+	const Profiler& GetProfiler() const;
+	
+	/**
+		\brief Checks if lines are being counted.
+		
+		\sa SetLineProfiling
+	*/
+	bool IsLineProfiling() const;
+	
+	/**
+		\brief Turns the line profiler on/off.
+		
+		When on, every statement parsed and every expression evaluated
+		is counted against the line it starts on, and evaluations are
+		timed.  Turning it on starts the counts over.  When off, all it
+		costs is a check per evaluation.
+		
+		\param Flag True for on, False for off.
+		\sa GetLineProfiler
+	*/
+	void SetLineProfiling( bool Flag = true );
+	
+	///Returns the line profiler.
+	const LineProfiler& GetLineProfiler() const;
+	
+	/**
+		\brief Checks if a trace is being recorded.
+		
+		\sa SetTracing
+	*/
+	bool IsTracing() const;
+	
+	/**
+		\brief Turns the tracer on/off.
+		
+		When on, a timeline is kept of files being loaded and parsed,
+		blocks being run, expressions being read for the first time,
+		and the wait for each choice.  Turning it on starts the trace
+		over.
+		
+		\param Flag True for on, False for off.
+		\sa GetTracer
+	*/
+	void SetTracing( bool Flag = true );
+	
+	///Returns the tracer.  (Tracer::Write saves the trace.)
+	const Tracer& GetTracer() const;
+	
+	/**
+		\brief Checks if loaded files are cached.
+		
+		\return True if the words of loaded files are saved to and loaded
+			from cache files.
+		
+		\sa ReaderSourceFile
+	*/
+	bool IsUsingTokenCache() const;
+	
+	/**
+		\brief Turns the token cache on/off.
+		
+		When on, each file is tokenized once and saved next to it in a
+		".ssc" file, which is used instead until the file changes.  Only
+		affects files loaded after this is called.
+		
+		\param Flag True for on, False for off.
+	*/
+	void SetUseTokenCache( bool Flag = true );
+	
+	/**
+		\brief Limit how many statements a script may run at a go.
+		
+		Counting starts over with each line said, and each file loaded.
+		If a script runs more than this (say it's stuck in a 'while' that
+		never ends), an anomaly with code ANOMALY_OVERBUDGET is thrown.
+		
+		\param Statements The most statements, or 0 for no limit.
+	*/
+	void SetStatementBudget( boost::uint64_t Statements );
+	
+	///Returns the statement budget.  (0 for no limit.)
+	boost::uint64_t GetStatementBudget() const;
+	
+	/**
+		\brief Limit how long a script may run at a go.
+		
+		The same as SetStatementBudget, but for wall-clock time.  The
+		clock is only looked at every few hundred statements.
+		
+		\param Milliseconds The most time, or 0 for no limit.
+	*/
+	void SetTimeBudget( unsigned int Milliseconds );
+	
+	///Returns the time budget in milliseconds.  (0 for no limit.)
+	unsigned int GetTimeBudget() const;
+	
+	/**
+		\brief Limit how deep blocks may call blocks.
+		
+		Each call is noted in the call stack, but still runs on the native
+		stack, so very deep recursion is also held back by
+		SetMaxStackSegments.  Going deeper than this throws an anomaly with
+		code ANOMALY_TOODEEP.
+		
+		\param Depth The deepest, or 0 for no limit.
+	*/
+	void SetMaxCallDepth( size_t Depth );
+	
+	///Returns the deepest blocks may call blocks.  (0 for no limit.)
+	size_t GetMaxCallDepth() const;
+	
+	/**
+		\brief Limit how much stack deep calls may use.
+		
+		When a script has used up a good part of the native stack, with
+		deep calls or deeply nested bodies or expressions, it carries on
+		in 1M stack segments, which are freed again as it comes back out.
+		Needing more segments than this throws an anomaly with code
+		ANOMALY_TOODEEP.
+		
+		Each block call takes about 3K of stack, so one segment holds
+		around 300 calls, and the default of 256 segments (256M at most)
+		allows some 70,000.  That is deep enough for Ack(3,13), which
+		goes about 2^(n+3) calls deep.
+		
+		\param Count The most segments, or 0 for no limit.
+	*/
+	void SetMaxStackSegments( size_t Count );
+	
+	///Returns the most stack segments calls may use.  (0 for no limit.)
+	size_t GetMaxStackSegments() const;
+	
+	///Returns the blocks being run right now, outermost first.
+	const CallStack& GetCallStack() const;
+	
+	/**
+		\brief Read files from a ScriptImage.
+		
+		Files in the image are read from it rather than loaded again.
+		Anything else is loaded as usual.  Only affects files loaded after
+		this is called.
+		
+		\param pImage The image, or null to stop using one.
+	*/
+	void SetScriptImage( ScriptImagePtr pImage );
+	
+	///Returns the ScriptImage being used, if any.
+	ScriptImagePtr GetScriptImage() const;
+	
 	/**
 		\brief Set the Interface being used.
 		
@@ -234,6 +502,27 @@ public:
 	*/
 	void SetInterface( Interface& I );
 	
+	/**
+		\brief Make this interpreter's RuntimeContext current for this thread.
+		
+		The interpreter does this itself whenever it is called on, and
+		puts the old context back when it's done, so this is only needed
+		to use numbers, lists and so on outside of it (from an Interface
+		on another thread, say).  Unlike the interpreter's own, this one
+		stays current until something else is made current.
+		
+		\sa RuntimeContext GetContext
+	*/
+	void MakeCurrent();
+
+	/**
+		\brief Returns this interpreter's RuntimeContext.
+
+		Wrap a RuntimeContextGuard around it to use the interpreter's
+		numbers and so on for a little while, without it sticking.
+	*/
+	RuntimeContext& GetContext();
+	
 	
 	/**
 		\brief Begin executing a generic reader source.
@@ -272,6 +561,47 @@ public:
 	*/
 	void Parse( BlockPtr pB, bool SayBlock = true, VariableBasePtr In = VariableBasePtr() );
 
+	/**
+		\brief Get a conversation ready to be run a line at a time.
+		
+		Nothing is executed until Step is called.  This is the
+		counterpart to Parse that never waits on the Interface's
+		PresentChoice, so one thread can keep any number of
+		conversations going while each waits on its player.
+		
+		\param BlockName The identifier name of the first block.
+	*/
+	void Start( const SS::String& BlockName );
+	
+	///Same as the above, with the block already found.
+	void Start( BlockPtr pB );
+	
+	/**
+		\brief Execute and say the next line of the conversation.
+		
+		Nothing is left on the stack between calls.  When this returns
+		STEP_CHOICE the choices are in GetPendingChoices, and the
+		conversation stays put until ResumeWithChoice is called.
+		
+		\return Where the conversation is at now.
+	*/
+	StepState Step();
+	
+	/**
+		\brief Pick one of the pending choices.
+		
+		Only the choice is made here.  Call Step to go on.
+		
+		\param Index Index into GetPendingChoices.
+	*/
+	void ResumeWithChoice( unsigned int Index );
+	
+	///Returns where the conversation being stepped is at.
+	StepState GetStepState() const;
+	
+	///Returns the choices waiting on ResumeWithChoice.  (Empty if there are none.)
+	const BlockList& GetPendingChoices() const;
+
 	///Returns a bookmark to the current position.
 	Bookmark GetCurrentPos();
 	///Returns a pointer to the current scope.
@@ -298,6 +628,28 @@ public:
 	*/
 	ScopeObjectPtr GetScopeObject( const SS::CompoundString& Name );
 	
+	///Same as the above, but with the identifier already interned.
+	ScopeObjectPtr GetScopeObject( const SS::CompoundSymbol& Name );
+	
+	///Same as GetScopeObject, but returns a null pointer if nothing is found.
+	ScopeObjectPtr GetScopeObject_NoThrow( const SS::CompoundSymbol& Name );
+	
+	/**
+		\brief Find an identifier, using a remembered lookup if it's still good.
+		
+		If R is still current the object it found is returned straight
+		away.  Otherwise the identifier is looked up normally, and R
+		remembers the result along with every scope that was searched.
+		
+		\sa ScopeResolution
+		
+		\param Name The interned identifier.
+		\param R The remembered lookup.  Each place an identifier is used
+			should have its own.
+		\return The object, or a null pointer if nothing is found.
+	*/
+	ScopeObjectPtr GetScopeObject_NoThrow( const SS::CompoundSymbol& Name, ScopeResolution& R );
+	
 	/**
 		\breif A shortcut for object creation/registration.
 		
@@ -344,6 +696,36 @@ public:
 	///Return a reference to the current interface.
 	Interface& GetInterface();
 	
+	///Returns the stack Expressions keep their intermediate values on.
+	ImmediateStack& GetImmediateStack() { return mImmediates; }
+	
+	///Returns the line profiler if it is on, else null.  (Expressions count themselves in it.)
+	LineProfiler* GetActiveLineProfiler() { return mLineProfiling ? &mLineProfiler : 0; }
+	
+	///Returns the tracer if it is on, else null.
+	Tracer* GetActiveTracer() { return mTracing ? &mTracer : 0; }
+	
+	/**
+		\brief Returns true if the stack is too deep to safely go deeper.
+		
+		Anything that recurses while a block runs (calls, nested bodies,
+		nested expressions) checks this, and carries on with
+		RunOnNewSegment if it is true.
+	*/
+	bool NeedsNewSegment() const
+	{
+		char StackHere;
+		return mpStackBase && mpStackBase - &StackHere > (std::ptrdiff_t)mStackLimit;
+	}
+	
+	/**
+		\brief Run F( pArg ) on a fresh stack segment.
+		
+		Throws an anomaly with code ANOMALY_TOODEEP if that would be more
+		segments than SetMaxStackSegments allows.
+	*/
+	void RunOnNewSegment( StackSegment::Function F, void* pArg );
+	
 	/**
 		\brief Imports a file's scope into the current one.
 		
@@ -373,6 +755,117 @@ public:
 	friend class Interface;
 
 private:
+	///Execute a block without saying it.
+	void RunBlock( BlockPtr pB, VariableBasePtr In );
+	
+	///Execute a block without saying it, using a remembered result if it is pure.
+	void RunBlockMemoized( BlockPtr pB, VariableBasePtr In );
+	
+	///Returns true if the block's results can be remembered.  \sa SetMemoizeBlocks
+	bool IsPureBlock( BlockPtr pB );
+	
+	/**
+		\brief Does the actual work for IsPureBlock.
+		
+		\param Assumed Blocks being looked at already.  They are taken to be
+			pure, so blocks that call each other don't go round forever.
+		\param Calls Filled in with the blocks each one looked at calls.
+	*/
+	bool CheckPurity( BlockPtr pB, std::vector<const Block*>& Assumed,
+					  std::map< const Block*, std::vector<Block*> >& Calls );
+	
+	///Adds pB's callees, and theirs, to Callees.  (Calls is from CheckPurity.)
+	void GatherCallees( const Block* pB, const std::map< const Block*, std::vector<Block*> >& Calls,
+						std::vector<Block*>& Callees );
+	
+	///What RunBlock runs, gathered up so it can be handed to another stack segment.
+	struct BlockBody
+	{
+		Interpreter* pI;
+		///The byte code to run, or null to use the token walker.
+		const ByteCode* pCode;
+		Bookmark Pos;
+		bool IgnoreStatic;
+	};
+	
+	///Run a block's statements.  (pBody is a BlockBody.)
+	static void RunBlockBody( void* pBody );
+	
+	///A nested Parse, gathered up so it can be handed to another stack segment.
+	struct ParseCall
+	{
+		Interpreter* pI;
+		Bookmark Pos;
+		bool OneStatement;
+		bool IgnoreStatic;
+	};
+	
+	///Runs a nested Parse.  (pCall is a ParseCall.)
+	static void ParseOnSegment( void* pCall );
+	
+	///What RunOnNewSegment hands to the segment.
+	struct SegmentCall
+	{
+		Interpreter* pI;
+		StackSegment::Function F;
+		void* pArg;
+	};
+	
+	///The first thing run on a new segment.  (pCall is a SegmentCall.)
+	static void EnterSegment( void* pCall );
+	
+	///Go back to the stack that was in use before a segment, and free the spare ones.
+	void LeaveSegment( char* pOldStackBase, size_t OldStackLimit );
+	
+	/**
+		\brief Pop a block's call off the stack, and go back to the caller.
+		
+		RunBlock does this whether the block finishes or throws, so the
+		caller's position and scopes are always put back the same way.
+	*/
+	void LeaveBlock( BlockPtr pBlock );
+	
+	///An instance scope, with its 'in' and 'out', kept to be used again.
+	struct FrameSlot
+	{
+		ScopePtr pInstance;
+		ListPtr pIn;
+		VariablePtr pOut;
+	};
+	
+	/**
+		\brief Get the instance scope for a call at the given depth ready.
+		
+		The last call's instance at that depth is emptied out and used
+		again, unless something still has hold of it.  Either way, 'in' is
+		set to a copy of In, and 'out' is set to an empty string.
+	*/
+	FrameSlot& GetFrameSlot( size_t Depth, VariableBasePtr In );
+	
+	/**
+		\brief Execute and say a block.
+		
+		\param Next Filled with the blocks that may be said next.
+	*/
+	void SayLine( BlockPtr pB, BlockList& Next );
+	
+	/**
+		\brief Returns the chosen line, or null if the conversation is over.
+	*/
+	BlockPtr ChooseLine( const BlockList& Choices, unsigned int Index );
+	
+	///Start counting statements against the budgets again.
+	void ResetBudget();
+	
+	///Count a statement against the budgets.
+	void CountStatement()
+	{
+		if( ++mStatementCount >= mNextBudgetCheck ) CheckBudget();
+	}
+	
+	///Throws an anomaly if a budget is used up, else works out when to check next.
+	void CheckBudget();
+	
 	///Throws an anomaly if no reader source has been loaded.
 	void AssertSourceOpen();	
 	///Throws an anomaly if no interface has been attached.
@@ -386,9 +879,6 @@ private:
 	*/
 	ReaderSource& GetSource( const Bookmark& );
 	
-	///The interpreters instance.  There can only be one.
-	static boost::shared_ptr<Interpreter> mpInstance;
-	
 	/**
 		\brief The actual parsing function in the interpreter.
 		
@@ -466,12 +956,55 @@ private:
 	///Throws a End of File Anomaly.
 	void ThrowUnexpectedEOF() const;
 	
-	///Add current script info onto a Anomaly throw by someone else.
+	///Add current script info onto a Anomaly throw by someone else.  (Unless it already has some.)
 	void TackOnScriptInfo( ParserAnomaly& );
 
 	///Move the position up to the next statement.
 	void FastForwardToNextStatement( ReaderSource& );
 	
+	///Move the position past the '}' that closes the current body.
+	void FastForwardPastBody( ReaderSource& );
+	
+	/**
+		\brief Get a block's compiled body.
+		
+		This compiles the block the first time it is asked for.
+	*/
+	ByteCodePtr GetByteCode( BlockPtr pBlock );
+	
+	/**
+		\brief Compile a body into byte code.
+		
+		Compiles from the current position up to the '}' that closes the
+		body, and leaves the position just past it.  If the body can't be
+		compiled the returned ByteCode is flagged to use the token walker.
+	*/
+	ByteCodePtr CompileByteCode( ReaderSource& );
+	
+	///Compile statements up to the closing '}'.
+	void CompileBody( ReaderSource&, ByteCode& );
+	
+	/**
+		\brief Compile a single statement.
+		
+		\param TakeElse False if a following 'else' belongs to an enclosing
+			statement (ie. this is the body of an 'if ... then').
+		\return False if the closing '}' was found instead of a statement.
+	*/
+	bool CompileStatement( ReaderSource&, ByteCode&, bool TakeElse );
+	
+	///Compile an optional 'else' after a conditional whose false jump is at FalseJump.
+	void CompileElse( ReaderSource&, ByteCode&, size_t FalseJump, bool TakeElse );
+	
+	/**
+		\brief The byte code counterpart to Parse.
+		
+		\param Code The compiled body.
+		\param B Bookmark to the body, with the scopes to run it in.
+		\param IgnoreStatic Same as in Parse.
+	*/
+	void Run( const ByteCode& Code, const Bookmark& B, bool IgnoreStatic );
+	
 	/**
 		\brief Shut everything down.
 		
@@ -480,11 +1013,71 @@ private:
 	*/ 
 	void Close();
 
+	/**
+		Everything that would otherwise be global.  This comes first so
+		that it outlives all the scopes and numbers below.
+	*/
+	RuntimeContext mContext;
+
+	/**
+		\brief Puts the thread's old context back once the members are gone.
+
+		The destructor makes mContext current so the scopes and numbers
+		below are given back to it.  A guard in the destructor's body
+		would be gone before they are, so this is armed instead.  Being
+		declared right after mContext, it goes after everything else.
+	*/
+	struct ContextRestorer
+	{
+		ContextRestorer() : Armed( false ), pOldContext( 0 ) {}
+		~ContextRestorer() { if( Armed ) RuntimeContext::SetCurrent( pOldContext ); }
+
+		bool Armed;
+		RuntimeContext* pOldContext;
+	};
+	ContextRestorer mContextRestorer;
+
 	///The Interpreter's current Interface.
 	Interface* mpInterface;
 
-	///This is bound to SS::LangOpts::Verbose, for convenience.
-	static bool& mVerboseOutput;
+	///This is bound to the context's LangOpts::Verbose, for convenience.
+	bool& mVerboseOutput;
+	
+	///This is bound to the context's LangOpts::UseByteCode.
+	bool& mUseByteCode;
+	
+	///This is bound to the context's LangOpts::MemoizeBlocks.
+	bool& mMemoizeBlocks;
+	
+	///Remembered results of pure blocks.
+	MemoCache mMemo;
+	
+	///True if blocks are being profiled.
+	bool mProfiling;
+	
+	///Where the time went.  \sa SetProfiling
+	Profiler mProfiler;
+	
+	///True if lines are being counted.
+	bool mLineProfiling;
+	
+	///Which lines are hot.  \sa SetLineProfiling
+	LineProfiler mLineProfiler;
+	
+	///True if a trace is being recorded.
+	bool mTracing;
+	
+	///The timeline.  \sa SetTracing
+	Tracer mTracer;
+	
+	///When the pending choice came up, on the tracer's clock.  (For stepping.)
+	boost::uint64_t mChoiceTime;
+	
+	///True if loaded files should use the token cache.
+	bool mUseTokenCache;
+	
+	///Where files are read from before trying to load them.  (May be null.)
+	ScriptImagePtr mpImage;
 
 	///This is used to keep track of the order of all the blocks in a file.
 	std::vector<BlockPtr> mBlockOrder;
@@ -506,6 +1099,13 @@ private:
 	///The magic end block.
 	BlockPtr mpEndBlock;
 	
+	///Where the conversation being stepped is at.
+	StepState mStepState;
+	///The next line Step will say.
+	BlockPtr mpNextLine;
+	///The choices waiting on ResumeWithChoice.
+	BlockList mPendingChoices;
+	
 	
 	/**
 		\brief An expression that has been cached for latter use.
@@ -545,8 +1145,40 @@ private:
 	///The Interpreter's Expression cache.
 	CachedExpressionMap mCachedExpressions;
 	
+	///Intermediate values for the expressions being evaluated.
+	ImmediateStack mImmediates;
+	
 	///Keeps track of whether the interpreter should return from a block.
 	bool mStop;
+	
+	///The blocks being run.
+	CallStack mCallStack;
+	///The deepest mCallStack may get.  (0 for no limit.)
+	size_t mMaxCallDepth;
+	///Instance scopes for each depth of mCallStack, so calls needn't create new ones.
+	std::vector<FrameSlot> mFramePool;
+	
+	///Where the native stack (or stack segment) in use started.  (Null outside of any block.)
+	char* mpStackBase;
+	///How much of it may be used before carrying on in a new segment.
+	size_t mStackLimit;
+	///Stack segments in use, and one spare for the next time the calls get that deep.
+	std::vector< boost::shared_ptr<StackSegment> > mStackSegments;
+	///How many of mStackSegments are in use.
+	size_t mSegmentDepth;
+	///The most stack segments that may be in use.  (0 for no limit.)
+	size_t mMaxStackSegments;
+	
+	///The most statements a script may run at a go.  (0 for no limit.)
+	boost::uint64_t mStatementBudget;
+	///The most milliseconds a script may run at a go.  (0 for no limit.)
+	unsigned int mTimeBudget;
+	///Statements run since the budgets were reset.
+	boost::uint64_t mStatementCount;
+	///When mStatementCount gets here, CheckBudget is called.
+	boost::uint64_t mNextBudgetCheck;
+	///When the budgets were reset, from GetMicroseconds.
+	boost::uint64_t mBudgetStart;
 };
 
 } //namespace SS
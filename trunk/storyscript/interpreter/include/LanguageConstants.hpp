@@ -20,7 +20,8 @@ namespace SS{
 	
 	
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
- NOTES: A singleton containing important variable affecting language behavior.
+ NOTES: Contains important variable affecting language behavior.  There is
+		one for each RuntimeContext, and Instance returns the current one.
 */
 struct LangOpts
 {
@@ -33,26 +34,19 @@ public:
 	unsigned long NumberBase;
 	bool UseStrictLists;
 	bool Verbose;
+	bool UseByteCode;
+	bool MemoizeBlocks;
+	unsigned long MemoCacheSize;
 	
 			
 
 private:
+	friend class RuntimeContext;
 	LangOpts();
-	static boost::shared_ptr<LangOpts> mpInstance;
 	
 };
 
 
-/*
-	EXTREMELY IMPORTANT:
-	These are language constants that will be registered in the global scope.
-*/
-extern VariablePtr gpNANConst;
-extern VariablePtr gpInfinityConst;
-extern VariablePtr gpNegInfinityConst;
-extern VariablePtr gpNewLineConst;
-
-
 //Call this once to set up all the locale info and such
 void InitConstants();
 
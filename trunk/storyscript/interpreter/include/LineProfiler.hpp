@@ -0,0 +1,156 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+/**
+	\file LineProfiler.hpp
+	\brief Declarations for LineProfiler.
+*/
+
+#if !defined(SS_LineProfiler)
+#define SS_LineProfiler
+
+#include "Defines.hpp"
+#include "DLLExport.hpp"
+#include "Unicode.hpp"
+
+#include <boost/cstdint.hpp>
+#include <map>
+#include <vector>
+
+namespace SS{
+
+
+/**
+	\brief What a LineProfiler found out about one line of a script.
+*/
+struct LineProfile
+{
+	LineProfile()
+		: Line(0), Statements(0), Evaluations(0), InclusiveTime(0), ExclusiveTime(0) {}
+
+	SS::String FileName;           ///< The file the line is in.
+	unsigned long Line;            ///< The line number.  (Starting at 1.)
+	boost::uint64_t Statements;    ///< Statements started on the line.
+	boost::uint64_t Evaluations;   ///< Expressions starting on the line that were evaluated.
+	boost::uint64_t InclusiveTime; ///< Microseconds spent evaluating them, and whatever they called.
+	boost::uint64_t ExclusiveTime; ///< Microseconds spent evaluating them, not counting other lines.
+};
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief Keeps track of which lines of a script are hot.
+
+	The Interpreter counts each statement it parses, and each Expression
+	counts and times its evaluations.  Both are charged to the line the
+	statement or expression starts on.  Time is wall-clock time, as with
+	Profiler, and a line that ends up calling itself (through a block)
+	only has its outermost evaluation counted in its inclusive time.
+
+	Lines are remembered by file name, so nothing here is lost when
+	files are closed.
+
+	\sa Interpreter::SetLineProfiling Profiler
+*/
+class SS_API LineProfiler
+{
+public:
+	///Constructor
+	LineProfiler();
+
+	///A statement starting on the given line is about to be run.
+	void CountStatement( const SS::String& FileName, unsigned long Line );
+
+	///An expression starting on the given line is about to be evaluated.
+	void Enter( const SS::String& FileName, unsigned long Line );
+
+	///The evaluation Enter was last called for is done.  (Does nothing if there isn't one.)
+	void Leave();
+
+	///Forget everything.
+	void Clear();
+
+	/**
+		\brief Gets every counted line's profile.
+
+		\param Report Set to the profiles, the most exclusive time first.
+	*/
+	void GetReport( std::vector<LineProfile>& Report ) const;
+
+	///Sets Files to the names of the files that have counted lines.
+	void GetFiles( std::vector<SS::String>& Files ) const;
+
+	/**
+		\brief Makes an annotated listing of a file.
+
+		Every line of the file is listed, with its counts and times in
+		front of it.  If the file can't be read, only the counted lines
+		are listed (without their text).
+
+		\param FileName The file, as it was given to the interpreter.
+		\param Listing Set to the listing.
+	*/
+	void GetListing( const SS::String& FileName, SS::String& Listing ) const;
+
+private:
+	LineProfiler( const LineProfiler& );
+	LineProfiler& operator=( const LineProfiler& );
+
+	///What is kept for each line.
+	struct Record
+	{
+		Record() : Active( 0 ) {}
+
+		LineProfile Profile;
+		///Evaluations on the line that haven't finished.
+		unsigned int Active;
+	};
+
+	///An evaluation that hasn't finished.
+	struct Activation
+	{
+		Record* pRecord;
+		boost::uint64_t StartTime;
+		///Time that went to evaluations it caused.
+		boost::uint64_t ChildTime;
+	};
+
+	///Finds (or adds) a line's record.
+	Record& GetRecord( const SS::String& FileName, unsigned long Line );
+
+	typedef std::map< unsigned long, Record > LineMap;
+	std::map< SS::String, LineMap > mFiles;
+
+	std::vector< Activation > mActive;
+};
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief Calls LineProfiler::Leave when it goes out of scope.
+
+	Call Enter first, then make one of these, so the evaluation is
+	finished whatever gets thrown out of it.  The pointer can be null
+	(line profiling is off), and then this does nothing.
+*/
+class LineSpan
+{
+public:
+	LineSpan( LineProfiler* pLines ) : mpLines( pLines ) {}
+	~LineSpan(){ if( mpLines ) mpLines->Leave(); }
+
+private:
+	LineSpan( const LineSpan& );
+	LineSpan& operator=( const LineSpan& );
+
+	LineProfiler* mpLines;
+};
+
+
+} //namespace SS
+#endif
@@ -145,7 +145,7 @@ public:
 	//virtual VariableBasePtr op_not() const;
 
 protected:
-	virtual ScopeObjectPtr GetScopeObjectHook( const SS::String& );
+	virtual ScopeObjectPtr GetScopeObjectHook( SymbolID );
 
 private:
 	void RegisterPredefinedVars();
@@ -211,9 +211,6 @@ private:
 };
 
 
-extern ListPtr gpEmptyList;
-
-
 
 }//namespace
 #endif
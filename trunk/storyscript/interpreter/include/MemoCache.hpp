@@ -0,0 +1,156 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+/**
+	\file MemoCache.hpp
+	\brief Declarations for MemoCache.
+*/
+
+#if !defined(SS_MemoCache)
+#define SS_MemoCache
+
+#include "Defines.hpp"
+#include "DLLExport.hpp"
+#include "Unicode.hpp"
+#include "Types.hpp"
+
+#include <boost/cstdint.hpp>
+#include <map>
+#include <vector>
+
+namespace SS{
+
+class Block;
+
+
+/**
+	\brief Counters kept by a MemoCache.
+*/
+struct MemoStats
+{
+	MemoStats() : Hits(0), Misses(0), Entries(0), Flushes(0) {}
+
+	boost::uint64_t Hits;    ///< Calls answered from the cache.
+	boost::uint64_t Misses;  ///< Calls to pure blocks that had to be run.
+	boost::uint64_t Entries; ///< Results in the cache right now.
+	boost::uint64_t Flushes; ///< Times the cache filled up and was emptied.
+};
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief Remembers what pure blocks returned for each 'in'.
+
+	A block is pure if what it puts in 'out' depends on nothing but 'in',
+	and it changes nothing but its own non-statics.  Calls to such a block
+	can be answered from here instead of running it.  Whether a block is
+	pure is worked out by the Interpreter, and kept here too.
+
+	Every call also leaves its result in the block's static 'out', which
+	scripts can read as 'f:out'.  So a result is kept along with the
+	static 'out' of every block the call may have called, and they are
+	all put back when it is used.
+
+	Blocks are remembered by address, so the cache has to be cleared
+	whenever blocks may have been destroyed.
+
+	\sa Interpreter::SetMemoizeBlocks
+*/
+class SS_API MemoCache
+{
+public:
+	///What is known about a block.
+	enum Purity
+	{
+		PURITY_UNKNOWN, ///< It hasn't been looked at yet.
+		PURITY_PURE,    ///< Its results can be remembered.
+		PURITY_IMPURE   ///< It has to be run every time.
+	};
+
+	///Constructor
+	MemoCache();
+
+	///Returns what is known about a block.
+	Purity GetPurity( const Block* pBlock ) const;
+
+	///Records what was worked out about a block.
+	void SetPurity( const Block* pBlock, Purity P );
+
+	///Returns the blocks a pure block may call, directly or not.  (Not counting itself.)
+	const std::vector<Block*>& GetCallees( const Block* pBlock ) const;
+
+	///Records the blocks a pure block may call.
+	void SetCallees( const Block* pBlock, const std::vector<Block*>& Callees );
+
+	///A remembered call.
+	struct Result
+	{
+		///What the block left in 'out'.
+		VariablePtr pOut;
+		///What each of its callees was left with in 'out'.  (In GetCallees order.)
+		std::vector<VariablePtr> CalleeOuts;
+	};
+
+	/**
+		\brief Makes the key a call is remembered by.
+
+		\param In The block's 'in'.  (May be null.)
+		\param Key Set to the key.
+	*/
+	static void MakeKey( const VariableBasePtr& In, SS::String& Key );
+
+	/**
+		\brief Looks up a remembered result.
+
+		\return What the block gave for Key, or null if there isn't one.
+	*/
+	const Result* Find( const Block* pBlock, const SS::String& Key );
+
+	/**
+		\brief Remembers a result.
+
+		If the cache already holds Limit results, it is emptied first.
+
+		\param Out The value of the block's 'out'.  (It is copied.)
+		\param CalleeOuts The static 'out' of each of its callees, in
+			GetCallees order.  (They are copied.)
+		\param Limit The most results to keep, or 0 for no limit.
+	*/
+	void Insert( const Block* pBlock, const SS::String& Key,
+				 const VariableBase& Out, const std::vector<VariablePtr>& CalleeOuts,
+				 size_t Limit );
+
+	///Forget every result, and everything known about the blocks.
+	void Clear();
+
+	///Returns the counters.
+	const MemoStats& GetStats() const;
+
+private:
+	MemoCache( const MemoCache& );
+	MemoCache& operator=( const MemoCache& );
+
+	///What is kept for each block.
+	struct BlockEntry
+	{
+		BlockEntry() : P( PURITY_UNKNOWN ) {}
+
+		Purity P;
+		std::vector<Block*> Callees;
+		std::map< SS::String, Result > Results;
+	};
+
+	typedef std::map< const Block*, BlockEntry > BlockMap;
+	BlockMap mBlocks;
+
+	MemoStats mStats;
+};
+
+
+} //namespace SS
+#endif
@@ -0,0 +1,185 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+/**
+	\file Mutex.hpp
+	\brief Declarations for Mutex, MutexLock, Condition, Thread and the atomic helpers.
+*/
+
+#if !defined(SS_Mutex)
+#define SS_Mutex
+
+#include "Defines.hpp"
+#include "DLLExport.hpp"
+#include <boost/cstdint.hpp>
+
+namespace SS{
+
+class Condition;
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief A plain (non-recursive) mutex.
+
+	This is only for the little bit of state that all the interpreters in a
+	process share, and for the Scheduler.  Everything else belongs to one
+	interpreter.
+
+	\sa MutexLock Condition RuntimeContext
+*/
+class SS_API Mutex
+{
+public:
+	///Constructor
+	Mutex();
+	///Destructor
+	~Mutex();
+
+	void Lock();
+	void Unlock();
+
+	friend class Condition;
+
+private:
+	Mutex( const Mutex& );
+	Mutex& operator=( const Mutex& );
+
+	///The platform's mutex.  (Kept out of this header so it doesn't drag in windows.h.)
+	void* mpHandle;
+};
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief Holds a Mutex locked for as long as it exists.
+*/
+class MutexLock
+{
+public:
+	///Constructor
+	explicit MutexLock( Mutex& M ) : mMutex( M ) { mMutex.Lock(); }
+	///Destructor
+	~MutexLock() { mMutex.Unlock(); }
+
+private:
+	MutexLock( const MutexLock& );
+	MutexLock& operator=( const MutexLock& );
+
+	Mutex& mMutex;
+};
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief Lets threads sleep until another thread tells them something changed.
+
+	Always wait and signal with the same Mutex locked, and check what you
+	are waiting for again when Wait returns.
+*/
+class SS_API Condition
+{
+public:
+	///Constructor
+	Condition();
+	///Destructor
+	~Condition();
+
+	///Unlock M, sleep until signalled, then lock M again.
+	void Wait( Mutex& M );
+	///Wake one waiting thread.
+	void Signal();
+	///Wake every waiting thread.
+	void Broadcast();
+
+private:
+	Condition( const Condition& );
+	Condition& operator=( const Condition& );
+
+	///The platform's condition variable.
+	void* mpHandle;
+};
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief A thread of its own.
+*/
+class SS_API Thread
+{
+public:
+	///What a thread runs.
+	typedef void (*Function)( void* pArg );
+
+	///Constructor.  Starts running F( pArg ) right away, or throws an anomaly if it can't.
+	Thread( Function F, void* pArg );
+	///Destructor.  Joins the thread if that hasn't been done already.
+	~Thread();
+
+	///Wait for the thread to return.
+	void Join();
+
+private:
+	Thread( const Thread& );
+	Thread& operator=( const Thread& );
+
+	///The platform's thread.
+	void* mpHandle;
+	bool mJoined;
+};
+
+
+///Adds one to X, as one indivisible step, and returns the new value.
+SS_API boost::uint64_t AtomicIncrement( volatile boost::uint64_t& X );
+
+///Takes one from X, as one indivisible step, and returns the new value.
+SS_API boost::uint64_t AtomicDecrement( volatile boost::uint64_t& X );
+
+///Reads X, which another thread may be incrementing.
+inline boost::uint64_t AtomicRead( const volatile boost::uint64_t& X )
+{
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
+	return __atomic_load_n( &X, __ATOMIC_RELAXED );
+#else
+	//Aligned 64 bit reads are whole on the platforms this builds for.
+	return X;
+#endif
+}
+
+/**
+	\brief Reads a pointer that another thread may set with AtomicStorePointer.
+
+	Whatever that thread wrote before setting it is seen too, so the
+	object pointed to can be read without a lock.
+*/
+template< class T >
+inline T* AtomicLoadPointer( T* const volatile& p )
+{
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
+	return __atomic_load_n( &p, __ATOMIC_ACQUIRE );
+#else
+	//Volatile reads are acquires on the platforms this builds for.
+	return p;
+#endif
+}
+
+///Sets a pointer that other threads read with AtomicLoadPointer.
+template< class T >
+inline void AtomicStorePointer( T* volatile& p, T* Value )
+{
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
+	__atomic_store_n( &p, Value, __ATOMIC_RELEASE );
+#else
+	//Volatile writes are releases on the platforms this builds for.
+	p = Value;
+#endif
+}
+
+
+} //namespace SS
+#endif
@@ -0,0 +1,130 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+/**
+	\file NumPool.hpp
+	\brief Declarations for NumPool.
+*/
+
+#if !defined(SS_NumPool)
+#define SS_NumPool
+
+#include "Defines.hpp"
+#include "DLLExport.hpp"
+#include <mpfr.h>
+
+#include <vector>
+
+namespace SS{
+
+
+///Counts what a NumPool has done with one kind of number.
+struct NumPoolCounters
+{
+	NumPoolCounters() : Inits( 0 ), Reuses( 0 ), Clears( 0 ) {}
+
+	unsigned long Inits;  ///< Numbers initialized from scratch
+	unsigned long Reuses; ///< Numbers handed out again from the pool
+	unsigned long Clears; ///< Numbers actually freed
+};
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief Recycles initialized mpfr_t's and mpz_t's.
+
+	Initializing and clearing an mpfr_t allocates and frees its limbs, and
+	scripts go through a lot of temporary numbers.  So mpfr_t_wrap gets
+	them from here and gives them back when it's done, and they are handed
+	out again without touching the heap.  mpfr_t's are kept in buckets by
+	precision, since a number can only be reused at the precision it was
+	initialized with.
+
+	Each bucket only holds so many, so a burst of temporaries doesn't keep
+	its memory forever.
+
+	Every RuntimeContext has its own pool.  A number goes back to whichever
+	pool is current when it is destroyed, which needn't be the one it came
+	from.
+
+	\sa mpfr_t_wrap RuntimeContext
+*/
+class SS_API NumPool
+{
+public:
+	///Constructor
+	NumPool();
+	///Destructor.  Frees everything in the pool.
+	~NumPool();
+
+	///Returns the current context's pool.
+	static NumPool& Instance();
+
+	/**
+		\brief Initializes an mpfr_t, reusing one from the pool if it can.
+
+		\param X The mpfr_t.  Its value is NaN afterwards.
+		\param Prec The precision it should have.
+	*/
+	void Acquire( mpfr_ptr X, mpfr_prec_t Prec );
+
+	///Initializes an mpz_t, reusing one from the pool if it can.  Its value is undefined.
+	void Acquire( mpz_ptr X );
+
+	/**
+		\brief Gives back an mpfr_t from Acquire, to the current context's pool.
+
+		This is safe to call even after every context has been destroyed
+		(by numbers that outlive them at exit), in which case X is just
+		cleared.
+	*/
+	static void Release( mpfr_ptr X );
+
+	///Gives back an mpz_t from Acquire, like the other Release.
+	static void Release( mpz_ptr X );
+
+	///Frees everything that is waiting to be reused.
+	void Clear();
+
+	///Returns what has been done with mpfr_t's.
+	const NumPoolCounters& GetMpfrCounters() const { return mMpfrCounters; }
+	///Returns what has been done with mpz_t's.
+	const NumPoolCounters& GetMpzCounters() const { return mMpzCounters; }
+
+	///Sets all the counters back to zero.
+	void ResetCounters();
+
+private:
+	NumPool( const NumPool& );
+	NumPool& operator=( const NumPool& );
+
+	///The pooled mpfr_t's of one precision.
+	struct Bucket
+	{
+		mpfr_prec_t Prec;
+		std::vector<__mpfr_struct> Numbers;
+	};
+
+	///Returns the bucket for a precision, adding it if it isn't there yet.
+	Bucket& GetBucket( mpfr_prec_t Prec );
+
+	///The buckets.  (There are rarely more than a couple of precisions in use.)
+	std::vector<Bucket> mBuckets;
+	///The bucket last asked for.
+	size_t mLastBucket;
+
+	///The pooled mpz_t's.
+	std::vector<__mpz_struct> mIntegers;
+
+	NumPoolCounters mMpfrCounters;
+	NumPoolCounters mMpzCounters;
+};
+
+
+} //namespace SS
+#endif
@@ -53,7 +53,9 @@ enum AnomalyCode{
 	ANOMALY_LISTTOOBIG,
 	ANOMALY_BADPRECISION, //< Tried to set the precision of a variable too high or too low.
 	ANOMALY_NOBLOCKS, //< No blocks were found in the file.  The interpreter doesn't know what to do.
-	ANOMALY_NOOPERATOR //< Cannot find any operator in the expression.
+	ANOMALY_NOOPERATOR, //< Cannot find any operator in the expression.
+	ANOMALY_OVERBUDGET, //< The script ran longer than the interpreter's statement or time budget allows.
+	ANOMALY_TOODEEP //< Blocks called each other deeper than the interpreter's call depth allows.
 
 };
 
@@ -163,6 +165,10 @@ public:
 	
 	/// The line in the storyscript file in which the error occurred.
 	unsigned int ScriptLine;
+
+private:
+	/// What what() returns.  (Each exception has its own, so threads don't share one.)
+	mutable std::string mNarrowWhat;
 };
 
 
@@ -0,0 +1,119 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+/**
+	\file Profiler.hpp
+	\brief Declarations for Profiler.
+*/
+
+#if !defined(SS_Profiler)
+#define SS_Profiler
+
+#include "Defines.hpp"
+#include "DLLExport.hpp"
+#include "Unicode.hpp"
+
+#include <boost/cstdint.hpp>
+#include <map>
+#include <vector>
+
+namespace SS{
+
+class Block;
+
+
+/**
+	\brief What a Profiler found out about one block.
+*/
+struct BlockProfile
+{
+	BlockProfile() : Calls(0), InclusiveTime(0), ExclusiveTime(0), Allocations(0) {}
+
+	SS::String Name;               ///< The block's full name.
+	boost::uint64_t Calls;         ///< Times the block was run.
+	boost::uint64_t InclusiveTime; ///< Microseconds spent in the block, and the blocks it called.
+	boost::uint64_t ExclusiveTime; ///< Microseconds spent in the block itself.
+	boost::uint64_t Allocations;   ///< ScopeObjects created by the block itself.
+};
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief Keeps track of where the time goes, block by block.
+
+	The Interpreter calls Enter when it starts running a block and Leave
+	when it is done with it.  Time is wall-clock time, so a block that is
+	waiting on the player is charged for the wait.  A recursive block's
+	inclusive time only counts its outermost call.
+
+	Blocks are remembered by address while they're running, so call
+	Forget before they may be destroyed.  What was found out about them
+	is kept (by name) until Clear.
+
+	\sa Interpreter::SetProfiling
+*/
+class SS_API Profiler
+{
+public:
+	///Constructor
+	Profiler();
+
+	///A block is about to run.
+	void Enter( const Block* pBlock );
+
+	///The block Enter was last called for is done.  (Does nothing if there isn't one.)
+	void Leave();
+
+	///Stop using block addresses.  Their profiles are kept, by name.
+	void Forget();
+
+	///Forget everything.
+	void Clear();
+
+	/**
+		\brief Gets every block's profile.
+
+		\param Report Set to the profiles, the most exclusive time first.
+	*/
+	void GetReport( std::vector<BlockProfile>& Report ) const;
+
+private:
+	Profiler( const Profiler& );
+	Profiler& operator=( const Profiler& );
+
+	///What is kept for each block.
+	struct Record
+	{
+		Record() : Active( 0 ) {}
+
+		BlockProfile Profile;
+		///Calls to the block that haven't returned.
+		unsigned int Active;
+	};
+
+	///A call that hasn't returned.
+	struct Activation
+	{
+		Record* pRecord;
+		boost::uint64_t StartTime;
+		boost::uint64_t StartObjects;
+		///Time and objects that went to the blocks it called.
+		boost::uint64_t ChildTime;
+		boost::uint64_t ChildObjects;
+	};
+
+	std::map< const Block*, Record > mRecords;
+	std::vector< Activation > mActive;
+
+	///Profiles of blocks that have been forgotten, by name.
+	std::map< SS::String, BlockProfile > mRetired;
+};
+
+
+} //namespace SS
+#endif
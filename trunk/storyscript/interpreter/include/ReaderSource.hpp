@@ -19,6 +19,9 @@ directory named "license".
 #include "Types.hpp"
 #include "DLLExport.hpp"
 
+#include <iosfwd>
+#include <queue>
+
 namespace SS{
 
 
@@ -28,6 +31,39 @@ typedef unsigned long ReaderPos;
 ///A buffer to hold words
 typedef std::vector<Word> WordBuffer;
 
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief The words read from a source, and the tables that go with them.
+	
+	Once a source has been read to the end these never change again, so
+	they can be shared by any number of ReaderSources (on any number of
+	threads).
+	
+	\sa ReaderSource::FinishWords ScriptImage
+*/
+struct SourceWords
+{
+	///The words themselves.
+	WordBuffer Words;
+	
+	///Keeps track of at what positions newline begin
+	std::vector<ReaderPos> LinePositions;
+	
+	///For every '{' in the buffer, the position of its '}'.  (0 until it is read.)
+	std::vector<ReaderPos> MatchingBracket;
+	
+	///For every position up to the last ';' read, the position of the next ';'.
+	std::vector<ReaderPos> NextTerminal;
+	
+	///For every position up to the last ';' or '{' read, the position of the next one.
+	std::vector<ReaderPos> NextTerminalOrBracket;
+};
+
+///A pointer to a finished SourceWords.
+typedef boost::shared_ptr<const SourceWords> SourceWordsPtr;
+
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
 /**
 	\brief An interface for feeding source into the Interpreter
@@ -76,9 +112,84 @@ public:
 	///Return current position in the stream.
 	ReaderPos GetPos() const;
 	
+	/**
+		\brief Find the '}' matching a '{'.
+		
+		Matches are recorded as the words are read, so this only has to
+		read ahead if the '}' hasn't been reached yet.
+		
+		\param Pos Position of the '{'.
+		\return Position of the matching '}', or of the end of the stream
+			if there isn't one.
+	*/
+	ReaderPos GetMatchingBracket( ReaderPos Pos );
+	
+	/**
+		\brief Find the next ';'.
+		
+		\param Pos Position to start looking at.
+		\return Position of the first ';' at or after Pos, or of the end of
+			the stream if there isn't one.
+	*/
+	ReaderPos GetNextTerminal( ReaderPos Pos );
+	
+	/**
+		\brief Find the next ';' or '{', whichever comes first.
+		
+		\param Pos Position to start looking at.
+		\return Position of the first ';' or '{' at or after Pos, or of the
+			end of the stream if there isn't one.
+	*/
+	ReaderPos GetNextTerminalOrBracket( ReaderPos Pos );
+	
 	///Return the current line number.
 	unsigned long GetLineNumber() const;
 	
+	/**
+		\brief Writes every word read so far, and the line table, to a stream.
+		
+		This is used to save a tokenized source so that it doesn't have
+		to be tokenized again.
+		
+		\param Out The stream to write to.  It should be opened in binary mode.
+		
+		\sa ReadCache
+	*/
+	void WriteCache( std::ostream& Out ) const;
+	
+	/**
+		\brief Restores words written by WriteCache.
+		
+		This should only be called before anything has been read.
+		
+		\param pData The data written by WriteCache.
+		\param Size The size of the data in bytes.
+		\return False if the data is incomplete or corrupt, in which case
+			nothing is restored.
+	*/
+	bool ReadCache( const char* pData, size_t Size );
+	
+	/**
+		\brief Reads the rest of the stream and hands out the words.
+		
+		Afterwards the words never change, even if this source is read
+		past the end, so they can be shared.
+		
+		\sa UseWords
+	*/
+	SourceWordsPtr FinishWords();
+	
+	/**
+		\brief Read from words that have already been finished elsewhere.
+		
+		The source doesn't read any text of its own after this.  Reading
+		past the end just keeps returning the last word.  This should
+		only be called before anything has been read.
+		
+		\param pWords The words, from FinishWords.
+	*/
+	void UseWords( SourceWordsPtr pWords );
+	
 	/**
 		\brief Returns the name of the stream.
 		
@@ -111,6 +222,23 @@ protected:
 		\return The next line in the stream. 
 	*/
 	virtual String GetNextLine() = 0;
+	
+	/**
+		\brief Returns the next line in the stream, without copying it if possible.
+		
+		Sources that already have their text in memory can override this
+		to hand back a pointer straight into it.  The text has to stay put
+		until the ReaderSource is destroyed.  The default implementation
+		calls GetNextLine() and keeps the result in Storage.
+		
+		\param Storage A string the line can be kept in.
+		\param pLine Set to the start of the line.
+		\param Length Set to the length of the line, 0 at the end of the stream.
+	*/
+	virtual void GetNextLine( String& Storage, const Char*& pLine, size_t& Length );
+	
+	///Called when the tokenizer reaches the end of the stream.
+	virtual void EndOfStream() {}
 
 private:
 	/**
@@ -134,13 +262,34 @@ private:
 	///Moves the stream position back one character
 	const void   UnGet();
 	
-	///The buffer containing the current line
+	///Moves on to the next line, or to the one Peek already fetched.
+	void NextLine();
+	
+	///The current line
+	const Char* mpReadLine;
+	///The length of the current line
+	size_t mReadLineLength;
+	///The next line, if Peek had to fetch it.
+	const Char* mpPeekLine;
+	///The length of the next line.
+	size_t mPeekLineLength;
+	///True if Peek has fetched the next line.
+	bool mHavePeekLine;
+	
+	///The buffer containing the current line, if the source needs one.
 	String mReadString;
 	///A buffer that is sometimes needed to hold the next line.
 	String mPeekString;
 	///The position (in characters) into the current line.
 	size_t mReadStringPos;
 	
+	///The number of '['s still waiting for a ']'.
+	unsigned int mBracketCount;
+	///The number of '|'s still waiting for a closing '|'.
+	unsigned int mNameOfBracketCount;
+	///Words that a single character expands to, waiting to be read.
+	std::queue<Word> mQueuedWords;
+	
 	/**
 		\brief Adds a word to the end up the word buffer.
 		
@@ -149,8 +298,14 @@ private:
 	*/		
 	const Word& PushWord( const Word& W );
 	
-	///The buffer representing the word stream.
-	WordBuffer mBuffer;
+	///Reads one more word onto the end of the buffer, without moving the position.
+	void ReadAhead();
+	
+	///The words read so far.
+	SourceWordsPtr mpWords;
+	
+	///The same as mpWords, while this source is still adding to them.  (Null otherwise.)
+	SourceWords* mpOwnWords;
 	
 	///The current position into the word stream
 	size_t mBufferPos;
@@ -161,8 +316,8 @@ private:
 	///Keeps track of the current line
 	mutable unsigned long mCurrentLine;
 	
-	///Keeps track of at what positions newline begin
-	std::vector<ReaderPos> mLinePositions;	
+	///The '{'s still waiting for a '}'.
+	std::vector<ReaderPos> mOpenBrackets;
 };
 
 ///A pointer to a ReaderSource
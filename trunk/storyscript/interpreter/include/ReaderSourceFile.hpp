@@ -4,6 +4,13 @@ Copyright (c) 2004-2005 Daniel Jones (DanielCJones@gmail.com)
 This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.  Full license information is included in the file in the top directory named "license".
 
 NOTES: A specialization of ReaderSource that reads from files.
+		The whole file is mapped into memory (or read in one go when it
+		can't be mapped, like with pipes) and lines are handed to the
+		tokenizer straight out of it.
+
+		If caching is turned on, the words are saved next to the file
+		(in "foo.ssconv.ssc") once it has been read all the way through, and
+		loaded from there the next time as long as the file hasn't changed.
 */
 
 #if !defined(SS_ReaderSourceFile)
@@ -14,6 +21,7 @@ NOTES: A specialization of ReaderSource that reads from files.
 #include "Unicode.hpp"
 
 #include <fstream>
+#include <boost/cstdint.hpp>
 
 namespace SS{
 
@@ -24,7 +32,7 @@ class ReaderSourceFile : public ReaderSource
 {
 public:
 	ReaderSourceFile();
-	ReaderSourceFile( const SS::String& );
+	ReaderSourceFile( const SS::String&, bool UseCache = false );
 	
 	~ReaderSourceFile();
 	
@@ -36,12 +44,44 @@ public:
 	//const SS::String& GetFileName() const;
 	String GetName() const;
 	
+	//Turn the token cache on/off.  Takes effect the next time a file is opened.
+	void SetUseCache( bool Flag = true );
+	bool IsUsingCache() const;
+	
+	//The name of the cache file for the open file.
+	String GetCacheName() const;
+	
 private:
 	SS::String GetNextLine();
+	void GetNextLine( SS::String& Storage, const Char*& pLine, size_t& Length );
+	void EndOfStream();
+	
+	bool MapFile();
+	void ReadFile();
+	bool FindNextLine( const char*& pBegin, const char*& pEnd );
+	
+	void HashFile();
+	bool LoadCache();
+	void SaveCache();
+	
 	SS::String mFileName;
+	bool mIsOpen;
+	
+	bool mUseCache;
+	//True once the cache is known to be up to date.
+	bool mCacheCurrent;
+	
+	//What the cache is keyed on.
+	boost::uint64_t mFileTime;
+	boost::uint64_t mFileHash;
+	
+	//The file's contents, either mapped or in mContents.
+	const char* mpData;
+	size_t mDataSize;
+	size_t mDataPos;
 	
-	IFSTREAM mFile;
-	Char* mpBuffer;
+	void* mpMapping;
+	std::string mContents;
 };
 
 
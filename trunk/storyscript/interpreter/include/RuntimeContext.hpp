@@ -0,0 +1,173 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+/**
+	\file RuntimeContext.hpp
+	\brief Declarations for RuntimeContext and RuntimeContextGuard.
+*/
+
+#if !defined(SS_RuntimeContext)
+#define SS_RuntimeContext
+
+#include "Defines.hpp"
+#include "DLLExport.hpp"
+#include "Mutex.hpp"
+#include "Types.hpp"
+#include "LanguageConstants.hpp"
+#include "NumPool.hpp"
+
+#include <boost/random/mersenne_twister.hpp>
+
+namespace SS{
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief Everything an interpreter would otherwise keep in globals.
+
+	Each Interpreter has its own, so any number of them can run at once as
+	long as each one sticks to a single thread at a time.  Plenty of code
+	(numbers in particular) has no way back to its interpreter, so each
+	thread has a current context that it uses instead.  An Interpreter
+	makes its context current whenever it is called on to do something,
+	and puts the old one back when it's done.
+
+	When a thread has no current context it falls back on a default one
+	shared by the whole process.  That is fine for a program with only one
+	thread, but anything else should use a RuntimeContextGuard (or
+	Interpreter::MakeCurrent) before touching an interpreter's numbers.
+
+	\sa RuntimeContextGuard Interpreter::MakeCurrent
+*/
+class SS_API RuntimeContext
+{
+public:
+	///Constructor
+	RuntimeContext();
+	///Destructor.  Stops being the current context, if it is.
+	~RuntimeContext();
+
+	///Returns the thread's current context, or the default one.
+	static RuntimeContext& Current();
+
+	/**
+		\brief Returns the thread's current context, or the default one.
+
+		Unlike Current, this returns 0 rather than bringing the default
+		context back once it has been destroyed at exit.
+	*/
+	static RuntimeContext* Find();
+
+	/**
+		\brief Make a context current for this thread.
+
+		\param pContext The new current context, or 0 for the default.
+		\return The context that was current before.
+	*/
+	static RuntimeContext* SetCurrent( RuntimeContext* pContext );
+
+	///Returns the language options.
+	LangOpts& GetLangOpts() { return mLangOpts; }
+	///Returns the pool numbers are allocated from.
+	NumPool& GetNumPool() { return mNumPool; }
+	///Returns the random number generator.
+	boost::mt19937& GetRNG() { return mRNG; }
+
+	///Returns how many ScopeObjects have been created while this was current and counting.
+	boost::uint64_t GetObjectsCreated() const { return mObjectsCreated; }
+
+	/**
+		\brief Turns counting ScopeObjects on or off.
+
+		Off by default.  While no context anywhere is counting, creating
+		a ScopeObject doesn't even look for the current context.  The
+		Interpreter turns this on along with profiling.
+	*/
+	void SetCountingObjects( bool flag = true );
+
+	///Returns true if ScopeObjects are being counted.
+	bool IsCountingObjects() const { return mCountingObjects; }
+
+	///Counts a ScopeObject being created, if the current context is counting.
+	static void CountObject()
+	{
+		if( AtomicRead( smCountingContexts ) && smpCurrent && smpCurrent->mCountingObjects ){
+			smpCurrent->mObjectsCreated++;
+		}
+	}
+
+	/**
+		\name Language constants
+		These are registered in each interpreter's SSCommon scope.  They
+		are created the first time they're asked for.
+	*/
+	//@{
+	const VariablePtr& GetNANConst();
+	const VariablePtr& GetInfinityConst();
+	const VariablePtr& GetNegInfinityConst();
+	const VariablePtr& GetNewLineConst();
+	///An unnamed, empty string.
+	const VariablePtr& GetEmptyStringConst();
+	///The empty list that [] evaluates to.
+	const ListPtr& GetEmptyList();
+	//@}
+
+private:
+	RuntimeContext( const RuntimeContext& );
+	RuntimeContext& operator=( const RuntimeContext& );
+
+	///Creates the language constants.
+	void InitConstants();
+
+	LangOpts mLangOpts;
+	NumPool mNumPool;
+	boost::mt19937 mRNG;
+	boost::uint64_t mObjectsCreated;
+	bool mCountingObjects;
+
+	VariablePtr mpNANConst;
+	VariablePtr mpInfinityConst;
+	VariablePtr mpNegInfinityConst;
+	VariablePtr mpNewLineConst;
+	VariablePtr mpEmptyStringConst;
+	ListPtr mpEmptyList;
+
+	///Each thread's current context.
+	static SS_THREAD_LOCAL RuntimeContext* smpCurrent;
+
+	///How many contexts are counting objects.
+	static volatile boost::uint64_t smCountingContexts;
+};
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief Makes a context current for as long as it exists.
+
+	The context that was current before is restored afterwards, so these
+	can be nested (when one interpreter calls into another, say).
+*/
+class RuntimeContextGuard
+{
+public:
+	///Constructor
+	explicit RuntimeContextGuard( RuntimeContext& C )
+		: mpOldContext( RuntimeContext::SetCurrent( &C ) ) {}
+	///Destructor
+	~RuntimeContextGuard() { RuntimeContext::SetCurrent( mpOldContext ); }
+
+private:
+	RuntimeContextGuard( const RuntimeContextGuard& );
+	RuntimeContextGuard& operator=( const RuntimeContextGuard& );
+
+	RuntimeContext* mpOldContext;
+};
+
+
+} //namespace SS
+#endif
@@ -0,0 +1,315 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+/**
+	\file Scheduler.hpp
+	\brief Declarations for Session and Scheduler.
+*/
+
+#if !defined(SS_Scheduler)
+#define SS_Scheduler
+
+#include "Defines.hpp"
+#include "DLLExport.hpp"
+#include "Unicode.hpp"
+#include "Interpreter.hpp"
+#include "ScriptImage.hpp"
+#include "Mutex.hpp"
+
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace SS{
+
+class Scheduler;
+
+
+/**
+	\brief Where a Session is at.
+*/
+enum SessionState
+{
+	SESSION_READY,   ///< Waiting for a worker to run it.
+	SESSION_RUNNING, ///< A worker is running it.
+	SESSION_WAITING, ///< Parked until Scheduler::Resume is called with a choice.
+	SESSION_FINISHED ///< The conversation is over.
+};
+
+
+/**
+	\brief Counters kept for a Session.
+*/
+struct SessionStats
+{
+	SessionStats() : Lines(0), Slices(0), Choices(0) {}
+
+	boost::uint64_t Lines;   ///< Lines said.
+	boost::uint64_t Slices;  ///< Times a worker has run it.
+	boost::uint64_t Choices; ///< Times it has parked for a choice.
+};
+
+
+/**
+	\brief Counters kept for a Scheduler.
+*/
+struct SchedulerStats
+{
+	SchedulerStats() : Lines(0), Slices(0), Steals(0), Finished(0) {}
+
+	boost::uint64_t Lines;    ///< Lines said by all the sessions.
+	boost::uint64_t Slices;   ///< Times any session was run.
+	boost::uint64_t Steals;   ///< Slices a worker took from another's queue.
+	boost::uint64_t Finished; ///< Sessions that have finished.
+};
+
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief One conversation run by a Scheduler.
+
+	A session is an Interpreter and the conversation it is running.  You
+	still have to give the interpreter an Interface (before handing the
+	session to a Scheduler); the easiest way is to derive from Session
+	and make the Interface a member.  Its SayBlock and LogMessage are
+	called on whichever worker is running the session, and its
+	PresentChoice is never called.  Anomalies go to its
+	HandleParserAnomaly, and end the session.  (Anything that handler,
+	OnWaiting or OnFinished throws is dropped, since there is nowhere
+	on a worker for it to go.)
+
+	\sa Scheduler
+*/
+class SS_API Session
+{
+public:
+	/**
+		\brief Constructor
+
+		\param FileName The script to run.
+		\param BlockName The block to start on.  Empty for the first one.
+		\param pImage Where to read the scripts from.  (May be null.)
+	*/
+	Session( const SS::String& FileName, const SS::String& BlockName = SS::String(),
+			 ScriptImagePtr pImage = ScriptImagePtr() );
+
+	///Destructor
+	virtual ~Session();
+
+	///Returns the session's interpreter.
+	Interpreter& GetInterpreter();
+
+	///Returns where the session is at.
+	SessionState GetState() const;
+
+	///Returns the session's counters.
+	SessionStats GetStats() const;
+
+	/**
+		\brief Returns the choices the session is waiting on.
+
+		Only look at these while the session is SESSION_WAITING.
+	*/
+	const BlockList& GetPendingChoices() const;
+
+protected:
+	/**
+		\brief Called when the session parks for a choice.
+
+		This is called on the worker.  The session can be resumed from
+		here (or anywhere else) straight away.
+	*/
+	virtual void OnWaiting();
+
+	///Called on the worker when the session finishes.
+	virtual void OnFinished();
+
+private:
+	Session( const Session& );
+	Session& operator=( const Session& );
+
+	friend class Scheduler;
+
+	/**
+		\brief Say up to MaxLines lines, stopping early once MaxTime is up.
+
+		\param MaxTime Microseconds, or 0 for no limit.
+		\param Lines Set to the number of lines said.
+		\return Where the conversation is at.
+	*/
+	StepState RunSlice( unsigned int MaxLines, boost::uint64_t MaxTime, unsigned int& Lines );
+
+	///Hand an anomaly to the interface, and end the conversation.  Never throws.
+	void Abandon( const ParserAnomaly& E );
+
+	///The interpreter running the conversation.
+	Interpreter mI;
+
+	SS::String mFileName;
+	SS::String mBlockName;
+
+	///True once the file has been opened and the conversation started.
+	bool mStarted;
+
+	///True if mChoice has to be given to the interpreter before going on.
+	bool mHasChoice;
+	///The choice passed to Scheduler::Resume.
+	unsigned int mChoice;
+
+	/**
+		\brief The scheduler running this.  (Its mutex guards the next two.)
+
+		This is only changed with that mutex held, but GetState has to
+		read it first to find the mutex, so it is always read and written
+		with AtomicLoadPointer and AtomicStorePointer.
+	*/
+	Scheduler* mpScheduler;
+	SessionState mState;
+	SessionStats mStats;
+};
+
+///A pointer to a Session.
+typedef boost::shared_ptr<Session> SessionPtr;
+
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief Runs many sessions on a few threads.
+
+	Each worker thread has its own queue of sessions ready to run, and
+	takes from another's queue when its own is empty.  A session is run
+	for a slice of a few lines at a time and then goes to the back of the
+	queue, so a long conversation doesn't hold up the rest.  A session
+	waiting on a choice is parked and takes no thread at all until
+	Resume is called.
+
+	A slice only ends between lines.  To keep one runaway line from
+	holding a worker, give the sessions' interpreters a statement or
+	time budget (see Interpreter::SetStatementBudget).
+
+	\code
+	SS::Scheduler S( 4 );
+	S.Add( SS::SessionPtr( new MySession( "Intro.ssconv" ) ) );
+	//...
+	S.Resume( *pSomeSession, PlayersChoice );
+	\endcode
+
+	\sa Session
+*/
+class SS_API Scheduler
+{
+public:
+	/**
+		\brief Constructor.  Starts the workers, or throws an anomaly if it can't.
+
+		\param WorkerCount How many threads to run sessions on.
+		\param SliceLines How many lines a session may say before
+			letting the next one go.
+		\param SliceTime How many milliseconds a session may run before
+			letting the next one go, or 0 for no limit.
+	*/
+	explicit Scheduler( unsigned int WorkerCount, unsigned int SliceLines = 8,
+						unsigned int SliceTime = 0 );
+
+	/**
+		\brief Destructor.  Stops the workers.
+
+		Each worker finishes the slice it is on.  Sessions that haven't
+		finished are let go of.
+	*/
+	~Scheduler();
+
+	///Start running a session.
+	void Add( SessionPtr pSession );
+
+	/**
+		\brief Make a choice for a waiting session, and start it running again.
+
+		Throws an anomaly if the session isn't waiting, or the choice is
+		out of range.
+
+		\param S The session.
+		\param Choice Index into its GetPendingChoices.
+	*/
+	void Resume( Session& S, unsigned int Choice );
+
+	///Block until every session is either waiting or finished.
+	void Wait();
+
+	///Returns the number of worker threads.
+	size_t GetWorkerCount() const;
+
+	///Returns the scheduler's counters.
+	SchedulerStats GetStats() const;
+
+	friend class Session;
+
+private:
+	Scheduler( const Scheduler& );
+	Scheduler& operator=( const Scheduler& );
+
+	///A worker thread and its queue.
+	struct Worker
+	{
+		Worker( Scheduler& S, size_t Index ) : Owner( S ), Index( Index ), pThread( 0 ) {}
+
+		Scheduler& Owner;
+		size_t Index;
+		Thread* pThread;
+
+		Mutex QueueMutex;
+		std::deque<SessionPtr> Queue;
+	};
+
+	///Tell the workers to stop, wait for them, and free them.
+	void StopWorkers();
+
+	///Where each worker thread starts.  (pWorker is its Worker.)
+	static void WorkerMain( void* pWorker );
+
+	///Put a session on a worker's queue.  It must already be counted in mReady.
+	void Push( SessionPtr pSession, size_t WorkerIndex );
+
+	///Take the next session for a worker, stealing if need be.  Null if there are none.
+	SessionPtr Pop( Worker& W, bool& Stolen );
+
+	///Run one slice of a session and queue or park it.
+	void RunSlice( Worker& W, SessionPtr pSession, bool Stolen );
+
+	std::vector<Worker*> mWorkers;
+	unsigned int mSliceLines;
+	///In microseconds.
+	boost::uint64_t mSliceTime;
+
+	///Guards everything below, and every session's state and counters.
+	mutable Mutex mMutex;
+	///Signalled when a session is queued, or the workers should stop.
+	Condition mWorkReady;
+	///Signalled when nothing is queued or running.
+	Condition mAllIdle;
+
+	///Every session that hasn't finished.
+	std::map< Session*, SessionPtr > mSessions;
+	///Sessions queued on any worker.
+	size_t mReady;
+	///Sessions being run.
+	size_t mRunning;
+	///Where Add and Resume put the next session.
+	size_t mNextWorker;
+	bool mStopping;
+
+	SchedulerStats mStats;
+};
+
+
+} //namespace SS
+#endif
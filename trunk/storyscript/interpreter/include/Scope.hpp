@@ -20,9 +20,17 @@ directory named "license".
 #include "ParserAnomaly.hpp"
 #include "Types.hpp"
 #include "Word.hpp"
+#include "Mutex.hpp"
+
+#include <boost/cstdint.hpp>
 
 
 namespace SS{
+
+class ReaderSource;
+
+///Every scope a lookup searched, in order.  \sa Scope::SetTrail
+typedef std::vector< std::pair<const Scope*, ScopeObjectPtrWeak> > ScopeTrail;
 	
 	
 //~~~~~~~CLASS~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -87,10 +95,25 @@ public:
 		\return A pointer to the object that was un-registered.
 	*/
 	ScopeObjectPtr UnRegister( const SS::String& Name );
+	
+	///Same as the above, but with the name's symbol.
+	ScopeObjectPtr UnRegister( SymbolID Name );
 
 	/// Unregister all object from the scope.
 	void Clear();
 
+	/**
+		\brief Unregister everything but the two given objects.
+
+		Unlike Clear, the objects that are let go of are properly
+		un-registered, so they can be registered somewhere else later.
+		This is used to empty out a scope that is being used over again.
+
+		\param Keep1 The symbol of an object to leave in the scope.
+		\param Keep2 The symbol of another object to leave in the scope.
+	*/
+	void ClearExcept( SymbolID Keep1, SymbolID Keep2 );
+
 	/**
 		\brief Checks if a object exists in the local scope.
 		
@@ -102,6 +125,9 @@ public:
 	*/ 
 	bool Exists( const SS::String& ID );
 	
+	///Same as the above, but with the name's symbol.
+	bool Exists( SymbolID ID );
+	
 	/**
 		\brief Retrieve a named object from the scope.
 		
@@ -113,6 +139,9 @@ public:
 	*/
 	ScopeObjectPtr GetScopeObject( const SS::CompoundString& Name );
 	
+	///Same as the above, but with the name already interned.
+	ScopeObjectPtr GetScopeObject( const SS::CompoundSymbol& Name );
+	
 	/**
 		\brief Retrieve a named object from the scope. (Non-throwing)
 		
@@ -126,7 +155,21 @@ public:
 		\param Name The name of the the object to be retrieved.
 		\return A pointer to the retrieved object.
 	*/
-	virtual ScopeObjectPtr GetScopeObject_NoThrow( const SS::CompoundString& Identifier, unsigned long Level = 0 );
+	ScopeObjectPtr GetScopeObject_NoThrow( const SS::CompoundString& Identifier, unsigned long Level = 0 );
+	
+	/**
+		\brief Retrieve a named object from the scope. (Non-throwing, interned)
+		
+		This is where lookups actually happen.  The string versions just
+		intern the name and call this.
+		
+		\sa SymbolTable
+		
+		\param Identifier The symbols of the name of the object to be retrieved.
+		\param Level Which part of the name to start at.
+		\return A pointer to the retrieved object, or a null pointer.
+	*/
+	virtual ScopeObjectPtr GetScopeObject_NoThrow( const SS::CompoundSymbol& Identifier, unsigned long Level = 0 );
 	
 	/**
 		\brief Retrieve a name from this scope and only this scope.
@@ -142,6 +185,9 @@ public:
 	*/
 	ScopeObjectPtr GetScopeObjectLocal( const SS::String& Name );
 	
+	///Same as the above, but with the name's symbol.
+	ScopeObjectPtr GetScopeObjectLocal( SymbolID Name );
+	
 	
 	/**
 		\brief Retrieve a name from this scope and only this scope.
@@ -158,6 +204,9 @@ public:
 	*/
 	ScopeObjectPtr GetScopeObjectLocal_NoThrow( const SS::String& Name );
 	
+	///Same as the above, but with the name's symbol.
+	ScopeObjectPtr GetScopeObjectLocal_NoThrow( SymbolID Name );
+	
 	/**
 		\brief Import a scope into the current scope.
 		
@@ -185,6 +234,33 @@ public:
 	
 	ScopePtr CastToScope();
 	const ScopePtr CastToScope() const;
+	
+	/**
+		\brief Returns the scope's version.
+		
+		Every time something is registered, un-registered, imported or
+		un-imported the scope gets a new version, newer than any version
+		handed out before.  So if a scope's version is no newer than some
+		earlier GetNewestVersion(), nothing in it has changed since then.
+		
+		\sa ScopeResolution
+	*/
+	boost::uint64_t GetVersion() const { return mVersion; }
+	
+	///Returns the newest version any scope has been given.
+	static boost::uint64_t GetNewestVersion() { return AtomicRead( smNewestVersion ); }
+	
+	/**
+		\brief Start recording the scopes that lookups search.
+		
+		While a trail is set, every scope that is searched by
+		GetScopeObject_NoThrow or GetScopeObjectLocal_NoThrow adds itself
+		to it.
+		
+		\param pTrail The trail to add to, or null to stop recording.
+		\return The trail that was set before.
+	*/
+	static ScopeTrail* SetTrail( ScopeTrail* pTrail );
 
 protected:
 
@@ -203,8 +279,13 @@ protected:
 		encouraged to override it in your class.  Please remember to
 		call the parents version when you version is done, or your
 		dog will get hit by a truck.
+		
+		The name is passed as a symbol, so compare it with interned
+		constants rather than strings.  Intern them at startup (as
+		file-scope statics, say), since lookups by string only find
+		names that have been interned already.
 	*/
-	virtual ScopeObjectPtr GetScopeObjectHook( const String& );
+	virtual ScopeObjectPtr GetScopeObjectHook( SymbolID );
 
 
 private:
@@ -228,6 +309,12 @@ private:
 		\return A reference to the global scope.
 	*/ 
 	Scope& GetGlobalScope();
+	
+	///Gives the scope a new version.  \sa GetVersion
+	void Touch() { mVersion = AtomicIncrement( smNewestVersion ); }
+	
+	///Adds this scope to the trail, if one is being recorded.
+	void LeaveTrail() { if( smpTrail ) smpTrail->push_back( std::make_pair( this, ScopeObjectPtrWeak( this ) ) ); }
 		
 	/// The internal list of registered objects.
 	ScopeListType mList;
@@ -238,6 +325,69 @@ private:
 	bool mNameCreated; ///< Flag marking whether the name variable has been created yet.
 	bool mFullNameCreated; ///< Flag marking whether the fullname (magic) variable has been created yet.
 	bool mDocStringCreated; ///< Flag marking whether the doc string variable has been created yet.
+	
+	///The scope's version.  \sa GetVersion
+	boost::uint64_t mVersion;
+	
+	///The newest version handed out.  (Shared by every thread, so versions never repeat.)
+	static volatile boost::uint64_t smNewestVersion;
+	
+	///The trail being recorded on this thread, if any.  \sa SetTrail
+	static SS_THREAD_LOCAL ScopeTrail* smpTrail;
+};
+
+
+//~~~~~~~CLASS~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+/**
+	\brief A remembered identifier lookup.
+	
+	Expressions keep one of these for every identifier they contain, so the
+	interpreter doesn't have to search the whole scope hierarchy every time
+	they are evaluated.  It stays good as long as the lookup starts from the
+	same place and none of the scopes it searched has changed.
+	
+	\sa Interpreter::GetScopeObject Scope::GetVersion
+*/
+struct SS_API ScopeResolution
+{
+	///Constructor
+	ScopeResolution();
+	
+	/**
+		\brief Checks if the lookup would still find the same thing.
+		
+		\param pScope The scope the lookup starts from.
+		\param pStaticScope The static scope the lookup falls back on.
+		\param pSource The source whose file scope is searched last.
+		\return True if Result can be used.
+	*/
+	bool IsCurrent( const Scope* pScope, const Scope* pStaticScope, const ReaderSource* pSource );
+	
+	///Forget the lookup.
+	void Reset();
+	
+	///False until a lookup has been remembered.
+	bool Valid;
+	
+	///Where the lookup started.
+	const Scope* pScope;
+	///Where the lookup fell back to.
+	const Scope* pStaticScope;
+	///Whose file scope the lookup checked last.
+	const ReaderSource* pSource;
+	///Used to make sure the starting scopes weren't replaced by others at the same address.
+	ScopePtrWeak pScopeWeak, pStaticScopeWeak;
+	
+	///The newest scope version at the time the lookup was made (or last checked).
+	boost::uint64_t Version;
+	
+	///Every scope the lookup searched.
+	ScopeTrail Trail;
+	
+	///What was found, or nothing if the lookup failed.
+	ScopeObjectPtrWeak Result;
+	///True if the lookup found something.
+	bool Found;
 };
 
 
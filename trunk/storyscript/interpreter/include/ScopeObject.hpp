@@ -113,26 +113,41 @@ extern SS_API const String UNNAMMED;
 	an entirely new object.  This leads to the problem of knowing whether
 	or not an object returned needs to be deleted or not.
 	
-	The most convenient solution, the one that is used, is using reference
-	counted pointers (boost::shared_ptr's).  This solution requires objects
-	maintain a shared_ptr to itself, for when it simply casts itself.
-	However this isn't possible without	a two-stage construction.  First
-	the object is created, and then the 	it's shared_ptr is set 
-	(using ScopeObject::SetSharedPtr).
-	
-	The user doesn't have to worry about this as long as she uses the creation
-	functions (CreateGeneric, CreateVariable, CreateBlock, etc. ).  In fact, most
-	of the standard objects _must_ be created with these functions; their constructors
-	are private.
-	
-	If one makes a derived object and doesn't sets the shared_ptr, it will work fine
-	unless the object tries to cast itself, in which case it will throw an anomaly.
-	
-	\sa ScopeObject::SetSharedPtr ScopeObject::CastToScopeObject ScopeObject::CastToScope
+	The solution is reference counting.  Every ScopeObject keeps its own
+	count (see intrusive_ptr_add_ref), and ScopeObjectPtr and friends are
+	boost::intrusive_ptr's.  So an object can hand out a pointer to itself
+	at any time, and casting itself is just a matter of checking its type
+	tag (see ScopeObject::GetType).
+	
+	Objects must still be created on the heap, and owned by a pointer from
+	the start.  The creation functions (CreateGeneric, CreateVariable,
+	CreateBlock, etc.) take care of that, and most of the standard objects
+	_must_ be created with them; their constructors are private.
+	
+	If an object nobody has a pointer to tries to cast itself, it will throw
+	an anomaly.
+	
+	\sa ScopeObject::CastToScopeObject ScopeObject::CastToScope
 	\sa ScopeObject::CastToBlock ScopeObject::CastToList ScopeObject::CastToOperator
 */
 
 
+/**
+	\brief Keeps track of whether a ScopeObject still exists.
+	
+	Shared by an object and every WeakPtr to it.  It is only created
+	once the first WeakPtr is.
+*/
+struct WeakFlag
+{
+	WeakFlag() : Refs( 1 ), Alive( true ) {}
+	
+	///The object, plus every WeakPtr.
+	long Refs;
+	///Cleared when the object is destroyed.
+	bool Alive;
+};
+
 
 
 
@@ -161,11 +176,32 @@ protected:
 		
 	*/
 	ScopeObject( const SS::String& Name = SS::String(), bool Const = false );
+	
+	/**
+		\brief Copy constructor.
+		
+		Copies everything but the reference count.
+	*/
+	ScopeObject( const ScopeObject& );
+	
+	///Assignment.  Leaves the reference count and type alone.
+	ScopeObject& operator=( const ScopeObject& );
 
 public:
 	/// Destructor
 	virtual ~ScopeObject();
 	
+	/**
+		\brief Returns what kind of object this is.
+		
+		This is the same thing a TypeCheckVisitor would find, but without
+		visiting anything.
+	*/
+	ScopeObjectType GetType() const { return mType; }
+	
+	///Returns the number of pointers to the object.
+	long GetRefCount() const { return mRefCount; }
+	
 	
 	/**
 		\brief Used to accept visitor derivatives.
@@ -253,19 +289,6 @@ public:
 	*/
 	SS::Char* GetFullName( SS::Char* Buffer, unsigned int BufferSize ) const;
 
-	/**
-		\brief Set the internal shared_ptr of itself.
-		
-		Read about 
-		\ref SelfCasting "Self-Casting Kung-Fu" 
-		if this sounds confusing.
-		
-		 \param This A boost::shared_ptr holding a copy of this object.  If you try to
-		 give it some other shared_ptr the four horemen of the Apocalypse will appear
-		 marking the end times.
-	*/
-	void SetSharedPtr( const ScopeObjectPtr& This );
-
 	/**
 		\brief Un-register the object from its scope.
 		
@@ -312,6 +335,10 @@ public:
 
 	/// To allow easy and safe scope registering.
 	friend class Scope;
+	
+	friend void intrusive_ptr_add_ref( const ScopeObject* );
+	friend void intrusive_ptr_release( const ScopeObject* );
+	template <typename T> friend class WeakPtr;
 
 protected:
 	/**
@@ -325,7 +352,7 @@ protected:
 	/**
 		\brief Throws an anomaly if the object cannot be cast.
 		
-		Usually this mean, that the internal shared_ptr hasn't been set. 
+		This means nothing has a pointer to it, so it can't hand one out.
 		
 		Read about 
 		\ref SelfCasting "Self-Casting Kung-Fu" 
@@ -337,11 +364,12 @@ protected:
 	SS::String mName;
 	
 	/**
-		\brief This internal this shared_ptr.
+		\brief What kind of object this is.
 		
-		See \ref SelfCasting "Self-Casting Kung-Fu".
+		Each class that a TypeCheckVisitor can tell apart sets this in its
+		constructor.
 	*/
-	ScopeObjectPtrWeak mpThis;
+	ScopeObjectType mType;
 	
 	/// The constant flag.
 	bool mConst;
@@ -360,6 +388,134 @@ private:
 	
 	/// A pointer the objects parent.  (NULL if unregistered)
 	Scope* mpParent;
+	
+	/// The symbol the object is registered under in its parent.
+	SymbolID mRegisteredSymbol;
+	
+	/**
+		\brief The number of pointers to the object.
+		
+		This isn't atomic.  Like everything else, objects belong to one
+		interpreter and are only used by one thread at a time.
+	*/
+	mutable long mRefCount;
+	
+	/// Created when the first WeakPtr to the object is.  (NULL until then)
+	mutable WeakFlag* mpWeakFlag;
+};
+
+
+/**
+	\brief Adds a reference to a ScopeObject.  (For boost::intrusive_ptr.)
+*/
+inline void intrusive_ptr_add_ref( const ScopeObject* pObj )
+{
+	++pObj->mRefCount;
+}
+
+/**
+	\brief Removes a reference to a ScopeObject, and deletes it if it was the last.
+	(For boost::intrusive_ptr.)
+*/
+inline void intrusive_ptr_release( const ScopeObject* pObj )
+{
+	if( --pObj->mRefCount == 0 ) delete pObj;
+}
+
+
+/**
+	\brief Returns the type of a ScopeObject.
+	
+	\sa ScopeObject::GetType
+*/
+inline ScopeObjectType GetScopeObjectType( const ScopeObjectPtr& pSO )
+{
+	return pSO->GetType();
+}
+
+
+
+//~~~~~~~CLASS~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+/**
+	\brief A pointer to a ScopeObject that doesn't keep it alive.
+	
+	Use lock to get a real pointer, which will be null if the object has
+	since been destroyed.
+*/
+template <typename T>
+class WeakPtr
+{
+public:
+	///Constructor
+	WeakPtr() : mpObj( 0 ), mpFlag( 0 ) {}
+	
+	///Constructor
+	WeakPtr( T* pObj ) : mpObj( 0 ), mpFlag( 0 ) { Set( pObj ); }
+	
+	///Constructor
+	template <typename U>
+	WeakPtr( const boost::intrusive_ptr<U>& pObj ) : mpObj( 0 ), mpFlag( 0 ) { Set( pObj.get() ); }
+	
+	///Copy constructor
+	WeakPtr( const WeakPtr& W ) : mpObj( W.mpObj ), mpFlag( W.mpFlag )
+	{
+		if( mpFlag ) mpFlag->Refs++;
+	}
+	
+	///Destructor
+	~WeakPtr() { reset(); }
+	
+	///Assignment
+	WeakPtr& operator=( const WeakPtr& W )
+	{
+		if( W.mpFlag ) W.mpFlag->Refs++;
+		reset();
+		mpObj = W.mpObj;
+		mpFlag = W.mpFlag;
+		return *this;
+	}
+	
+	///Assignment
+	template <typename U>
+	WeakPtr& operator=( const boost::intrusive_ptr<U>& pObj )
+	{
+		reset();
+		Set( pObj.get() );
+		return *this;
+	}
+	
+	///True if the object is gone, or there never was one.
+	bool expired() const { return !mpFlag || !mpFlag->Alive; }
+	
+	///Returns a pointer to the object, or null if it's gone.
+	boost::intrusive_ptr<T> lock() const
+	{
+		return expired() ? boost::intrusive_ptr<T>() : boost::intrusive_ptr<T>( mpObj );
+	}
+	
+	///Forget the object.
+	void reset()
+	{
+		if( mpFlag && --mpFlag->Refs == 0 ) delete mpFlag;
+		mpObj = 0;
+		mpFlag = 0;
+	}
+	
+private:
+	void Set( T* pObj )
+	{
+		if( !pObj ) return;
+		
+		const ScopeObject* pBase = pObj;
+		if( !pBase->mpWeakFlag ) pBase->mpWeakFlag = new WeakFlag;
+		
+		mpObj = pObj;
+		mpFlag = pBase->mpWeakFlag;
+		mpFlag->Refs++;
+	}
+	
+	T* mpObj;
+	WeakFlag* mpFlag;
 };
 
 
@@ -69,8 +69,6 @@ private:
 };
 
 
-ScopeObjectType GetScopeObjectType( ScopeObjectPtr );
-
 
 }
 #endif
@@ -0,0 +1,90 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+/**
+	\file ScriptImage.hpp
+	\brief Declarations for ScriptImage.
+*/
+
+#if !defined(SS_ScriptImage)
+#define SS_ScriptImage
+
+#include "Defines.hpp"
+#include "DLLExport.hpp"
+#include "Unicode.hpp"
+#include "ReaderSource.hpp"
+
+#include <map>
+
+namespace SS{
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief A set of scripts, read once and shared by many interpreters.
+
+	Every file added is read and tokenized right away, and its words and
+	jump tables are kept.  An Interpreter given the image (see
+	Interpreter::SetScriptImage) reads those instead of loading the file
+	again.  So a thousand conversations over the same scripts only read
+	and tokenize them once, and only keep one copy of the words.
+
+	Build the image on one thread, then hand it out.  After that it never
+	changes, and any number of interpreters on any number of threads can
+	use it at once.  Everything a script does to its variables and blocks
+	is still kept by each interpreter.
+
+	\sa Interpreter::SetScriptImage SourceWords
+*/
+class SS_API ScriptImage
+{
+public:
+	///Constructor
+	ScriptImage();
+
+	/**
+		\brief Read a file into the image.
+
+		\param FileName The file, named as the scripts name it.
+		\param UseCache True to use the file's token cache.  (See ReaderSourceFile.)
+	*/
+	void AddFile( const SS::String& FileName, bool UseCache = false );
+
+	/**
+		\brief Read the rest of a source into the image.
+
+		It is kept under the source's name.
+	*/
+	void AddSource( ReaderSource& Source );
+
+	///Returns true if the file is in the image.
+	bool HasFile( const SS::String& FileName ) const;
+
+	/**
+		\brief Make a new source that reads a file from the image.
+
+		\return The source, or null if the file isn't in the image.
+	*/
+	ReaderSourcePtr OpenSource( const SS::String& FileName ) const;
+
+	///Returns the number of files in the image.
+	size_t size() const;
+
+private:
+	typedef std::map< SS::String, SourceWordsPtr > FileMap;
+
+	///The words of each file, by name.
+	FileMap mFiles;
+};
+
+///A pointer to a ScriptImage that is done being built.
+typedef boost::shared_ptr<const ScriptImage> ScriptImagePtr;
+
+
+} //namespace SS
+#endif
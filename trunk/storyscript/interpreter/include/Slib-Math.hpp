@@ -141,6 +141,9 @@ protected:
 	
 	mutable NumType mBufferValue;
 	
+	///Whether mBufferValue has been generated yet.
+	mutable bool mGenerated;
+	
 };
 
 /*
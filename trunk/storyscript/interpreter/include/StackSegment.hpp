@@ -0,0 +1,92 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+/**
+	\file StackSegment.hpp
+	\brief Declarations for StackSegment.
+*/
+
+#if !defined(SS_StackSegment)
+#define SS_StackSegment
+
+#include "Defines.hpp"
+#include "DLLExport.hpp"
+
+#include <cstddef>
+
+namespace SS{
+
+class ParserAnomaly;
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief A piece of native stack, allocated on the heap, to run a function on.
+
+	A script that calls blocks from blocks from blocks uses up a good bit of
+	the C++ stack on each call, and deep enough recursion would crash the
+	thread.  So when the Interpreter sees the stack getting deep it carries on
+	in one of these, and comes back to the old stack when the block returns.
+
+	Only one function can be running on a segment at a time.  Any anomaly it
+	throws is caught on the segment and thrown again from Run.
+
+	Below each segment is a guard page that can't be touched, so a function
+	that uses more stack than it was given crashes cleanly rather than
+	scribbling over whatever is next to the segment.
+
+	\sa Interpreter::RunBlock
+*/
+class SS_API StackSegment
+{
+public:
+	///What is run on the segment.
+	typedef void (*Function)( void* pArg );
+
+	///Constructor.  Size is in bytes.
+	explicit StackSegment( size_t Size );
+	///Destructor
+	~StackSegment();
+
+	///Run F( pArg ) on this segment, and return when it does.
+	void Run( Function F, void* pArg );
+
+private:
+	StackSegment( const StackSegment& );
+	StackSegment& operator=( const StackSegment& );
+
+	///Runs the function, and catches whatever it throws.
+	static void Enter( StackSegment& S );
+
+#if defined(PLAT_WIN32)
+	///Where a segment's fiber starts.
+	static void __stdcall StartFiber( void* pSegment );
+#else
+	///Where a segment's context starts.
+	static void StartContext();
+#endif
+
+	///The memory for the stack.  (Not counting the guard page.)
+	char* mpStack;
+	size_t mSize;
+	///The size of the guard page below mpStack.
+	size_t mGuardSize;
+
+	///The platform's contexts (or fibers).
+	void* mpHandle;
+
+	Function mFunction;
+	void* mpArg;
+
+	///The anomaly thrown by the function, if any.
+	ParserAnomaly* mpError;
+};
+
+
+} //namespace SS
+#endif
@@ -11,6 +11,7 @@ NOTES: Global include file, so external projects don't have to include a dozen d
 
 #include "Interpreter.hpp"
 #include "Interface.hpp"
+#include "Scheduler.hpp"
 //Whatever else...
 
 
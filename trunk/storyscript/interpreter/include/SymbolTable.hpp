@@ -0,0 +1,168 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+/**
+	\file SymbolTable.hpp
+	\brief Declarations for SymbolTable.
+*/
+
+#if !defined(SS_SymbolTable)
+#define SS_SymbolTable
+
+#include "Defines.hpp"
+#include "Unicode.hpp"
+#include "Mutex.hpp"
+
+#include <vector>
+#include <deque>
+
+namespace SS{
+
+///A small integer standing in for an interned identifier.
+typedef unsigned int SymbolID;
+
+///The symbol of the empty string.  (It is always interned first.)
+const SymbolID NULL_SYMBOL = 0;
+
+///The symbols of a complex identifier (foo:bar), one per part.
+typedef std::vector<SymbolID> CompoundSymbol;
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief A pool of identifier strings.
+
+	Every identifier is interned here once, so that scopes and words can
+	pass around and compare SymbolIDs instead of strings.  The same string
+	always gets the same symbol, and symbols are never released.
+
+	There is only one table for the whole process, since symbols get
+	stored in statics all over the place, and in words that a ScriptImage
+	shares between interpreters.  Identifiers are interned as they are
+	tokenized, so once a script is loaded nearly every call only reads,
+	and reads don't lock.  Only adding a new symbol does.
+
+	Looking something up by a string should use Find, not Intern, so names
+	that scripts make up as they run don't pile up in here.
+
+	\sa Scope Word
+*/
+class SS_API SymbolTable
+{
+public:
+	///Returns the one and only instance.
+	static SymbolTable& Instance();
+
+	/**
+		\brief Get the symbol for a string, adding it if it isn't there yet.
+
+		\param S The string to be interned.
+		\return The string's symbol.
+	*/
+	SymbolID Intern( const SS::String& S );
+
+	/**
+		\brief Intern every part of a complex identifier.
+
+		\param CS The identifier.
+		\param Out Filled with a symbol for each part.
+	*/
+	void Intern( const std::vector<SS::String>& CS, CompoundSymbol& Out );
+
+	/**
+		\brief Get the symbol for a string, without adding it.
+
+		Nothing can be named by a string that was never interned, so a
+		lookup that fails here can stop.
+
+		\param S The string to look for.
+		\param Symbol Set to the string's symbol, if it has one.
+		\return False if the string has never been interned.
+	*/
+	bool Find( const SS::String& S, SymbolID& Symbol ) const;
+
+	///Find every part of a complex identifier.  False if any part is missing.
+	bool Find( const std::vector<SS::String>& CS, CompoundSymbol& Out ) const;
+
+	/**
+		\brief Get the string a symbol stands for.
+
+		The reference stays valid for as long as the program runs.
+	*/
+	const SS::String& GetString( SymbolID Symbol ) const;
+
+	///Returns the number of symbols interned so far.
+	size_t size() const;
+
+private:
+	///Constructor
+	SymbolTable();
+	///Destructor
+	~SymbolTable();
+
+	SymbolTable( const SymbolTable& );
+	SymbolTable& operator=( const SymbolTable& );
+
+	///One string in a hash index.  Never changed once it has been linked in.
+	struct Entry
+	{
+		const SS::String* pString;
+		SymbolID Symbol;
+		Entry* pNext;
+	};
+
+	/**
+		\brief A hash index of every symbol.
+
+		When it gets full a bigger one replaces it, but the old one is kept,
+		since another thread may still be reading it.
+	*/
+	struct Index
+	{
+		explicit Index( size_t BucketCount ) : Buckets( BucketCount, (Entry*)0 ) {}
+
+		///Heads of the hash chains.  (The count is a power of two.)
+		std::vector<Entry*> Buckets;
+		///The entries themselves.  (A deque so they never move.)
+		std::deque<Entry> Entries;
+	};
+
+	///Add a string that isn't in the table yet.  mMutex must be held.
+	SymbolID Add( const SS::String& S );
+
+	///Link a symbol into an index.  mMutex must be held.
+	void Link( Index& I, SymbolID Symbol );
+
+	///Strings are kept in chunks of this many, which never move.
+	static const unsigned int ChunkBits = 12;
+	static const unsigned int ChunkSize = 1 << ChunkBits;
+	static const unsigned int MaxChunks = 4096;
+
+	///The strings, indexed by symbol.
+	SS::String* mpChunks[MaxChunks];
+	///How many symbols there are.  (Guarded by mMutex.)
+	size_t mCount;
+
+	///The index in use.
+	Index* mpIndex;
+	///Indexes that have been outgrown.  (Guarded by mMutex.)
+	std::vector<Index*> mOldIndexes;
+
+	///Guards adding symbols.
+	mutable Mutex mMutex;
+};
+
+
+///Shorthand for SymbolTable::Instance().Intern()
+inline SymbolID Intern( const SS::String& S ){
+	return SymbolTable::Instance().Intern( S );
+}
+
+
+} //namespace SS
+#endif
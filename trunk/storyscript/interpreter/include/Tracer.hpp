@@ -0,0 +1,141 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+/**
+	\file Tracer.hpp
+	\brief Declarations for Tracer and TraceSpan.
+*/
+
+#if !defined(SS_Tracer)
+#define SS_Tracer
+
+#include "Defines.hpp"
+#include "DLLExport.hpp"
+#include "Unicode.hpp"
+
+#include <boost/cstdint.hpp>
+#include <ostream>
+#include <vector>
+
+namespace SS{
+
+
+///Trace categories.  These are what a viewer lets you filter by.
+extern const char* const TRACE_LOAD;
+extern const char* const TRACE_BLOCK;
+extern const char* const TRACE_EXPRESSION;
+extern const char* const TRACE_CHOICE;
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief Records a timeline of what the Interpreter did.
+
+	Spans are opened with Begin and closed with End, and nest the way
+	the calls they time do.  Write puts them out as Chrome trace-event
+	JSON, which chrome://tracing and Perfetto (ui.perfetto.dev) can
+	show.  Times are wall-clock microseconds since the Tracer was made
+	or last cleared.
+
+	Every event is kept until Clear, so a long conversation makes for
+	a big trace.
+
+	\sa Interpreter::SetTracing
+*/
+class SS_API Tracer
+{
+public:
+	///Constructor
+	Tracer();
+
+	/**
+		\brief Opens a span.
+
+		\param Category One of the TRACE_ categories.
+		\param Name What is being done.
+		\param File The script file it is being done to, if any.
+		\param Line The line in File, if it is known.
+	*/
+	void Begin( const char* Category, const SS::String& Name,
+				const SS::String& File = SS::String(), unsigned long Line = 0 );
+
+	///Closes the span Begin last opened.
+	void End();
+
+	///Records a span that is already over.  Start is from GetTime.
+	void Complete( const char* Category, const SS::String& Name, boost::uint64_t Start );
+
+	///Records something that takes no time.
+	void Instant( const char* Category, const SS::String& Name );
+
+	///Returns the time, the way the trace measures it.
+	boost::uint64_t GetTime() const;
+
+	///Forget everything, and start the clock over.
+	void Clear();
+
+	///Returns how many events have been recorded.
+	size_t GetEventCount() const;
+
+	///Writes the trace as JSON.
+	void Write( std::ostream& Out ) const;
+
+private:
+	Tracer( const Tracer& );
+	Tracer& operator=( const Tracer& );
+
+	///One trace event.
+	struct Event
+	{
+		///'B', 'E', 'X' or 'i', as the format has it.
+		char Phase;
+		const char* Category;
+		SS::String Name;
+		SS::String File;
+		unsigned long Line;
+		boost::uint64_t Time;
+		///Only for 'X'.
+		boost::uint64_t Duration;
+	};
+
+	Event& AddEvent( char Phase, const char* Category, const SS::String& Name );
+
+	std::vector< Event > mEvents;
+	boost::uint64_t mStartTime;
+};
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/**
+	\brief Closes a Tracer's span when it goes out of scope.
+
+	Open the span first, then make one of these, so the span is closed
+	even if an anomaly gets thrown.  Tracing is usually off, and then
+	the pointer is null and neither does anything:
+	\code
+	Tracer* pTracer = GetActiveTracer();
+	if( pTracer ) pTracer->Begin( TRACE_LOAD, TXT("Parse"), FileName );
+	TraceSpan Span( pTracer );
+	\endcode
+*/
+class TraceSpan
+{
+public:
+	TraceSpan( Tracer* pTracer ) : mpTracer( pTracer ) {}
+	~TraceSpan(){ if( mpTracer ) mpTracer->End(); }
+
+private:
+	TraceSpan( const TraceSpan& );
+	TraceSpan& operator=( const TraceSpan& );
+
+	Tracer* mpTracer;
+};
+
+
+} //namespace SS
+#endif
@@ -19,10 +19,12 @@ directory named "license".
 
 #include "Defines.hpp"
 #include <boost/shared_ptr.hpp>
-#include <boost/weak_ptr.hpp>
+#include <boost/intrusive_ptr.hpp>
+#include <boost/cstdint.hpp>
 #include <mpfr.h>
 #include <vector>
 #include "Unicode.hpp"
+#include "SymbolTable.hpp"
 
 
 /**
@@ -86,6 +88,25 @@ namespace SS{
 
 
 //This way I don't have to worry about init/cleanup
+/**
+	\brief Storyscript's number type.
+	
+	Most numbers in a script are small whole numbers (loop counters, list
+	indices, and so on), so those are held inline as an integer and the
+	mpfr_t isn't even initialized until something needs it.  Whole numbers
+	that outgrow that are held exactly in an mpz_t.  Anything else
+	(fractions, NaN, -0, and whatever is written through get) is held in
+	the mpfr_t as usual.
+	
+	Only integers smaller than 2^53 are held inline, so the inline form
+	never holds a value the mpfr_t couldn't hold exactly.  Neither integer
+	form is used in numbers with less precision than that.  The arithmetic
+	functions below use them when the result is a whole number, and fall
+	back on mpfr otherwise.  Converting an mpz_t to an mpfr_t rounds it to
+	the number's precision.
+	
+	The mpfr_t and mpz_t are taken from NumPool and given back to it.
+*/
 class mpfr_t_wrap
 {
 public:
@@ -95,16 +116,134 @@ public:
 	mpfr_t_wrap& operator=( const mpfr_t_wrap& );
 	~mpfr_t_wrap();
 
+	/**
+		\brief Returns the mpfr_t, for reading or writing.
+		
+		This gives up the integer forms, since whatever is done to the
+		mpfr_t can't be tracked.  Use read when only reading.
+	*/
 	mpfr_t& get() const;
 	
+	///Returns the mpfr_t for reading only.  The integer forms are kept.
+	mpfr_srcptr read() const;
+	
 	mpfr_t_wrap& set( int );
 	mpfr_t_wrap& set( signed long );
 	mpfr_t_wrap& set( unsigned long );
 	mpfr_t_wrap& set( double );
 	
+	///Sets the value to NaN.
+	mpfr_t_wrap& set_nan();
+	
+	///Sets the precision, which also sets the value to NaN.  (Like mpfr_set_prec.)
+	void set_prec( mpfr_prec_t Prec );
+	///Returns the precision.
+	mpfr_prec_t get_prec() const;
+	
+	///Switches to the inline integer, if the value allows it.
+	void compact();
+	
+	/**
+		\brief Sets the value to a whole number written in a string.
+		
+		\param Str The number, as mpz_set_str takes it.
+		\param Base The base it is written in.
+		\return False, and nothing is changed, if Str isn't a whole number
+			or this doesn't have enough precision to hold one.
+	*/
+	bool set_integer( const char* Str, int Base );
+	
+	///Returns true if the value is held inline as an integer.
+	bool is_small() const { return mIsSmall; }
+	///Returns the inline integer.  (is_small must be true.)
+	boost::int64_t get_small() const { return mSmall; }
+	
+	///Returns true if the value is held in the mpz_t.
+	bool is_big() const { return mIsBig; }
+	///Returns the mpz_t.  (is_big must be true.)
+	mpz_srcptr get_big() const { return Z; }
+	
+	bool nan_p() const;
+	bool equal_p( const mpfr_t_wrap& X ) const;
+	bool less_p( const mpfr_t_wrap& X ) const;
+	bool lessequal_p( const mpfr_t_wrap& X ) const;
+	bool greater_p( const mpfr_t_wrap& X ) const;
+	bool greaterequal_p( const mpfr_t_wrap& X ) const;
+	
+	/**
+		\brief Compares two numbers.  (Neither can be NaN.)
+		
+		\return A negative number, zero, or a positive number if this is
+			less than, equal to, or greater than X.
+	*/
+	int cmp( const mpfr_t_wrap& X ) const;
+	
+	///Sets this to A + B, with the current rounding mode.
+	mpfr_t_wrap& add( const mpfr_t_wrap& A, const mpfr_t_wrap& B );
+	///Sets this to A - B, with the current rounding mode.
+	mpfr_t_wrap& sub( const mpfr_t_wrap& A, const mpfr_t_wrap& B );
+	///Sets this to A * B, with the current rounding mode.
+	mpfr_t_wrap& mul( const mpfr_t_wrap& A, const mpfr_t_wrap& B );
+	///Sets this to A / B, with the current rounding mode.
+	mpfr_t_wrap& div( const mpfr_t_wrap& A, const mpfr_t_wrap& B );
+	///Sets this to A ** B, with the current rounding mode.
+	mpfr_t_wrap& pow( const mpfr_t_wrap& A, const mpfr_t_wrap& B );
+	///Sets this to -A, with the current rounding mode.
+	mpfr_t_wrap& neg( const mpfr_t_wrap& A );
 	
 private:
+	///Sets the inline integer, if it fits.  Returns false if it doesn't.
+	bool SetSmall( boost::int64_t X );
+	
+	/**
+		\brief Performs integer arithmetic in the mpz_t.
+		
+		\param Op Does the arithmetic, or returns false if it can't.
+		\param A The left operand.  (Must be an integer form.)
+		\param B The right operand.  (Must be an integer form.)
+		\return False if Op fails, or there isn't enough precision to hold the result.
+	*/
+	bool BigOp( bool (*Op)( mpz_ptr, mpz_srcptr, mpz_srcptr ),
+				const mpfr_t_wrap& A, const mpfr_t_wrap& B );
+	
+	///Switches from the mpz_t to the inline integer, if the value fits.
+	void ShrinkBig();
+	
+	///Makes sure the mpz_t is initialized.
+	void InitBig();
+	
+	///Puts an integer form's value into Out.
+	void GetInteger( mpz_ptr Out ) const;
+	
+	///Returns true if the value is held in either integer form.
+	bool IsInteger() const { return mIsSmall || mIsBig; }
+	///Returns the sign of an integer form's value.
+	int IntegerSign() const;
+	///Compares two integer forms, like cmp.
+	int IntegerCmp( const mpfr_t_wrap& X ) const;
+	
+	///Makes sure the mpfr_t is initialized and holds the value.
+	void Sync() const;
+	
 	mutable mpfr_t N;
+	///The value, when it is a big integer.
+	mpz_t Z;
+	
+	///The precision to initialize N with (0 for mpfr's default), until it is.
+	mpfr_prec_t mPrec;
+	///The inline integer.
+	boost::int64_t mSmall;
+	
+	///True if N has been initialized.  If not (and the value isn't an integer) the value is NaN.
+	mutable bool mInitialized;
+	///True if Z has been initialized.
+	bool mBigInitialized;
+	///True if the value is the inline integer.
+	mutable bool mIsSmall;
+	///True if the value is in Z.
+	mutable bool mIsBig;
+	///True if N also holds the integer.
+	mutable bool mSynced;
 };
 
 typedef mpfr_t_wrap NumType; ///< Internal representation of storyscript's number type.
@@ -136,20 +275,23 @@ enum VarType
 
 
 
-typedef boost::shared_ptr<ScopeObject>  ScopeObjectPtr;
-typedef boost::shared_ptr<Scope>        ScopePtr;
-typedef boost::shared_ptr<Variable>     VariablePtr;
-typedef boost::shared_ptr<Block>        BlockPtr;
-typedef boost::shared_ptr<VariableBase> VariableBasePtr;
-typedef boost::shared_ptr<List>         ListPtr;
-typedef boost::shared_ptr<Operator>		OperatorPtr;
+template <typename T> class WeakPtr;
 
-typedef boost::weak_ptr<ScopeObject>  ScopeObjectPtrWeak;
-typedef boost::weak_ptr<Scope>        ScopePtrWeak;
-typedef boost::weak_ptr<Variable>     VariablePtrWeak;
-typedef boost::weak_ptr<Block>        BlockPtrWeak;
-typedef boost::weak_ptr<VariableBase> VariableBasePtrWeak;
-typedef boost::weak_ptr<List>         ListPtrWeak;
+//ScopeObjects keep their own reference counts.  \sa ScopeObject
+typedef boost::intrusive_ptr<ScopeObject>  ScopeObjectPtr;
+typedef boost::intrusive_ptr<Scope>        ScopePtr;
+typedef boost::intrusive_ptr<Variable>     VariablePtr;
+typedef boost::intrusive_ptr<Block>        BlockPtr;
+typedef boost::intrusive_ptr<VariableBase> VariableBasePtr;
+typedef boost::intrusive_ptr<List>         ListPtr;
+typedef boost::intrusive_ptr<Operator>		OperatorPtr;
+
+typedef WeakPtr<ScopeObject>  ScopeObjectPtrWeak;
+typedef WeakPtr<Scope>        ScopePtrWeak;
+typedef WeakPtr<Variable>     VariablePtrWeak;
+typedef WeakPtr<Block>        BlockPtrWeak;
+typedef WeakPtr<VariableBase> VariableBasePtrWeak;
+typedef WeakPtr<List>         ListPtrWeak;
 
 
 typedef std::vector<BlockPtr> BlockList;
@@ -183,24 +325,9 @@ typedef std::deque<VariableBasePtr> ListType;
 
 
 #if defined(SS_USE_HASH_MAP_SCOPES)
-
-#if defined(PLAT_LINUX)
-	//There is no default hash function for strings, so I'm using my own.
-	struct StringHash
-	{ 
-		size_t operator()(const SS::String& s) const
-		{ 
-			return STLHASH<const Char*>()(s.c_str()); 
-		} 
-	};
-
-	typedef STDEXT::hash_map< SS::String, ScopeObjectPtr, StringHash > ScopeListType;
-#else
-	typedef STDEXT::hash_map< SS::String, ScopeObjectPtr > ScopeListType;
-#endif
-
+	typedef STDEXT::hash_map< SymbolID, ScopeObjectPtr > ScopeListType;
 #else
-	typedef std::map< SS::String, ScopeObjectPtr > ScopeListType;
+	typedef std::map< SymbolID, ScopeObjectPtr > ScopeListType;
 #endif
 
 
@@ -268,7 +268,8 @@ public:
 	VariablePtr CastToVariable();
 	const VariablePtr CastToVariable() const;
 
-	//VariablePtr Duplicate() const;
+	///Creates an unnamed, constant copy of this variable at the default precision.
+	VariablePtr Duplicate() const;
 	
 	VariableBasePtr operator+(const VariableBase&) const;
 	VariableBasePtr operator-(const VariableBase&) const;
@@ -334,12 +335,20 @@ public:
 	StringType& GetActualStringData();
 	
 protected:
-	virtual ScopeObjectPtr GetScopeObjectHook( const SS::String& );
+	virtual ScopeObjectPtr GetScopeObjectHook( SymbolID );
 
 private:
+	///Immediates work directly on a Variable's components.
+	friend class Immediate;
+	
 	///Called by constructors to handle any common initialization.
 	void RegisterPredefinedVars();
 	
+	///Converts the NumType component if need be, and returns it.
+	const NumType& ConvertNum() const;
+	///Converts the StringType component if need be, and returns it.
+	const StringType& ConvertString() const;
+	
 	///Signifies whether a precision magic-var has been spawned yet.
 	bool mPrecisionVarCreated;
 
@@ -18,6 +18,7 @@ directory named "license".
 #include "Unicode.hpp"
 #include "LanguageConstants.hpp"
 #include "DLLExportString.hpp"
+#include "SymbolTable.hpp"
 
 namespace SS{
 
@@ -97,6 +98,14 @@ public:
 	/// The compound string that hold the identifier name or a literal.
 	CompoundString Str;
 	
+	/**
+		\brief The interned parts of an identifier.
+		
+		Filled in by the ReaderSource for identifiers, so it may be empty
+		for words made elsewhere.  Use Str if it is.
+	*/
+	CompoundSymbol Sym;
+	
 	/// The simple type.
 	mutable WordType Type;
 	
@@ -136,6 +145,16 @@ SS::CompoundString MakeCompoundID( const SS::String& S);
 */
 SS::String CollapseCompoundString( const SS::CompoundString& CS );
 
+/**
+	\brief Collapses a compound symbol into a simple string.
+	
+	The same as CollapseCompoundString, for identifiers that have been
+	interned.
+	
+	\param CS The CompoundSymbol you would like converted.
+*/
+SS::String CollapseCompoundSymbol( const SS::CompoundSymbol& CS );
+
 //Defined in Word.cpp:
 
 /// A special word that signifies the end of the file.
@@ -20,13 +20,16 @@ using namespace SS;
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 Block::Block()
-{}
+{
+	mType = SCOPEOBJ_BLOCK;
+}
 
 Block::Block( SS_DECLARE_BASE_ARGS,
 			  Interpreter& I, const Bookmark& Position, unsigned int ListIndex )
 	: Operator( SS_BASE_ARGS ), mBeenSaid(false),
 	  mFilePosition(Position), mListIndex(ListIndex), mpI(&I)
 {
+	mType = SCOPEOBJ_BLOCK;
 	RegisterPredefinedVars();
 }
 
@@ -93,6 +96,19 @@ unsigned int Block::GetListIndex() const
 	return mListIndex;
 }
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ByteCodePtr Block::GetByteCode() const
+{
+	return mpByteCode;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Block::SetByteCode( ByteCodePtr pCode )
+{
+	mpByteCode = pCode;
+}
+
+
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 void Block::AcceptVisitor( ScopeObjectVisitor& V )
@@ -103,12 +119,12 @@ void Block::AcceptVisitor( ScopeObjectVisitor& V )
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 BlockPtr Block::CastToBlock(){
 	AssertCastingAllowed();
-	return boost::dynamic_pointer_cast<Block>( ScopeObjectPtr(mpThis) );
+	return BlockPtr( this );
 }
 
 const BlockPtr Block::CastToBlock() const{
 	AssertCastingAllowed();
-	return boost::dynamic_pointer_cast<Block>( ScopeObjectPtr(mpThis) );
+	return BlockPtr( const_cast<Block*>(this) );
 }
 
 
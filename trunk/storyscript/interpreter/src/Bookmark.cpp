@@ -7,6 +7,7 @@ directory named "license".
 */
 
 #include "Bookmark.hpp"
+#include "Scope.hpp"
 using namespace SS;
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
@@ -21,6 +21,7 @@ NOTES: Adds all the predefined variables
 Character::Character( SS_DECLARE_BASE_ARGS )
 : Scope(SS_BASE_ARGS)
 {
+	mType = SCOPEOBJ_CharACTER;
 }
 
 
@@ -25,20 +25,20 @@ directory named "license".
 
 using namespace SS;
 
-#define Implement_CreateGeneric(x) template boost::shared_ptr<x> SS::CreateGeneric<x> ( SS_DECLARE_BASE_ARGS );
+#define Implement_CreateGeneric(x) template boost::intrusive_ptr<x> SS::CreateGeneric<x> ( SS_DECLARE_BASE_ARGS );
 
-#define Implement_CreateGeneric_BuiltIn(x) template boost::shared_ptr<x> SS::CreateGeneric<x> ( Interpreter& );
+#define Implement_CreateGeneric_BuiltIn(x) template boost::intrusive_ptr<x> SS::CreateGeneric<x> ( Interpreter& );
 
-//#define Implement_CreateGeneric_NoArgs(x) template boost::shared_ptr<x> SS::CreateGeneric<x> ()
+//#define Implement_CreateGeneric_NoArgs(x) template boost::intrusive_ptr<x> SS::CreateGeneric<x> ()
 #define Implement_CreateBasic(x) \
-template boost::shared_ptr<x> SS::CreateBasic<x>( )
+template boost::intrusive_ptr<x> SS::CreateBasic<x>( )
 
-#define Implement_CreateVariable(x) template boost::shared_ptr<x> SS::CreateVariable<x> ( SS_DECLARE_BASE_ARGS, const Variable& );\
-template boost::shared_ptr<x> SS::CreateVariable<x> ( SS_DECLARE_BASE_ARGS, const NumType& );\
-template boost::shared_ptr<x> SS::CreateVariable<x> ( SS_DECLARE_BASE_ARGS, const StringType& );\
-template boost::shared_ptr<x> SS::CreateVariable<x> ( SS_DECLARE_BASE_ARGS, const BoolType& )
+#define Implement_CreateVariable(x) template boost::intrusive_ptr<x> SS::CreateVariable<x> ( SS_DECLARE_BASE_ARGS, const Variable& );\
+template boost::intrusive_ptr<x> SS::CreateVariable<x> ( SS_DECLARE_BASE_ARGS, const NumType& );\
+template boost::intrusive_ptr<x> SS::CreateVariable<x> ( SS_DECLARE_BASE_ARGS, const StringType& );\
+template boost::intrusive_ptr<x> SS::CreateVariable<x> ( SS_DECLARE_BASE_ARGS, const BoolType& )
 
-#define Implement_CreateBlock(x) template boost::shared_ptr<x> SS::CreateBlock<x> ( SS_DECLARE_BASE_ARGS, Interpreter& I, const Bookmark& Position, unsigned int ListIndex )
+#define Implement_CreateBlock(x) template boost::intrusive_ptr<x> SS::CreateBlock<x> ( SS_DECLARE_BASE_ARGS, Interpreter& I, const Bookmark& Position, unsigned int ListIndex )
 
 Implement_CreateGeneric(ScopeObject);
 Implement_CreateGeneric(Scope);
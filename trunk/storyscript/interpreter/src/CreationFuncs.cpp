@@ -11,30 +11,27 @@ directory named "license".
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 template< typename T >
-boost::shared_ptr<T> SS::CreateBasic()
+boost::intrusive_ptr<T> SS::CreateBasic()
 {
-	boost::shared_ptr<T> pNewObj( new T );
-	pNewObj->SetSharedPtr( pNewObj );
+	boost::intrusive_ptr<T> pNewObj( new T );
 	
 	return pNewObj;
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 template< typename T >
-boost::shared_ptr<T> SS::CreateGeneric( Interpreter& I )
+boost::intrusive_ptr<T> SS::CreateGeneric( Interpreter& I )
 {
-	boost::shared_ptr<T> pNewObj( new T( I ) );
-	pNewObj->SetSharedPtr( pNewObj );
+	boost::intrusive_ptr<T> pNewObj( new T( I ) );
 	
 	return pNewObj;
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 template< typename T >
-boost::shared_ptr<T> SS::CreateGeneric( SS_DECLARE_BASE_ARGS )
+boost::intrusive_ptr<T> SS::CreateGeneric( SS_DECLARE_BASE_ARGS )
 {
-	boost::shared_ptr<T> pNewObj( new T( SS_BASE_ARGS ) );
-	pNewObj->SetSharedPtr( pNewObj );
+	boost::intrusive_ptr<T> pNewObj( new T( SS_BASE_ARGS ) );
 	
 	return pNewObj;	
 }
@@ -43,13 +40,12 @@ boost::shared_ptr<T> SS::CreateGeneric( SS_DECLARE_BASE_ARGS )
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 template< typename T >
-boost::shared_ptr<T> SS::CreateBlock(  SS_DECLARE_BASE_ARGS,
+boost::intrusive_ptr<T> SS::CreateBlock(  SS_DECLARE_BASE_ARGS,
 									Interpreter& I,
 									const Bookmark& Position,
 									unsigned int ListIndex )
 {
-	boost::shared_ptr<T> pNewBlock( new T( SS_BASE_ARGS, I, Position, ListIndex ) );
-	pNewBlock->SetSharedPtr( pNewBlock );
+	boost::intrusive_ptr<T> pNewBlock( new T( SS_BASE_ARGS, I, Position, ListIndex ) );
 	
 	return pNewBlock;
 }
@@ -57,40 +53,36 @@ boost::shared_ptr<T> SS::CreateBlock(  SS_DECLARE_BASE_ARGS,
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 template< typename T >
-boost::shared_ptr<T> SS::CreateVariable( SS_DECLARE_BASE_ARGS, const Variable& Var )
+boost::intrusive_ptr<T> SS::CreateVariable( SS_DECLARE_BASE_ARGS, const Variable& Var )
 {
-	boost::shared_ptr<T> pNewVar( new T( SS_BASE_ARGS, Var ) );
-	pNewVar->SetSharedPtr( pNewVar );
+	boost::intrusive_ptr<T> pNewVar( new T( SS_BASE_ARGS, Var ) );
 		
 	return pNewVar;
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 template< typename T  >
-boost::shared_ptr<T> SS::CreateVariable( SS_DECLARE_BASE_ARGS, const NumType& Num )
+boost::intrusive_ptr<T> SS::CreateVariable( SS_DECLARE_BASE_ARGS, const NumType& Num )
 {
-	boost::shared_ptr<T> pNewVar( new T( SS_BASE_ARGS, Num ) );
-	pNewVar->SetSharedPtr( pNewVar );
+	boost::intrusive_ptr<T> pNewVar( new T( SS_BASE_ARGS, Num ) );
 		
 	return pNewVar;
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 template< typename T >
-boost::shared_ptr<T> SS::CreateVariable( SS_DECLARE_BASE_ARGS, const StringType& String )
+boost::intrusive_ptr<T> SS::CreateVariable( SS_DECLARE_BASE_ARGS, const StringType& String )
 {
-	boost::shared_ptr<T> pNewVar( new T( SS_BASE_ARGS, String ) );
-	pNewVar->SetSharedPtr( pNewVar );
+	boost::intrusive_ptr<T> pNewVar( new T( SS_BASE_ARGS, String ) );
 		
 	return pNewVar;
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 template< typename T >
-boost::shared_ptr<T> SS::CreateVariable( SS_DECLARE_BASE_ARGS, const BoolType& Boolean )
+boost::intrusive_ptr<T> SS::CreateVariable( SS_DECLARE_BASE_ARGS, const BoolType& Boolean )
 {
-	boost::shared_ptr<T> pNewVar( new T( SS_BASE_ARGS, Boolean ) );
-	pNewVar->SetSharedPtr( pNewVar );
+	boost::intrusive_ptr<T> pNewVar( new T( SS_BASE_ARGS, Boolean ) );
 		
 	return pNewVar;
 }
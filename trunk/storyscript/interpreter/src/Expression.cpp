@@ -8,14 +8,18 @@ directory named "license".
 
 
 #include "Expression.hpp"
+#include "Immediate.hpp"
 #include "List.hpp"
 #include "Interpreter.hpp"
 #include "Interface.hpp"
 #include "Operator.hpp"
 #include "Unicode.hpp"
 #include "CreationFuncs.hpp"
+#include "RuntimeContext.hpp"
 #include <boost/lexical_cast.hpp>
 
+#include <mpfr.h>
+
 using namespace SS;
 
 
@@ -67,7 +71,8 @@ private:
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 Expression::Expression( Interpreter& I )
-	: mSyntaxChecked(false), mI(I), mpWordList( new WordList ), mStatic(false)
+	: mSyntaxChecked(false), mI(I), mpWordList( new WordList ), mStatic(false),
+	  mLine(0)
 {
 	
 }
@@ -82,31 +87,17 @@ Expression::Expression()
 */
 
 
-Expression::Expression( const Expression& OtherExp, const Bounds& OtherBounds )
-	: mpPrecedenceList(OtherExp.mpPrecedenceList),
-	  mSyntaxChecked(OtherExp.mSyntaxChecked),
- 	  mI(OtherExp.mI),
- 	  mBounds(OtherBounds),
- 	  mpWordList( OtherExp.mpWordList ),
- 	  mStatic(OtherExp.mStatic)
-{
-	if( mBounds.Upper < mBounds.Lower )
-	{
-		ThrowParserAnomaly( TXT("UpperBounds is less than LowerBounds in"
-							" Expression initialization.  This indicates"
-							" a very serious bug."), ANOMALY_PANIC );
-	}
-}
-
-
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 Expression& Expression::operator=( const Expression& OtherExp )
 {
 	mpWordList = OtherExp.mpWordList;
 	mBounds = OtherExp.mBounds;
 	mStatic = OtherExp.mStatic;
-	mpPrecedenceList = OtherExp.mpPrecedenceList;
+	mpRoot = OtherExp.mpRoot;
+	mResolutions.clear();
 	mSyntaxChecked = OtherExp.mSyntaxChecked;
+	mFileName = OtherExp.mFileName;
+	mLine = OtherExp.mLine;
 	return *this;
 }
 
@@ -121,6 +112,18 @@ void Expression::SetStatic( bool flag /*= true*/ ) const{
 }
 
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Expression::SetLocation( const String& FileName, unsigned long Line )
+{
+	mFileName = FileName;
+	mLine = Line;
+}
+
+unsigned long Expression::GetLine() const{
+	return mLine;
+}
+
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 Word& Expression::operator[]( unsigned long i )
 {
@@ -144,6 +147,8 @@ void Expression::clear()
 	mStatic = false;
 	
 	if( mSyntaxChecked ) mSyntaxChecked = false;	
+	mpRoot.reset();
+	mResolutions.clear();
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
@@ -154,6 +159,8 @@ void Expression::push_back( const Word& SomeWord )
 	mBounds.Upper++;
 	
 	if( mSyntaxChecked ) mSyntaxChecked = false;
+	mpRoot.reset();
+	mResolutions.clear();
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
@@ -164,6 +171,8 @@ void Expression::pop_back()
 	mBounds.Upper--;
 	
 	if( mSyntaxChecked ) mSyntaxChecked = false;
+	mpRoot.reset();
+	mResolutions.clear();
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
@@ -194,6 +203,8 @@ void Expression::erase( unsigned long i )
 	mBounds.Upper--;
 	
 	if( mSyntaxChecked ) mSyntaxChecked = false;
+	mpRoot.reset();
+	mResolutions.clear();
 }
 
 
@@ -227,7 +238,8 @@ void Expression::RevertToLocalCopy()
 		mBounds.Lower = 0;
 		mBounds.Upper = mpWordList->size();
 		
-		mpPrecedenceList.reset();
+		mpRoot.reset();
+	mResolutions.clear();
 	}
 }
 
@@ -235,241 +247,365 @@ void Expression::RevertToLocalCopy()
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 VariableBasePtr Expression::Evaluate() const
 {
-	return InternalEvaluate();
+	LineProfiler* pLines = mI.GetActiveLineProfiler();
+	if( !pLines ) return EvaluateUncounted();
+	
+	pLines->Enter( mFileName, mLine );
+	LineSpan Span( pLines );
+	
+	return EvaluateUncounted();
 }
 
-//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~MONOLITHIC~FUNCTION~~~~~~
-VariableBasePtr Expression::InternalEvaluate( 
-					 bool TopLevel /*=true*/,
-					 ObjectCachePtr pCachedObjects /*= ObjectCachePtr()*/ ) const
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+VariableBasePtr Expression::EvaluateUncounted() const
 {
 	/*
 		Take care of any business before we get started.
 	*/
-	
-	unsigned long ExpressionSize = size();
-	
-	if( ExpressionSize == 0 ){
-		ThrowParserAnomaly( 
+
+	if( size() == 0 ){
+		ThrowParserAnomaly(
 			TXT("Tried to evaluate an empty expression.  Probably a bug, please report. "),
 			ANOMALY_PANIC );
 	}
-	
+
 	if( !mSyntaxChecked ){
 		CheckSyntax();
 		mSyntaxChecked = true;
 	}
-	
-	if( !pCachedObjects )
-	{
-		pCachedObjects.reset( new ObjectCache );
-		CacheIdentifierObjects( pCachedObjects );
-	}
-	
 
-    if( StripOutlyingParenthesis() ) ExpressionSize = size();
-    
-    
-    
-    
-    
-    /*
+	//Identifiers have to be checked every time, because they depend on
+	//what scope we are in.  (Each remembers its last lookup, though.)
+	ObjectCache CachedObjects;
+	CacheIdentifierObjects( CachedObjects );
+
+	//Hold on to the root, just in case the expression gets modified while
+	//it is being evaluated.
+	NodePtr pRoot = mpRoot;
+	if( !pRoot ) pRoot = mpRoot = CompileNode( mBounds, CachedObjects );
+
+	ImmediateSlot Result( mI.GetImmediateStack() );
+	EvaluateNode( *pRoot, CachedObjects, *Result );
+
+	return Result->GetObject();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Expression::NodePtr Expression::CompileNode( Bounds B, const ObjectCache& CachedObjects ) const
+{
+	StripOutlyingParenthesis( B );
+
+
+	/*
 		Handle single word expressions.
 	*/
-	
-	if( ExpressionSize == 1 )
+
+	if( B.Upper - B.Lower == 1 )
 	{
-		const Word& FirstWord = GetWord(0);
-		
+		const Word& FirstWord = (*mpWordList)[B.Lower];
+
 		if( FirstWord.Type == WORDTYPE_IDENTIFIER ) {
-			return (*pCachedObjects)[GetAbsoluteIndex(0)]->CastToVariableBase();
-		}
-		else if( FirstWord.Extra == EXTRA_BOOLLITERAL_True ) {
-			return CreateVariable<Variable>( UNNAMMED, true, true );
-		}
-		else if( FirstWord.Extra == EXTRA_BOOLLITERAL_False ) {
-			return CreateVariable<Variable>( UNNAMMED, true, false );
+			return NodePtr( new Node( Node::NODE_IDENTIFIER, B ) );
 		}
-		else if( FirstWord.Type == WORDTYPE_StringLITERAL ||
+		else if( FirstWord.Extra == EXTRA_BOOLLITERAL_True ||
+				 FirstWord.Extra == EXTRA_BOOLLITERAL_False ||
+				 FirstWord.Type == WORDTYPE_StringLITERAL ||
 				 FirstWord.Type == WORDTYPE_FLOATLITERAL )
 		{
-			//Here is where the effectiveness of my autoconversions get tested.
-			VariablePtr pTempVar( CreateVariable<Variable>( UNNAMMED, true, (*this)[0].Str[0] ) );
-
-			if( FirstWord.Type == WORDTYPE_FLOATLITERAL ) {
-				pTempVar->ForceConversion( VARTYPE_NUM );
-			}
-
-			return pTempVar;
+			NodePtr pNode( new Node( Node::NODE_LITERAL, B ) );
+			ParseLiteral( *pNode );
+			return pNode;
 		}
 		else if( FirstWord.Type == WORDTYPE_EMPTYLISTLITERAL )	{
-			return gpEmptyList->CastToVariableBase();
+			return NodePtr( new Node( Node::NODE_EMPTYLIST, B ) );
 		}
 		else {
 			ThrowParserAnomaly( TXT("Catastraphic error in single word expression evaluation.  Please report this error."), ANOMALY_PANIC );
 		}
 	}
-	
-	
-	
+
+
 	/*
 		Determine the low precedence operator
 	*/
-	unsigned long LowPrecedenceOpIndex;
-	PrecedenceList::iterator i;
-	if( !mpPrecedenceList || (i = mpPrecedenceList->find( mBounds )) == mpPrecedenceList->end()  )
-	{
-		LowPrecedenceOpIndex = (unsigned long)CalculateLowPrecedenceOperator(pCachedObjects);
-		
-		if( !mpPrecedenceList ) mpPrecedenceList.reset( new PrecedenceList );
-		
-		(*mpPrecedenceList)[mBounds] = LowPrecedenceOpIndex;
-	}
+	const size_t LowPrecedenceOpIndex = CalculateLowPrecedenceOperator( B, CachedObjects );
+	const Word& LowPrecedenceWord = (*mpWordList)[LowPrecedenceOpIndex];
+
+	Node::NodeType Type;
+	if( LowPrecedenceWord.Type == WORDTYPE_IDENTIFIER )          Type = Node::NODE_FUNCTION;
+	else if( LowPrecedenceWord.Type == WORDTYPE_UNARYOPERATOR )  Type = Node::NODE_UNARYOP;
+	else if( LowPrecedenceWord.Type == WORDTYPE_BINARYOPERATOR ) Type = Node::NODE_BINARYOP;
 	else
 	{
-		LowPrecedenceOpIndex = (*mpPrecedenceList)[mBounds];
+		//Whoa! WTF!  The LPO isn't a unary-operator, a binary-operator, or a function!
+		ThrowExpressionAnomaly( TXT("Catastrophicly, horrificly, terrifyingly bad bug in the "
+									"expression evaluater.  Report this, please!"), ANOMALY_PANIC, B );
+		return NodePtr(); //To placate the compiler.
 	}
-	
-	
-	const ExtraDesc& LowPrecedenceOp = GetWord( LowPrecedenceOpIndex ).Extra;
-	//Wow that was easy =)
-	
-	
-	
+
+
 	/*
 		Split the expression in two parts: everything left of the the low precedence op,
-		and everything right of it.
+		and everything right of it.  They don't get compiled until they are needed.
 	*/
-	
-	const Expression Left( *this, Bounds( GetAbsoluteIndex(0), GetAbsoluteIndex(LowPrecedenceOpIndex) ) );
 
-	size_t RightLower, RightUpper;
-	if( LowPrecedenceOpIndex + 1 < ExpressionSize )	{ 
-		RightLower = GetAbsoluteIndex(LowPrecedenceOpIndex + 1);
-		RightUpper = mBounds.Upper;		
+	boost::shared_ptr<Node> pNode( new Node( Type, B ) );
+	pNode->Op = LowPrecedenceWord.Extra;
+	pNode->Index = LowPrecedenceOpIndex;
+	pNode->Left = Bounds( B.Lower, LowPrecedenceOpIndex );
+	if( LowPrecedenceOpIndex + 1 < B.Upper ) {
+		pNode->Right = Bounds( LowPrecedenceOpIndex + 1, B.Upper );
 	}
-	else{
-		RightLower = 0;
-		RightUpper = 0;
+
+	return pNode;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Expression::ParseLiteral( const Node& N ) const
+{
+	const Word& LiteralWord = (*mpWordList)[N.Index];
+
+	if( LiteralWord.Extra == EXTRA_BOOLLITERAL_True ) {
+		N.pLiteral = CreateVariable<Variable>( UNNAMMED, true, true );
+	}
+	else if( LiteralWord.Extra == EXTRA_BOOLLITERAL_False ) {
+		N.pLiteral = CreateVariable<Variable>( UNNAMMED, true, false );
 	}
+	else
+	{
+		//Here is where the effectiveness of my autoconversions get tested.
+		N.pLiteral = CreateVariable<Variable>( UNNAMMED, true, LiteralWord.Str[0] );
+
+		if( LiteralWord.Type == WORDTYPE_FLOATLITERAL ) {
+			N.pLiteral->ForceConversion( VARTYPE_NUM );
+		}
+	}
+
+	N.LiteralPrecision = LangOpts::Instance().DefaultPrecision;
+	N.LiteralBase = LangOpts::Instance().NumberBase;
+}
 
-	const Expression Right( *this, Bounds( RightLower, RightUpper ) );
 
-	if( IsStatic() ){
-		Left.SetStatic();
-		Right.SetStatic();
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Expression::EvaluateOperand( const Node& N, bool LeftSide, ObjectCache& CachedObjects, Immediate& Out ) const
+{
+	const Bounds& B = LeftSide ? N.Left : N.Right;
+	NodePtr& pOperand = LeftSide ? N.pLeft : N.pRight;
+
+	if( B.Lower == B.Upper ){
+		ThrowParserAnomaly(
+			TXT("Tried to evaluate an empty expression.  Probably a bug, please report. "),
+			ANOMALY_PANIC );
 	}
-	
+
+	NodePtr pTmp = pOperand;
+	if( !pTmp ) pTmp = pOperand = CompileNode( B, CachedObjects );
+
+	//Deeply nested operands carry on in a new stack segment.
+	if( mI.NeedsNewSegment() )
+	{
+		NodeCall Call;
+		Call.pThis = this;
+		Call.pNode = pTmp.get();
+		Call.pObjects = &CachedObjects;
+		Call.pOut = &Out;
+		mI.RunOnNewSegment( &Expression::EvaluateNodeOnSegment, &Call );
+		return;
+	}
+
+	EvaluateNode( *pTmp, CachedObjects, Out );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Expression::EvaluateNodeOnSegment( void* pCall )
+{
+	NodeCall& Call = *(NodeCall*)pCall;
+	Call.pThis->EvaluateNode( *Call.pNode, *Call.pObjects, *Call.pOut );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~MONOLITHIC~FUNCTION~~~~~~
+void Expression::EvaluateNode( const Node& N, ObjectCache& CachedObjects, Immediate& Out ) const
+{
+	/*
+		Single word nodes.
+	*/
+	switch( N.Type )
+	{
+	case Node::NODE_IDENTIFIER:
+		Out.SetObject( CachedObjects[N.Index]->CastToVariableBase() );
+		return;
+
+	case Node::NODE_LITERAL:
+		//Number literals depend on these settings, so they get re-parsed if they change.
+		if( N.LiteralPrecision != LangOpts::Instance().DefaultPrecision ||
+			N.LiteralBase != LangOpts::Instance().NumberBase )
+		{
+			ParseLiteral( N );
+		}
+		Out.SetValue( *N.pLiteral, true );
+		return;
+
+	case Node::NODE_EMPTYLIST:
+		Out.SetObject( RuntimeContext::Current().GetEmptyList()->CastToVariableBase() );
+		return;
+
+	default:
+		break;
+	}
+
+
+	const bool HasLeft  = N.Left.Lower  != N.Left.Upper;
+	const bool HasRight = N.Right.Lower != N.Right.Upper;
+
+	ImmediateSlot Left( mI.GetImmediateStack() ), Right( mI.GetImmediateStack() );
+	bool LeftEvaluated = false;
 
 
-	VariableBasePtr pLeftVar, pRightVar, pResultant;
 
-	
-	
 	/*
 		Special Case for handling short-circuting of logical operators.
 		This prevents the right side from being evaluated if the left side is true/false.
 	*/
-	
-	if( LowPrecedenceOp == EXTRA_BINOP_LogicalOr ||
-		LowPrecedenceOp == EXTRA_BINOP_LogicalAnd )
+
+	if( N.Op == EXTRA_BINOP_LogicalOr ||
+		N.Op == EXTRA_BINOP_LogicalAnd )
 	{
-		pLeftVar =	Left.InternalEvaluate( false, pCachedObjects ); 		
-		
-		if( LowPrecedenceOp == EXTRA_BINOP_LogicalOr && pLeftVar->GetBoolData() == true ){
-			return CreateVariable<Variable>( SS_BASE_ARGS_DEFAULTS, true );
+		EvaluateOperand( N, true, CachedObjects, *Left );
+		LeftEvaluated = true;
+
+		const BoolType LeftBool =
+			Left->IsValue() ? Left->GetBoolData() : Left->GetObject()->GetBoolData();
+
+		if( N.Op == EXTRA_BINOP_LogicalOr && LeftBool == true ){
+			Out.SetBool( true );
+			return;
 		}
-		else if( LowPrecedenceOp == EXTRA_BINOP_LogicalAnd && pLeftVar->GetBoolData() == false ){
-			return CreateVariable<Variable>( SS_BASE_ARGS_DEFAULTS, false );
+		else if( N.Op == EXTRA_BINOP_LogicalAnd && LeftBool == false ){
+			Out.SetBool( false );
+			return;
 		}
-	
+
 		//Shit, no short-circuting necessary so now we have to deal with the right side!
 		//Don't worry, if we just let it fall through,
 		//and stop it from re-evaluating the left-side, we'll be fine.
 	}
-	
-	
-	
+
+
+
 	/*
 		Evaluate the right side expression.
 	*/
-	if( !Right.empty() ) {
-		pRightVar = Right.InternalEvaluate( false, pCachedObjects );
-			
+	if( HasRight ) {
+		EvaluateOperand( N, false, CachedObjects, *Right );
 	}
 	//Somehow a trailing operator got flagged as the low precedence op.
 	else {
 		ThrowExpressionAnomaly( TXT("Trailing operator with no argument."),
-								ANOMALY_BADGRAMMAR );
+								ANOMALY_BADGRAMMAR, N.Range );
 	}
-	
-	
-	
+
+
+
 	/*
 		Evaluate a functions/usr-ops.
 	*/
-	if( GetWord( LowPrecedenceOpIndex ).Type == WORDTYPE_IDENTIFIER )
+	if( N.Type == Node::NODE_FUNCTION )
 	{
 		//TODO: (Known Issue) Right now syntax like: "(SSMath):sin 0.5" is not supported.
 		//I'm going to have to find a work around for this, but I don't know of one off the
 		//op of my head that won't hurt performance.
 
-		
-		OperatorPtr pOp = (*pCachedObjects)[ GetAbsoluteIndex(LowPrecedenceOpIndex) ]->CastToOperator();
-		
-		VariableBasePtr ReturnVal = pOp->Operate( pRightVar );
-		if( !Left.empty() ){
-			Left.InternalEvaluate( false, pCachedObjects );
+
+		OperatorPtr pOp = CachedObjects[ N.Index ]->CastToOperator();
+
+		Out.SetObject( pOp->Operate( Right->GetObject() ) );
+		if( HasLeft ){
+			EvaluateOperand( N, true, CachedObjects, *Left );
 		}
-		
-		return ReturnVal;
+
+		return;
 	}
-	
-	
+
+
 	/*
 		(Hard-coded) Unary Operators.
 	*/
-	else if( GetWord( LowPrecedenceOpIndex ).Type == WORDTYPE_UNARYOPERATOR )
+	else if( N.Type == Node::NODE_UNARYOP )
 	{
-		VariableBasePtr ReturnVal = EvaluateUnaryOp( GetWord( LowPrecedenceOpIndex ).Extra, pRightVar );
-		if( !Left.empty() ){
-			Left.InternalEvaluate( false, pCachedObjects );
+		if( !Right->IsValue() || !Out.UnaryOp( N.Op, *Right ) ){
+			Out.SetObject( EvaluateUnaryOp( N.Op, Right->GetObject(), N.Range ) );
 		}
-		
-		return ReturnVal;
+		if( HasLeft ){
+			EvaluateOperand( N, true, CachedObjects, *Left );
+		}
+
+		return;
 	}
-	
-	
+
+
 	/*
 		Evaluate the left side expression
 	*/
-	if( !Left.empty() ) {
-		if( !pLeftVar ){
-			pLeftVar = Left.InternalEvaluate( false, pCachedObjects );
+	if( HasLeft ) {
+		if( !LeftEvaluated ){
+			EvaluateOperand( N, true, CachedObjects, *Left );
 		}
 	}
 	//Binary operator without a left operand.
 	else {
 		ThrowExpressionAnomaly( TXT("Binary operator found without a left operand."),
-								ANOMALY_BADGRAMMAR );
+								ANOMALY_BADGRAMMAR, N.Range );
 	}
-	
-	
+
+
 	/*
 		Binary Operators
 	*/
-	if( GetWord( LowPrecedenceOpIndex ).Type == WORDTYPE_BINARYOPERATOR )
+	EvaluateBinaryOp( N.Op, *Left, *Right, Out );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Expression::EvaluateBinaryOp( ExtraDesc Op, Immediate& Left, Immediate& Right, Immediate& Out ) const
+{
+	//Plain values don't need a Variable made for the result.
+	if( Left.IsValue() && Right.IsValue() && Out.BinaryOp( Op, Left, Right ) ) return;
+
+	//Neither do assignments to a plain Variable.
+	Variable* pTarget = Left.GetVariable();
+	if( pTarget && Right.IsValue() )
 	{
-		return EvaluateBinaryOp( GetWord( LowPrecedenceOpIndex ).Extra, pLeftVar, pRightVar );
+		ExtraDesc BaseOp = EXTRA_NULL;
+
+		if( Op == EXTRA_BINOP_MinusAssign )         BaseOp = EXTRA_BINOP_Minus;
+		else if( Op == EXTRA_BINOP_PlusAssign )     BaseOp = EXTRA_BINOP_Plus;
+		else if( Op == EXTRA_BINOP_DivideAssign )   BaseOp = EXTRA_BINOP_Divide;
+		else if( Op == EXTRA_BINOP_TimesAssign )    BaseOp = EXTRA_BINOP_Times;
+		else if( Op == EXTRA_BINOP_ExponentAssign ) BaseOp = EXTRA_BINOP_Exponent;
+		else if( Op == EXTRA_BINOP_ConcatAssign )   BaseOp = EXTRA_BINOP_Concat;
+
+		if( BaseOp != EXTRA_NULL && Out.BinaryOp( BaseOp, Left, Right ) )
+		{
+			Out.AssignTo( *pTarget );
+			Out.SetObject( Left.GetObject() );
+			return;
+		}
+
+		//(A Variable assigned to itself goes the long way.)
+		if( Op == EXTRA_BINOP_Assign && Right.HoldsValue() )
+		{
+			Right.AssignTo( *pTarget );
+			Out.SetObject( Left.GetObject() );
+			return;
+		}
 	}
-	
-	
-	/*
-		Whoa! WTF!  The LPO isn't a unary-operator, a binary-operator, or a function!
-	*/
-	ThrowExpressionAnomaly( TXT("Catastrophicly, horrificly, terrifyingly bad bug in the "
-								"expression evaluater.  Report this, please!"), ANOMALY_PANIC );
-	return VariableBasePtr(); //To placate the compiler.
+
+	Out.SetObject( EvaluateBinaryOp( Op, Left.GetObject(), Right.GetObject() ) );
 }
 
 
@@ -567,11 +703,11 @@ void Expression::CheckSyntax( bool IgnoreTrailingOps /*=false*/ ) const
 
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
-bool Expression::StripOutlyingParenthesis() const
+bool Expression::StripOutlyingParenthesis( Bounds& Sub ) const
 {
-	if( (*this)[0].Extra != EXTRA_PARENTHESIS_Left ) return false;
+	if( (*mpWordList)[Sub.Lower].Extra != EXTRA_PARENTHESIS_Left ) return false;
 	
-	const unsigned long ExpressionSize = size();
+	const unsigned long ExpressionSize = (unsigned long)(Sub.Upper - Sub.Lower);
 	const Word* pTempWord = 0;
 	
 	unsigned int i, B, E, P;
@@ -579,7 +715,7 @@ bool Expression::StripOutlyingParenthesis() const
 	
 	for( i = B = E = P = 0; i < ExpressionSize; i++ )
 	{
-		pTempWord = &(*this)[i];	 
+		pTempWord = &(*mpWordList)[Sub.Lower + i];	 
 		
 		if( pTempWord->Extra == EXTRA_PARENTHESIS_Left )
 		{
@@ -603,8 +739,8 @@ bool Expression::StripOutlyingParenthesis() const
 	
 	if( B > 0 )
 	{
-		mBounds.Lower += B;
-		mBounds.Upper -= B;
+		Sub.Lower += B;
+		Sub.Upper -= B;
 		return true;
 	}
 	else return false;
@@ -612,9 +748,14 @@ bool Expression::StripOutlyingParenthesis() const
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 void Expression::ThrowExpressionAnomaly( const String& Desc, AnomalyCode Code ) const
+{
+	ThrowExpressionAnomaly( Desc, Code, mBounds );
+}
+
+void Expression::ThrowExpressionAnomaly( const String& Desc, AnomalyCode Code, const Bounds& B ) const
 {
 	String FullDesc = TXT("Bad expression: \'");
-	FullDesc += DumpToString();
+	FullDesc += DumpToString( B );
 	FullDesc += TXT("\' --- ");
 	FullDesc += Desc;
 	
@@ -624,15 +765,20 @@ void Expression::ThrowExpressionAnomaly( const String& Desc, AnomalyCode Code )
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 String Expression::DumpToString() const
+{
+	return DumpToString( mBounds );
+}
+
+String Expression::DumpToString( const Bounds& B ) const
 {
 	String Out;
-	unsigned int i;
-	for( i = 0; i < size(); i++ )
+	size_t i;
+	for( i = B.Lower; i < B.Upper; i++ )
 	{
 		//TODO: This is now broken since I no longer dump everything into the
 		//		string member. (i.e. "foo + bar" will end up looking like "foo  bar")
 
-		const Word& Temp = (*this)[i];
+		const Word& Temp = (*mpWordList)[i];
 
 		switch( Temp.Type )
 		{
@@ -679,79 +825,83 @@ String Expression::DumpToString() const
 
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
-Expression::OperatorPrecedence Expression::GetPrecedenceLevel( const Word& W ) const
+static std::map< ExtraDesc, int > MakePrecedenceList()
 {
-		//A list of operators in order of lowest to highest precedence
+	//A list of operators in order of lowest to highest precedence
+	std::map< ExtraDesc, int > PrecedenceList;
+	
+	PrecedenceList[EXTRA_BINOP_Assign]            = 1;
+	PrecedenceList[EXTRA_BINOP_MinusAssign]       = 2;
+	PrecedenceList[EXTRA_BINOP_PlusAssign]        = 3;
+	PrecedenceList[EXTRA_BINOP_ConcatAssign]		  = 3;
+	PrecedenceList[EXTRA_BINOP_DivideAssign]      = 4;
+	PrecedenceList[EXTRA_BINOP_TimesAssign]       = 5;
+	PrecedenceList[EXTRA_BINOP_ExponentAssign]    = 6;
+	PrecedenceList[EXTRA_BINOP_LogicalAnd]        = 7;
+	PrecedenceList[EXTRA_BINOP_LogicalOr]         = 8;
+	PrecedenceList[EXTRA_BINOP_Equals]            = 9;
+	PrecedenceList[EXTRA_BINOP_NotEquals]         = 9;
+	PrecedenceList[EXTRA_BINOP_LessThanOrEqual]   = 10;
+	PrecedenceList[EXTRA_BINOP_LargerThanOrEqual] = 10;
+	PrecedenceList[EXTRA_BINOP_LessThan]          = 11;
+	PrecedenceList[EXTRA_BINOP_LargerThan]        = 11;
+	
+	/*
+		Where to put the precedence of unary operators has been a great
+		concern for me.  For now it is right here, below all the math
+		operators and above logical comparisons.  
+	*/
+	PrecedenceList[EXTRA_UNOP_GenericUnaryOperator] = 12;
+	
+	
+	PrecedenceList[EXTRA_BINOP_ListSeperator]     = 13;
+	PrecedenceList[EXTRA_BINOP_Minus]             = 14;
+	PrecedenceList[EXTRA_BINOP_Concat]			  = 15;
+	PrecedenceList[EXTRA_BINOP_Plus]              = 15;
+	PrecedenceList[EXTRA_BINOP_Divide]            = 16;
+	PrecedenceList[EXTRA_BINOP_Times]             = 17;
+	PrecedenceList[EXTRA_BINOP_Exponent]          = 18;
+	
+	PrecedenceList[EXTRA_UNOP_Negative]           = 19;
+	PrecedenceList[EXTRA_UNOP_Not]                = 19;
 
-	static bool FirstRun = true;
-	static std::map< ExtraDesc, int > PrecedenceList;
+	PrecedenceList[EXTRA_UNOP_Var]				  = 19;
+	PrecedenceList[EXTRA_UNOP_List]				  = 19;
+	PrecedenceList[EXTRA_UNOP_Character]		  = 19;
+	PrecedenceList[EXTRA_UNOP_Player]			  = 19;		
 
-	if( FirstRun )
-	{
-		PrecedenceList[EXTRA_BINOP_Assign]            = 1;
-		PrecedenceList[EXTRA_BINOP_MinusAssign]       = 2;
-		PrecedenceList[EXTRA_BINOP_PlusAssign]        = 3;
-		PrecedenceList[EXTRA_BINOP_ConcatAssign]		  = 3;
-		PrecedenceList[EXTRA_BINOP_DivideAssign]      = 4;
-		PrecedenceList[EXTRA_BINOP_TimesAssign]       = 5;
-		PrecedenceList[EXTRA_BINOP_ExponentAssign]    = 6;
-		PrecedenceList[EXTRA_BINOP_LogicalAnd]        = 7;
-		PrecedenceList[EXTRA_BINOP_LogicalOr]         = 8;
-		PrecedenceList[EXTRA_BINOP_Equals]            = 9;
-		PrecedenceList[EXTRA_BINOP_NotEquals]         = 9;
-		PrecedenceList[EXTRA_BINOP_LessThanOrEqual]   = 10;
-		PrecedenceList[EXTRA_BINOP_LargerThanOrEqual] = 10;
-		PrecedenceList[EXTRA_BINOP_LessThan]          = 11;
-		PrecedenceList[EXTRA_BINOP_LargerThan]        = 11;
-		
-		/*
-			Where to put the precedence of unary operators has been a great
-			concern for me.  For now it is right here, below all the math
-			operators and above logical comparisons.  
-		*/
-		PrecedenceList[EXTRA_UNOP_GenericUnaryOperator] = 12;
-		
-		
-		PrecedenceList[EXTRA_BINOP_ListSeperator]     = 13;
-		PrecedenceList[EXTRA_BINOP_Minus]             = 14;
-		PrecedenceList[EXTRA_BINOP_Concat]			  = 15;
-		PrecedenceList[EXTRA_BINOP_Plus]              = 15;
-		PrecedenceList[EXTRA_BINOP_Divide]            = 16;
-		PrecedenceList[EXTRA_BINOP_Times]             = 17;
-		PrecedenceList[EXTRA_BINOP_Exponent]          = 18;
-		
-		PrecedenceList[EXTRA_UNOP_Negative]           = 19;
-        PrecedenceList[EXTRA_UNOP_Not]                = 19;
 
-		PrecedenceList[EXTRA_UNOP_Var]				  = 19;
-		PrecedenceList[EXTRA_UNOP_List]				  = 19;
-		PrecedenceList[EXTRA_UNOP_Character]		  = 19;
-		PrecedenceList[EXTRA_UNOP_Player]			  = 19;		
+	PrecedenceList[EXTRA_BINOP_ListAccess]        = 20; 
+	PrecedenceList[EXTRA_BINOP_ListAppend]        = 20;
+	PrecedenceList[EXTRA_BINOP_ListRemove]        = 20;
 
+	//Always keep these at the highest
+	PrecedenceList[EXTRA_BINOP_ScopeResolution]   = 21;
+	
+	return PrecedenceList;
+}
 
-		PrecedenceList[EXTRA_BINOP_ListAccess]        = 20; 
-		PrecedenceList[EXTRA_BINOP_ListAppend]        = 20;
-		PrecedenceList[EXTRA_BINOP_ListRemove]        = 20;
+//Built before main, so every interpreter (on any thread) can share it.
+static const std::map< ExtraDesc, int > gPrecedenceList = MakePrecedenceList();
 
-		//Always keep these at the highest
-		PrecedenceList[EXTRA_BINOP_ScopeResolution]   = 21;
-		
-		FirstRun = false;
-	}
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Expression::OperatorPrecedence Expression::GetPrecedenceLevel( const Word& W ) const
+{
+	std::map< ExtraDesc, int >::const_iterator i = gPrecedenceList.find( W.Extra );
 
 	//Here we assume it is a function (an Operator or Block), and return the highest precedence.
-	if( PrecedenceList.find( W.Extra ) == PrecedenceList.end() )
+	if( i == gPrecedenceList.end() )
 	{
-		return PrecedenceList[EXTRA_UNOP_GenericUnaryOperator];
+		return gPrecedenceList.find( EXTRA_UNOP_GenericUnaryOperator )->second;
 	}
 
-	return PrecedenceList[ W.Extra ];
+	return i->second;
 }
 
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
-size_t Expression::CalculateLowPrecedenceOperator( ObjectCachePtr pCache ) const
+size_t Expression::CalculateLowPrecedenceOperator( const Bounds& B, const ObjectCache& Cache ) const
 {
 	/*
 		Its important to keep track of what the last word was,
@@ -778,9 +928,9 @@ size_t Expression::CalculateLowPrecedenceOperator( ObjectCachePtr pCache ) const
 	//const unsigned long ExpressionSize = size();
 	
 	//We are using absolute indexes because its faster, and this function is slowing us down.
-	size_t i = mBounds.Lower;
+	size_t i = B.Lower;
 	
-	for( ; i < mBounds.Upper && i < mpWordList->size(); i++ )
+	for( ; i < B.Upper && i < mpWordList->size(); i++ )
 	{
 		pCurrentWord = &(*mpWordList)[ i ];
 		if( LowPrecedenceOpIndex != BAD_PRECEDENCE ) pLowPrecWord = &(*mpWordList)[ LowPrecedenceOpIndex ];
@@ -833,17 +983,17 @@ size_t Expression::CalculateLowPrecedenceOperator( ObjectCachePtr pCache ) const
 		*/
 		if( pCurrentWord->Type == WORDTYPE_IDENTIFIER )
 		{
-			if( ! (*pCache)[ i ] ){
+			if( ! Cache[ i ] ){
 				LastWordType = OPERAND;
 				continue;
 			}
 			
-			ScopeObjectType ObjType = GetScopeObjectType( (*pCache)[ i ] );
+			ScopeObjectType ObjType = GetScopeObjectType( Cache[ i ] );
 			if( ObjType == SCOPEOBJ_OPERATOR || ObjType == SCOPEOBJ_BLOCK )
 			{
 				//The current word is not a function if it is at the end of the expression,
 				//followed by by a binary operator, or followed by a closing parenthesis.
-				if( i == mBounds.Upper-1 ||
+				if( i == B.Upper-1 ||
 					(*mpWordList)[ i+1 ].Type == WORDTYPE_BINARYOPERATOR ||
 					(*mpWordList)[ i+1 ].Extra == EXTRA_PARENTHESIS_Right )
 				{
@@ -930,10 +1080,10 @@ size_t Expression::CalculateLowPrecedenceOperator( ObjectCachePtr pCache ) const
 	
 	
 	if( LowPrecedenceOpIndex == BAD_PRECEDENCE ){
-		ThrowExpressionAnomaly( TXT("Cannot find an operator in this expression."), ANOMALY_NOOPERATOR );
+		ThrowExpressionAnomaly( TXT("Cannot find an operator in this expression."), ANOMALY_NOOPERATOR, B );
 		return 0; //To placate the compiler.
 	}
-	else return LowPrecedenceOpIndex - mBounds.Lower;
+	else return LowPrecedenceOpIndex;
 }
 
 
@@ -948,11 +1098,13 @@ const Word& Expression::GetWord( unsigned long i ) const{
 
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
-void Expression::CacheIdentifierObjects( ObjectCachePtr pCache ) const
+void Expression::CacheIdentifierObjects( ObjectCache& Cache ) const
 {
 	size_t i;
 	
 	const size_t ExpressionSize = mpWordList->size();
+	Cache.resize( ExpressionSize );
+	mResolutions.resize( ExpressionSize );
 	
 	for( i = 0; i < ExpressionSize; i++ )
 	{
@@ -964,33 +1116,33 @@ void Expression::CacheIdentifierObjects( ObjectCachePtr pCache ) const
 			if( i > 0 && (*mpWordList)[ i-1 ].Extra == EXTRA_BINOP_ScopeResolution )
 			{
 				ScopeObjectPtr pTmpPtr( new LooseIdentifier( (*mpWordList)[i].Str ) );
-				pTmpPtr->SetSharedPtr( pTmpPtr );
 				
-				(*pCache)[i] = pTmpPtr;
+				Cache[i] = pTmpPtr;
 				
 				continue;
 			}			
 			
 			
-			try{
-				ScopeObjectPtr pTmpPtr =
-				mI.GetScopeObject( (*mpWordList)[i].Str );
-				
-				(*pCache)[i] = pTmpPtr;
-			}
-			catch( ParserAnomaly E )
+			const Word& ID = (*mpWordList)[i];
+			ScopeObjectPtr pTmpPtr;
+			
+			if( ID.Sym.empty() )
 			{
-				if( E.ErrorCode == ANOMALY_IDNOTFOUND )
-				{
-					//We don't throw an error yet, because this may be a variable/block/character
-					//declaration.  Just create a LooseID and it will get taken care of later.
-					ScopeObjectPtr pTmpPtr( new LooseIdentifier( (*mpWordList)[i].Str ) );
-					pTmpPtr->SetSharedPtr( pTmpPtr );
-					
-					(*pCache)[i] = pTmpPtr;
+				CompoundSymbol Symbols;
+				if( SymbolTable::Instance().Find( ID.Str, Symbols ) ){
+					pTmpPtr = mI.GetScopeObject_NoThrow( Symbols, mResolutions[i] );
 				}
-				else throw;				
 			}
+			else pTmpPtr = mI.GetScopeObject_NoThrow( ID.Sym, mResolutions[i] );
+			
+			if( !pTmpPtr )
+			{
+				//We don't throw an error yet, because this may be a variable/block/character
+				//declaration.  Just create a LooseID and it will get taken care of later.
+				pTmpPtr.reset( new LooseIdentifier( ID.Str ) );
+			}
+			
+			Cache[i] = pTmpPtr;
 		} 
 		
 	}//end for	
@@ -998,7 +1150,7 @@ void Expression::CacheIdentifierObjects( ObjectCachePtr pCache ) const
 
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
-VariableBasePtr Expression::EvaluateUnaryOp ( ExtraDesc Op, VariableBasePtr pRight ) const
+VariableBasePtr Expression::EvaluateUnaryOp ( ExtraDesc Op, VariableBasePtr pRight, const Bounds& B ) const
 {
 	//not
 	if( Op == EXTRA_UNOP_Not ){
@@ -1018,7 +1170,7 @@ VariableBasePtr Expression::EvaluateUnaryOp ( ExtraDesc Op, VariableBasePtr pRig
 			 Op == EXTRA_UNOP_Character ||
 			 Op == EXTRA_UNOP_Player )
 	{
-		boost::shared_ptr<LooseIdentifier> pLooseID;
+		boost::intrusive_ptr<LooseIdentifier> pLooseID;
 		if( pLooseID = boost::dynamic_pointer_cast<LooseIdentifier>( pRight ) )
 		{
 			if( Op == EXTRA_UNOP_Var )
@@ -1060,12 +1212,12 @@ VariableBasePtr Expression::EvaluateUnaryOp ( ExtraDesc Op, VariableBasePtr pRig
 		else
 		{
 			ThrowExpressionAnomaly( TXT("Bad declaration syntax.  The identifier you used is already"
-										"in use (or it isn't even an identifier)."), ANOMALY_BADDECLARATION );
+										"in use (or it isn't even an identifier)."), ANOMALY_BADDECLARATION, B );
 		}
 	}
 	
 	ThrowExpressionAnomaly( TXT("Unhandled hard-coded unary operator.  Please report this."),
-								ANOMALY_PANIC );
+								ANOMALY_PANIC, B );
 	return VariableBasePtr(); //To placate the compiler.
 	
 }
@@ -1220,7 +1372,7 @@ VariableBasePtr Expression::EvaluateBinaryOp( ExtraDesc Op, VariableBasePtr pLef
 	else if( Op == EXTRA_BINOP_ScopeResolution )
 	{
 		//Try to interpret it as a LooseID
-		boost::shared_ptr<LooseIdentifier> pRightLooseID = boost::dynamic_pointer_cast<LooseIdentifier>(pRight);
+		boost::intrusive_ptr<LooseIdentifier> pRightLooseID = boost::dynamic_pointer_cast<LooseIdentifier>(pRight);
 		if( pRightLooseID )
 		{
 			return (pLeft->GetScopeObject( pRightLooseID->GetLooseIDName() ))->CastToVariableBase();
@@ -10,6 +10,11 @@ NOTES: Contains misc. functions that I haven't found a better place for yet.
 #include "Unicode.hpp"
 #include "LanguageConstants.hpp"
 
+#if defined(PLAT_WIN32)
+	#include <windows.h>
+#else
+	#include <time.h>
+#endif
 
 
 using namespace SS;
@@ -260,6 +265,27 @@ bool SS::IsAlpha( Char c )
 
 
 
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: clock() counts the whole process's CPU time, which is no good once
+ 		there are interpreters on more than one thread.
+*/
+boost::uint64_t SS::GetMicroseconds()
+{
+#if defined(PLAT_WIN32)
+	LARGE_INTEGER Frequency, Count;
+	QueryPerformanceFrequency( &Frequency );
+	QueryPerformanceCounter( &Count );
+	return (boost::uint64_t)( Count.QuadPart / Frequency.QuadPart ) * 1000000 +
+		   (boost::uint64_t)( Count.QuadPart % Frequency.QuadPart ) * 1000000 / Frequency.QuadPart;
+#else
+	timespec Now;
+	clock_gettime( CLOCK_MONOTONIC, &Now );
+	return (boost::uint64_t)Now.tv_sec * 1000000 + Now.tv_nsec / 1000;
+#endif
+}
+
+
+
 /*~~~~~~~FUNCTION~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  IsSingleListStatement
  NOTES: Returns true if the expression is a single list statement, such as foo[42].  
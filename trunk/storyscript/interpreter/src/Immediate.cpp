@@ -0,0 +1,367 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+#include "Immediate.hpp"
+#include "CreationFuncs.hpp"
+#include "LanguageConstants.hpp"
+#include "ParserAnomaly.hpp"
+#include "RuntimeContext.hpp"
+
+using namespace SS;
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Immediate::Immediate()
+	: mpVariable( 0 ), mConst( false ), mCurrentType( VARTYPE_BOOL ),
+	  mNumPart( LangOpts::Instance().DefaultPrecision ), mBoolPart( false )
+{
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Immediate::Clear()
+{
+	mpObject.reset();
+	mpVariable = 0;
+	mConst = false;
+	mCurrentType = VARTYPE_BOOL;
+	mBoolPart = false;
+	mStringPart.clear();
+	mNumPart.set_nan();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Immediate::SetObject( const VariableBasePtr& pObject )
+{
+	mpObject = pObject;
+	mpVariable = dynamic_cast<Variable*>( pObject.get() );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Immediate::SetValue( const Variable& V, bool Const /*= false*/ )
+{
+	mpObject.reset();
+	mpVariable = 0;
+	mConst = Const;
+	mCurrentType = V.mCurrentType;
+	mBoolPart = V.mBoolPart;
+	mStringPart = V.mStringPart;
+
+	const mpfr_prec_t Precision = LangOpts::Instance().DefaultPrecision;
+	if( mNumPart.get_prec() != Precision ) mNumPart.set_prec( Precision );
+	mNumPart = V.mNumPart;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Immediate::SetBool( BoolType B )
+{
+	SetNum();
+	mCurrentType = VARTYPE_BOOL;
+	mBoolPart = B;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NumType& Immediate::SetNum()
+{
+	mpObject.reset();
+	mpVariable = 0;
+	mConst = false;
+	mCurrentType = VARTYPE_NUM;
+	mBoolPart = false;
+	mStringPart.clear();
+
+	//A new Variable's number is NaN at the default precision.
+	const mpfr_prec_t Precision = LangOpts::Instance().DefaultPrecision;
+	if( mNumPart.get_prec() != Precision ) mNumPart.set_prec( Precision );
+	else mNumPart.set_nan();
+
+	return mNumPart;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+StringType& Immediate::SetString()
+{
+	SetNum();
+	mCurrentType = VARTYPE_String;
+	return mStringPart;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+VariableBasePtr Immediate::GetObject()
+{
+	if( mpObject ) return mpObject;
+
+	VariablePtr pNew = CreateVariable<Variable>( UNNAMMED, mConst, mStringPart );
+	pNew->mCurrentType = mCurrentType;
+	pNew->mBoolPart = mBoolPart;
+	pNew->mNumPart = mNumPart;
+
+	SetObject( pNew );
+	return mpObject;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+VarType Immediate::GetVariableType() const
+{
+	if( mpVariable ) return mpVariable->mCurrentType;
+	return mCurrentType;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+const NumType& Immediate::GetNumData()
+{
+	if( mpVariable ) return mpVariable->ConvertNum();
+
+	//Same as Variable::GetNumData
+	if( ! mNumPart.nan_p() ) return mNumPart;
+
+	if( mCurrentType == VARTYPE_BOOL )
+	{
+		if( mBoolPart ) mNumPart.set( 1 );
+		else mNumPart = RuntimeContext::Current().GetNANConst()->mNumPart;
+	}
+	else if( mCurrentType == VARTYPE_String )
+	{
+		StringType2NumType( mStringPart, mNumPart );
+	}
+
+	return mNumPart;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+const NumType& Immediate::GetOperandNum()
+{
+	const NumType& Num = GetNumData();
+	const mpfr_prec_t Precision = mpfr_get_default_prec();
+
+	//Nothing is lost, so skip the copy.
+	if( Num.is_small() || Num.is_big() || Num.get_prec() <= Precision ) return Num;
+
+	if( mOperandNum.get_prec() != Precision ) mOperandNum.set_prec( Precision );
+	mOperandNum = Num;
+	return mOperandNum;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+BoolType Immediate::GetBoolData()
+{
+	if( mpVariable ) return mpVariable->GetBoolData();
+
+	//Same as Variable::GetBoolData
+	if( mBoolPart != false ) return mBoolPart;
+
+	if( mCurrentType == VARTYPE_NUM )
+	{
+		if( mNumPart.nan_p() ) mBoolPart = false;
+		else                              mBoolPart = true;
+	}
+	else if( mCurrentType == VARTYPE_String )
+	{
+		mBoolPart = mStringPart.empty() ? false : true;
+	}
+
+	return mBoolPart;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+const StringType& Immediate::GetStringData()
+{
+	if( mpVariable ) return mpVariable->ConvertString();
+
+	//Same as Variable::GetStringData
+	if( !mStringPart.empty() ) return mStringPart;
+
+	if( mCurrentType == VARTYPE_NUM )
+	{
+		NumType2StringType( mNumPart, mStringPart );
+	}
+	else if( mCurrentType == VARTYPE_BOOL )
+	{
+		mStringPart = mBoolPart ? TXT("true") : TXT("false");
+	}
+
+	return mStringPart;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool Immediate::UnaryOp( ExtraDesc Op, Immediate& R )
+{
+	if( Op == EXTRA_UNOP_Not )
+	{
+		SetBool( !R.GetBoolData() );
+		return true;
+	}
+	else if( Op == EXTRA_UNOP_Negative )
+	{
+		if( R.GetVariableType() == VARTYPE_BOOL ) SetBool( !R.GetBoolData() );
+		else SetNum().neg( R.GetOperandNum() );
+		return true;
+	}
+
+	return false;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool Immediate::BinaryOp( ExtraDesc Op, Immediate& L, Immediate& R )
+{
+	//Which type wins out, just like in the Variable operators.
+	const VarType ContextType =
+		Variable::mTypeConversionTable[ L.GetVariableType() ][ R.GetVariableType() ];
+
+	switch( Op )
+	{
+	// +
+	case EXTRA_BINOP_Plus:
+		if( ContextType == VARTYPE_NUM ) SetNum().add( L.GetOperandNum(), R.GetOperandNum() );
+		else if( ContextType == VARTYPE_BOOL ) SetBool( L.GetBoolData() || R.GetBoolData() );
+		else SetString() = L.GetStringData() + R.GetStringData();
+		return true;
+
+	// -
+	case EXTRA_BINOP_Minus:
+		if( ContextType == VARTYPE_NUM ) SetNum().sub( L.GetOperandNum(), R.GetOperandNum() );
+		else if( ContextType == VARTYPE_BOOL ) SetBool( L.GetBoolData() && R.GetBoolData() );
+		else ThrowParserAnomaly( TXT("Can't subtract two strings."), ANOMALY_BADStringOP );
+		return true;
+
+	// *
+	case EXTRA_BINOP_Times:
+		if( ContextType == VARTYPE_BOOL ) SetBool( L.GetBoolData() || R.GetBoolData() );
+		else SetNum().mul( L.GetOperandNum(), R.GetOperandNum() );
+		return true;
+
+	// /
+	case EXTRA_BINOP_Divide:
+		if( ContextType == VARTYPE_NUM ) SetNum().div( L.GetOperandNum(), R.GetOperandNum() );
+		else if( ContextType == VARTYPE_BOOL ) SetBool( L.GetBoolData() && R.GetBoolData() );
+		else ThrowParserAnomaly( TXT("Can't divide two strings."), ANOMALY_BADStringOP );
+		return true;
+
+	// **
+	case EXTRA_BINOP_Exponent:
+		SetNum().pow( L.GetOperandNum(), R.GetOperandNum() );
+		return true;
+
+	// .
+	case EXTRA_BINOP_Concat:
+		SetString() = L.GetStringData() + R.GetStringData();
+		return true;
+
+	// == and !=
+	case EXTRA_BINOP_Equals:
+	case EXTRA_BINOP_NotEquals:
+	{
+		bool Equal;
+		if( ContextType == VARTYPE_NUM ) Equal = L.GetOperandNum().equal_p( R.GetOperandNum() );
+		else if( ContextType == VARTYPE_String ) Equal = L.GetStringData() == R.GetStringData();
+		else Equal = L.GetBoolData() == R.GetBoolData();
+
+		SetBool( Op == EXTRA_BINOP_Equals ? Equal : !Equal );
+		return true;
+	}
+
+	// >, <, >= and <=  (Strings are compared by length.)
+	case EXTRA_BINOP_LargerThan:
+	case EXTRA_BINOP_LessThan:
+	case EXTRA_BINOP_LargerThanOrEqual:
+	case EXTRA_BINOP_LessThanOrEqual:
+	{
+		int Cmp;
+		if( ContextType == VARTYPE_NUM )
+		{
+			const NumType& A = L.GetOperandNum();
+			const NumType& B = R.GetOperandNum();
+
+			//Anything compared with NaN is false, so handle it before cmp.
+			if( A.nan_p() || B.nan_p() )
+			{
+				SetBool( false );
+				return true;
+			}
+			Cmp = A.cmp( B );
+		}
+		else if( ContextType == VARTYPE_String )
+		{
+			size_t A = L.GetStringData().length(), B = R.GetStringData().length();
+			Cmp = A < B ? -1 : (A > B ? 1 : 0);
+		}
+		else Cmp = (int)L.GetBoolData() - (int)R.GetBoolData();
+
+		if( Op == EXTRA_BINOP_LargerThan )             SetBool( Cmp > 0 );
+		else if( Op == EXTRA_BINOP_LessThan )          SetBool( Cmp < 0 );
+		else if( Op == EXTRA_BINOP_LargerThanOrEqual ) SetBool( Cmp >= 0 );
+		else                                           SetBool( Cmp <= 0 );
+		return true;
+	}
+
+	// && and ||
+	case EXTRA_BINOP_LogicalAnd:
+		SetBool( L.GetBoolData() && R.GetBoolData() );
+		return true;
+	case EXTRA_BINOP_LogicalOr:
+		SetBool( L.GetBoolData() || R.GetBoolData() );
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Immediate::AssignTo( Variable& V )
+{
+	//Same as Variable::operator=
+	V.mStringPart.clear();
+	V.mNumPart.set_nan();
+	V.mBoolPart = false;
+
+	switch( GetVariableType() ){
+		case VARTYPE_String:
+			V.mStringPart = GetStringData();
+			V.mCurrentType = VARTYPE_String;
+			break;
+		case VARTYPE_NUM:
+			V.mNumPart = GetOperandNum();
+			V.mCurrentType = VARTYPE_NUM;
+			break;
+		case VARTYPE_BOOL:
+			V.mBoolPart = GetBoolData();
+			V.mCurrentType = VARTYPE_BOOL;
+			break;
+	}
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Immediate& ImmediateStack::Push()
+{
+	if( mTop == mSlots.size() ) mSlots.resize( mTop + 1 );
+	return mSlots[ mTop++ ];
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void ImmediateStack::Pop()
+{
+	//Let go of any objects now, rather than whenever the slot is next used.
+	mSlots[ --mTop ].Clear();
+}
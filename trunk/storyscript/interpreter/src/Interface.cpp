@@ -10,6 +10,7 @@ directory named "license".
 #include "ParserAnomaly.hpp"
 #include "HelperFuncs.hpp"
 #include "Interpreter.hpp"
+#include "Block.hpp"
 #include "DLLExport.hpp"
 
 using namespace SS;
@@ -86,14 +87,19 @@ void Interface::StartConversation( const String& FileName, const String& BlockNa
 
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
-unsigned int NullInterface::PresentChoice( const std::vector<BlockPtr>& Choices )
+NullInterface::NullInterface( Interpreter& I )
+	: Interface( I )
+{
+}
+
+unsigned int NullInterface::PresentChoice( const BlockList& Choices )
 {
 		return 0;
 }
 
-void NullInterface::HandleParserAnomaly()
+void NullInterface::HandleParserAnomaly( ParserAnomaly A )
 {
-		exit(1);
+		throw A;
 }
 
 void NullInterface::LogMessage( const SS::String&, bool )
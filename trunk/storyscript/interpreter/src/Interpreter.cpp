@@ -32,6 +32,7 @@ directory named "license".
 #include <boost/shared_ptr.hpp>
 #include <memory>
 #include <map>
+#include <algorithm>
 
 
 
@@ -39,28 +40,61 @@ directory named "license".
 using namespace SS;
 
 
+//How much of the native stack a script may use before carrying on in a
+//stack segment, how big the segments are, and how much of each is left
+//free for whatever runs between two checks of NeedsNewSegment.
+static const size_t NativeStackLimit    = 256 * 1024;
+static const size_t StackSegmentSize    = 1024 * 1024;
+static const size_t StackSegmentReserve = 128 * 1024;
 
+//How many segments may be in use at once, unless the host says otherwise.
+static const size_t DefaultMaxStackSegments = 256;
 
 
 
 
-bool& Interpreter::mVerboseOutput = SS::LangOpts::Instance().Verbose;
-boost::shared_ptr<Interpreter> Interpreter::mpInstance;
 
 
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 Interpreter::Interpreter()
+	: mpInterface( 0 ),
+	  mVerboseOutput( mContext.GetLangOpts().Verbose ),
+	  mUseByteCode( mContext.GetLangOpts().UseByteCode ),
+	  mMemoizeBlocks( mContext.GetLangOpts().MemoizeBlocks )
 {
+	//Everything from here on is made in this interpreter's context.
+	RuntimeContextGuard Guard( mContext );
+
 	mpGlobalScope = CreateGeneric<Scope>();
 	InitConstants();
 	RegisterSpecials();
 	mStop = false;
+	mUseTokenCache = false;
+	mProfiling = false;
+	mLineProfiling = false;
+	mTracing = false;
+	mChoiceTime = 0;
+	mStepState = STEP_FINISHED;
+
+	mStatementBudget = 0;
+	mTimeBudget = 0;
+	ResetBudget();
+
+	mMaxCallDepth = 0;
+	mpStackBase = 0;
+	mStackLimit = NativeStackLimit;
+	mSegmentDepth = 0;
+	mMaxStackSegments = DefaultMaxStackSegments;
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 Interpreter::~Interpreter()
 {
+	//So everything below is given back to this interpreter's context.
+	//mContextRestorer puts the old one back once it has all gone.
+	mContextRestorer.pOldContext = RuntimeContext::SetCurrent( &mContext );
+	mContextRestorer.Armed = true;
 }
 
 
@@ -70,6 +104,18 @@ void Interpreter::SetInterface( Interface& SomeInterface )
 	mpInterface = &SomeInterface;
 }
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::MakeCurrent()
+{
+	RuntimeContext::SetCurrent( &mContext );
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+RuntimeContext& Interpreter::GetContext()
+{
+	return mContext;
+}
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 Interface& Interpreter::GetInterface()
 {
@@ -144,6 +190,8 @@ Bookmark Interpreter::GetCurrentPos()
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 void Interpreter::SetPos( Bookmark& NewPos )
 {
+	RuntimeContextGuard Guard( mContext );
+
 	GetSource( NewPos );
 }
 
@@ -172,10 +220,176 @@ bool Interpreter::IsVerbose() const{
 	return mVerboseOutput;
 }
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::SetUseByteCode( bool flag /*=true*/ )
+{
+	mUseByteCode = flag;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool Interpreter::IsUsingByteCode() const{
+	return mUseByteCode;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::SetMemoizeBlocks( bool flag /*=true*/ )
+{
+	mMemoizeBlocks = flag;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool Interpreter::IsMemoizingBlocks() const{
+	return mMemoizeBlocks;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+const MemoStats& Interpreter::GetMemoStats() const{
+	return mMemo.GetStats();
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::SetProfiling( bool flag /*=true*/ )
+{
+	if( flag && !mProfiling ) mProfiler.Clear();
+	mProfiling = flag;
+
+	//The profiler's object counts come from the context.
+	mContext.SetCountingObjects( flag );
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool Interpreter::IsProfiling() const{
+	return mProfiling;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+const Profiler& Interpreter::GetProfiler() const{
+	return mProfiler;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::SetLineProfiling( bool flag /*=true*/ )
+{
+	if( flag && !mLineProfiling ) mLineProfiler.Clear();
+	mLineProfiling = flag;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool Interpreter::IsLineProfiling() const{
+	return mLineProfiling;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+const LineProfiler& Interpreter::GetLineProfiler() const{
+	return mLineProfiler;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::SetTracing( bool flag /*=true*/ )
+{
+	if( flag && !mTracing )
+	{
+		mTracer.Clear();
+		mChoiceTime = 0;
+	}
+	mTracing = flag;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool Interpreter::IsTracing() const{
+	return mTracing;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+const Tracer& Interpreter::GetTracer() const{
+	return mTracer;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::SetUseTokenCache( bool flag /*=true*/ )
+{
+	mUseTokenCache = flag;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool Interpreter::IsUsingTokenCache() const{
+	return mUseTokenCache;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::SetScriptImage( ScriptImagePtr pImage )
+{
+	mpImage = pImage;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ScriptImagePtr Interpreter::GetScriptImage() const{
+	return mpImage;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::SetStatementBudget( boost::uint64_t Statements )
+{
+	mStatementBudget = Statements;
+	ResetBudget();
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+boost::uint64_t Interpreter::GetStatementBudget() const
+{
+	return mStatementBudget;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::SetTimeBudget( unsigned int Milliseconds )
+{
+	mTimeBudget = Milliseconds;
+	ResetBudget();
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+unsigned int Interpreter::GetTimeBudget() const
+{
+	return mTimeBudget;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::SetMaxCallDepth( size_t Depth )
+{
+	mMaxCallDepth = Depth;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+size_t Interpreter::GetMaxCallDepth() const
+{
+	return mMaxCallDepth;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::SetMaxStackSegments( size_t Count )
+{
+	mMaxStackSegments = Count;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+size_t Interpreter::GetMaxStackSegments() const
+{
+	return mMaxStackSegments;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+const CallStack& Interpreter::GetCallStack() const
+{
+	return mCallStack;
+}
+
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 void Interpreter::SetSource( ReaderSource& Source )
 {
+	RuntimeContextGuard Guard( mContext );
+
 	if( mSources.find( Source.GetName() ) != mSources.end() ){
 		GetSource( Bookmark( Source.GetName(), 0, 0 ) );
 		return;
@@ -190,8 +404,11 @@ void Interpreter::SetSource( ReaderSource& Source )
 	
 	mpCurrentSource.reset( &Source, null_deleter() );
 	
+	ResetBudget();
 	try{
 		Parse(); //Position should be 0,0
+		//A 'return' outside of any block just ends the file.
+		mStop = false;
 	}
 	catch( ParserAnomaly E )
 	{
@@ -204,9 +421,24 @@ void Interpreter::SetSource( ReaderSource& Source )
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 void Interpreter::LoadFile( const String& FileName )
 {
-	ReaderSourceFilePtr pNewFile( new ReaderSourceFile );
+	Tracer* pTracer = GetActiveTracer();
+	if( pTracer ) pTracer->Begin( TRACE_LOAD, TXT("LoadFile"), FileName );
+	TraceSpan Loading( pTracer );
+
+	ReaderSourcePtr pNewFile;
+	if( mpImage ) pNewFile = mpImage->OpenSource( FileName );
+
+	if( !pNewFile )
+	{
+		ReaderSourceFilePtr pFile( new ReaderSourceFile );
+		pFile->SetUseCache( mUseTokenCache );
+
+		if( pTracer ) pTracer->Begin( TRACE_LOAD, TXT("ReaderSourceFile::Open"), FileName );
+		TraceSpan Opening( pTracer );
+		pFile->Open( FileName );
+		pNewFile = pFile;
+	}
 
-	pNewFile->Open( FileName );
 	mSources[FileName] = pNewFile;
 
 
@@ -219,7 +451,13 @@ void Interpreter::LoadFile( const String& FileName )
 	mpCurrentSource = pNewFile;
 
 	try{
+		//Words are only read as they're needed, so this is the tokenizing too.
+		if( pTracer ) pTracer->Begin( TRACE_LOAD, TXT("Tokenize and parse"), FileName );
+		TraceSpan Parsing( pTracer );
+
 		Parse(); //Position should be 0,0
+		//A 'return' outside of any block just ends the file.
+		mStop = false;
 	}
 	catch( ParserAnomaly E )
 	{
@@ -269,10 +507,13 @@ ReaderSource& Interpreter::GetSource( const Bookmark& Pos )
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 void Interpreter::OpenFile( const SS::String& FileName )
 {
+	RuntimeContextGuard Guard( mContext );
+
 	AssertAttachedInterface();
 	//Keep an eye on the following line.  Close wipes the global scope,
 	//and if this get incorrectly triggered, bad things will happen.
 	if( mpCurrentSource ) Close();
+	ResetBudget();
 	LoadFile( FileName );	
 }
 
@@ -280,10 +521,15 @@ void Interpreter::OpenFile( const SS::String& FileName )
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 void Interpreter::Close()
 {
+	Start( BlockPtr() );
 	mBlockOrder.clear();
 	mSources.clear();
 	mpCurrentSource.reset();
 	mpGlobalScope->Clear();
+	
+	//The blocks are gone, and new ones may turn up at the same addresses.
+	mMemo.Clear();
+	mProfiler.Forget();
 }
 
 
@@ -292,6 +538,8 @@ void Interpreter::Close()
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 void Interpreter::Parse( const String& BlockName )
 {
+	RuntimeContextGuard Guard( mContext );
+
 	//Attempt to find the block
 	ScopeObjectPtr pBlockHopeful = GetScopeObject( MakeCompoundID( BlockName ) );
 
@@ -306,7 +554,139 @@ void Interpreter::Parse( const String& BlockName )
 void Interpreter::Parse( BlockPtr pBlock, bool SayBlock /*=true*/,
 						 VariableBasePtr In /*= VariableBasePtr()*/ )
 {
+	RuntimeContextGuard Guard( mContext );
+
+	try{
+	if( !SayBlock )
+	{
+		if( mMemoizeBlocks ) RunBlockMemoized( pBlock, In );
+		else                 RunBlock( pBlock, In );
+		return;
+	}
+
+	//Say each line in turn, letting the interface pick whenever there
+	//is more than one way to go.
+	BlockList Choices;
+	while( pBlock )
+	{
+		SayLine( pBlock, Choices );
+
+		unsigned int Choice = 0;
+		if( Choices.size() > 1 )
+		{
+			Tracer* pTracer = GetActiveTracer();
+			if( pTracer ) pTracer->Begin( TRACE_CHOICE, TXT("PresentChoice") );
+			TraceSpan Waiting( pTracer );
+
+			Choice = mpInterface->PresentChoice( Choices );
+		}
+
+		pBlock = ChooseLine( Choices, Choice );
+	}
+
+	}
+	catch( ParserAnomaly E )
+	{
+		TackOnScriptInfo( E );
+		throw E;
+	}
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::Start( const String& BlockName )
+{
+	RuntimeContextGuard Guard( mContext );
+
+	//This will throw if it is not a Block.
+	Start( GetScopeObject( MakeCompoundID( BlockName ) )->CastToBlock() );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::Start( BlockPtr pBlock )
+{
+	mpNextLine = pBlock;
+	mPendingChoices.clear();
+	mStepState = pBlock ? STEP_RUNNING : STEP_FINISHED;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+StepState Interpreter::Step()
+{
+	if( mStepState != STEP_RUNNING ) return mStepState;
+
+	RuntimeContextGuard Guard( mContext );
+
 	try{
+		BlockPtr pBlock = mpNextLine;
+		mpNextLine.reset();
+
+		SayLine( pBlock, mPendingChoices );
+
+		if( mPendingChoices.size() > 1 )
+		{
+			mStepState = STEP_CHOICE;
+			if( mTracing ) mChoiceTime = mTracer.GetTime();
+		}
+		else
+		{
+			mpNextLine = ChooseLine( mPendingChoices, 0 );
+			mPendingChoices.clear();
+			if( !mpNextLine ) mStepState = STEP_FINISHED;
+		}
+	}
+	catch( ParserAnomaly E )
+	{
+		//There is no picking up after this.
+		mpNextLine.reset();
+		mPendingChoices.clear();
+		mStepState = STEP_FINISHED;
+
+		TackOnScriptInfo( E );
+		throw E;
+	}
+
+	return mStepState;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::ResumeWithChoice( unsigned int Index )
+{
+	RuntimeContextGuard Guard( mContext );
+
+	if( mStepState != STEP_CHOICE ){
+		ThrowParserAnomaly( TXT("There is no choice waiting to be made."), ANOMALY_PANIC );
+	}
+
+	//If this throws, the choice is still waiting.
+	mpNextLine = ChooseLine( mPendingChoices, Index );
+	mPendingChoices.clear();
+
+	if( mTracing ) mTracer.Complete( TRACE_CHOICE, TXT("Waiting for a choice"), mChoiceTime );
+	mStepState = mpNextLine ? STEP_RUNNING : STEP_FINISHED;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+StepState Interpreter::GetStepState() const
+{
+	return mStepState;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+const BlockList& Interpreter::GetPendingChoices() const
+{
+	return mPendingChoices;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::RunBlock( BlockPtr pBlock, VariableBasePtr In )
+{
 	if( mVerboseOutput )
 	{
 		String tmp = TXT("Trying to parse block \"");
@@ -317,7 +697,33 @@ void Interpreter::Parse( BlockPtr pBlock, bool SayBlock /*=true*/,
 		mpInterface->LogMessage( tmp );
 	}
 
-	Bookmark OldPos = GetCurrentPos();
+	if( mMaxCallDepth && mCallStack.size() >= mMaxCallDepth )
+	{
+		ThrowParserAnomaly( String( TXT("Blocks called each other more than ") ) +
+							boost::lexical_cast<String>( mMaxCallDepth ) +
+							String( TXT(" deep.") ), ANOMALY_TOODEEP );
+	}
+
+	//The outermost call marks where the native stack starts.
+	char StackHere;
+	if( mCallStack.empty() )
+	{
+		mpStackBase = &StackHere;
+		mStackLimit = NativeStackLimit;
+	}
+
+	//This is how the magical instance system works.
+	//Every time a block gets executed it gets this temporary instance
+	//scope, which all non-statics get created on.  They are kept from
+	//call to call, one for each depth of the call stack.
+	FrameSlot& Slot = GetFrameSlot( mCallStack.size(), In );
+
+	mCallStack.push_back( CallFrame() );
+	CallFrame* pFrame = &mCallStack.back();
+	pFrame->pBlock = pBlock;
+	pFrame->ReturnPos = GetCurrentPos();
+	pFrame->pInstance = Slot.pInstance;
+	pFrame->pOut = Slot.pOut;
     
 	//This is needed for any kind of recurssion to be possible.
 	if( pBlock == mpCurrentStaticScope && mpCurrentScope != mpCurrentStaticScope)
@@ -332,90 +738,469 @@ void Interpreter::Parse( BlockPtr pBlock, bool SayBlock /*=true*/,
 
 	Bookmark Pos = pBlock->GetFilePosition();
 	
-	//This is how the magical instance system works.
-	//Every time a block gets executed it creates this temporary instance
-	//scope, which all non-statics get created on
-	ScopePtr pInstance = CreateGeneric<Scope>();
-	ListPtr InInstance = CreateGeneric<List>( LC_Input, false );
-	VariablePtr OutInstance = CreateVariable<Variable>( LC_Output, false, String() );
-	if( In ) *InInstance = *In;
-	pInstance->Register( InInstance );
-	pInstance->Register( OutInstance );
-	
-	pBlock->Import( pInstance );
+	pBlock->Import( pFrame->pInstance );
 
 	Pos.CurrentStaticScope = pBlock;
-	Pos.CurrentScope = pInstance;
+	Pos.CurrentScope = pFrame->pInstance;
 
 
-	if( pBlock->HasBeenSaid() ) 	Parse( Pos, false, true  );
-	else                        Parse( Pos, false, false );
-		
+	ByteCodePtr pCode;
+	if( mUseByteCode ) pCode = GetByteCode( pBlock );
+
+	BlockBody Body;
+	Body.pI = this;
+	Body.pCode = ( pCode && !pCode->UseTokenWalker ) ? pCode.get() : 0;
+	Body.Pos = Pos;
+	Body.IgnoreStatic = pBlock->HasBeenSaid();
+
+	bool Profiled = mProfiling;
+	if( Profiled ) mProfiler.Enter( pBlock.get() );
+	
+	bool Traced = mTracing;
+	if( Traced ) mTracer.Begin( TRACE_BLOCK, pBlock->GetFullName() );
+
+	//pFrame isn't good past here; calls made by the block may move the stack.
+	try{
+		//Deep recursion carries on in a stack segment, rather than
+		//running off the end of the thread's stack.
+		if( NeedsNewSegment() ) RunOnNewSegment( &Interpreter::RunBlockBody, &Body );
+		else RunBlockBody( &Body );
+	}
+	catch( ParserAnomaly E )
+	{
+		//Note where it happened before the caller's position is put back.
+		TackOnScriptInfo( E );
+		if( Profiled ) mProfiler.Leave();
+		if( Traced ) mTracer.End();
+		LeaveBlock( pBlock );
+		throw E;
+	}
+	
+	if( Profiled ) mProfiler.Leave();
+	if( Traced ) mTracer.End();
+
 	//This a special little trick that the out variable does:
 	//There is a static 'out' and a 'out' that is created with each instance.
 	//When the block is finished the instanced 'out' gets copied to the static out.
 	//Trust me.  This makes sense.
-	*(pBlock->GetScopeObjectLocal( LC_Output )->CastToVariable()) = *OutInstance->CastToVariableBase();
+	*(pBlock->GetScopeObjectLocal( LC_Output )->CastToVariable()) = 
+		*mCallStack.back().pOut->CastToVariableBase();
+
+	LeaveBlock( pBlock );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::LeaveBlock( BlockPtr pBlock )
+{
+	CallFrame& Frame = mCallStack.back();
+
+	//A 'return' stops at the block it was in.
+	mStop = false;
+
+	//Now the instance gets destroyed
+	pBlock->UnImport( Frame.pInstance );
+
+	//This should also reset the scopes
+	Bookmark ReturnPos = Frame.ReturnPos;
+	mCallStack.pop_back();
+	SetPos( ReturnPos );
+
+	//The next outermost call may well start somewhere else on the stack.
+	if( mCallStack.empty() ) mpStackBase = 0;
+
+	//ReImport the old instance
+	if( pBlock == mpCurrentStaticScope && mpCurrentScope != mpCurrentStaticScope ){
+		mpCurrentStaticScope->Import( mpCurrentScope );
+	}
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::RunBlockMemoized( BlockPtr pBlock, VariableBasePtr In )
+{
+	if( !IsPureBlock( pBlock ) )
+	{
+		RunBlock( pBlock, In );
+		return;
+	}
+	
+	String Key;
+	MemoCache::MakeKey( In, Key );
+	
+	VariablePtr pStaticOut = pBlock->GetScopeObjectLocal( LC_Output )->CastToVariable();
+	std::vector<Block*> Callees = mMemo.GetCallees( pBlock.get() );
+	size_t i;
+	
+	const MemoCache::Result* pResult = mMemo.Find( pBlock.get(), Key );
+	if( pResult )
+	{
+		//Just what RunBlock would have left behind, in its own 'out' and
+		//in those of the blocks it called.
+		*pStaticOut = *pResult->pOut->CastToVariableBase();
+		for( i = 0; i < Callees.size(); i++ ){
+			*Callees[i]->GetScopeObjectLocal( LC_Output )->CastToVariable() =
+				*pResult->CalleeOuts[i]->CastToVariableBase();
+		}
+		
+		//Still a call, as far as the profile is concerned.
+		if( mProfiling )
+		{
+			mProfiler.Enter( pBlock.get() );
+			mProfiler.Leave();
+		}
+		if( mTracing ) mTracer.Instant( TRACE_BLOCK, pBlock->GetFullName() + TXT(" (remembered)") );
+		return;
+	}
+	
+	RunBlock( pBlock, In );
+	
+	std::vector<VariablePtr> CalleeOuts( Callees.size() );
+	for( i = 0; i < Callees.size(); i++ ){
+		CalleeOuts[i] = Callees[i]->GetScopeObjectLocal( LC_Output )->CastToVariable();
+	}
+	
+	mMemo.Insert( pBlock.get(), Key, *pStaticOut, CalleeOuts, mContext.GetLangOpts().MemoCacheSize );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool Interpreter::IsPureBlock( BlockPtr pBlock )
+{
+	MemoCache::Purity P = mMemo.GetPurity( pBlock.get() );
+	if( P != MemoCache::PURITY_UNKNOWN ) return P == MemoCache::PURITY_PURE;
+	
+	std::vector<const Block*> Assumed;
+	std::map< const Block*, std::vector<Block*> > Calls;
+	bool Pure = CheckPurity( pBlock, Assumed, Calls );
+	
+	//Everything looked at was only pure if the whole lot was.  If not,
+	//the blocks it called get looked at again on their own.
+	if( Pure )
+	{
+		std::vector<Block*> Callees;
+		size_t i;
+		for( i = 0; i < Assumed.size(); i++ )
+		{
+			Callees.clear();
+			GatherCallees( Assumed[i], Calls, Callees );
+			
+			//Its own 'out' is kept anyway.
+			Callees.erase( std::remove( Callees.begin(), Callees.end(), Assumed[i] ), Callees.end() );
+			
+			mMemo.SetCallees( Assumed[i], Callees );
+			mMemo.SetPurity( Assumed[i], MemoCache::PURITY_PURE );
+		}
+	}
+	else mMemo.SetPurity( pBlock.get(), MemoCache::PURITY_IMPURE );
+	
+	return Pure;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool Interpreter::CheckPurity( BlockPtr pBlock, std::vector<const Block*>& Assumed,
+								std::map< const Block*, std::vector<Block*> >& Calls )
+{
+	static const SymbolID InputSymbol = Intern( LC_Input );
+	static const SymbolID OutputSymbol = Intern( LC_Output );
+	static const SymbolID NextSymbol = Intern( LC_NextBlock );
+	
+	if( std::find( Assumed.begin(), Assumed.end(), pBlock.get() ) != Assumed.end() ) return true;
+	
+	MemoCache::Purity P = mMemo.GetPurity( pBlock.get() );
+	if( P != MemoCache::PURITY_UNKNOWN ) return P == MemoCache::PURITY_PURE;
+	
+	Assumed.push_back( pBlock.get() );
+	
+	//Only compiled bodies are looked at.  Statics and declared blocks
+	//outlive the call, so they rule a block out straight away.
+	ByteCodePtr pCode = GetByteCode( pBlock );
+	if( pCode->UseTokenWalker || !pCode->Declarations.empty() ) return false;
+	
+	//Find the block's own non-statics first.
+	std::vector<SymbolID> Locals;
+	CompoundSymbol Symbols;
+	size_t i, j;
+	for( i = 0; i < pCode->Instructions.size(); i++ )
+	{
+		const Instruction& Inst = pCode->Instructions[i];
+		if( Inst.Op == OP_SKIPSTATIC || Inst.Op == OP_DECLAREBLOCK ) return false;
+		if( !Inst.pExpression ) continue;
+		
+		const Expression& E = *Inst.pExpression;
+		for( j = 0; j < E.size(); j++ )
+		{
+			if( E[j].Extra == EXTRA_UNOP_Character || E[j].Extra == EXTRA_UNOP_Player ) return false;
+			
+			if( (E[j].Extra == EXTRA_UNOP_Var || E[j].Extra == EXTRA_UNOP_List) &&
+				j + 1 < E.size() && E[j+1].Type == WORDTYPE_IDENTIFIER )
+			{
+				if( !E[j+1].Sym.empty() ) Locals.push_back( E[j+1].Sym[0] );
+				else Locals.push_back( Intern( E[j+1].Str[0] ) );
+			}
+		}
+	}
+	
+	//Now make sure everything else it names is harmless.
+	for( i = 0; i < pCode->Instructions.size(); i++ )
+	{
+		const Instruction& Inst = pCode->Instructions[i];
+		if( !Inst.pExpression ) continue;
+		
+		const Expression& E = *Inst.pExpression;
+		for( j = 0; j < E.size(); j++ )
+		{
+			const Word& W = E[j];
+			if( W.Type != WORDTYPE_IDENTIFIER ) continue;
+			
+			if( !W.Sym.empty() ) Symbols = W.Sym;
+			else if( !SymbolTable::Instance().Find( W.Str, Symbols ) ) return false;
+			
+			if( Symbols[0] == InputSymbol || Symbols[0] == OutputSymbol ||
+				std::find( Locals.begin(), Locals.end(), Symbols[0] ) != Locals.end() ) continue;
+			
+			//'next = somewhere;' does the same thing every time.
+			if( Symbols[0] == NextSymbol && Symbols.size() == 1 )
+			{
+				if( j == 0 && E.size() == 3 && E[1].Extra == EXTRA_BINOP_Assign &&
+					E[2].Type == WORDTYPE_IDENTIFIER )
+				{
+					j += 2;
+					continue;
+				}
+				return false;
+			}
+			
+			if( Symbols.size() > 1 ) return false;
+			
+			//Look it up the way the block would see it.
+			ScopeObjectPtr pObject;
+			ScopePtr pScope = pBlock;
+			while( pScope && !(pObject = pScope->GetScopeObject_NoThrow( Symbols )) ){
+				pScope = pScope->GetParent();
+			}
+			if( !pObject ) return false;
+			
+			ScopeObjectType T = GetScopeObjectType( pObject );
+			if( T == SCOPEOBJ_BLOCK )
+			{
+				BlockPtr pCallee = pObject->CastToBlock();
+				Calls[pBlock.get()].push_back( pCallee.get() );
+				if( !CheckPurity( pCallee, Assumed, Calls ) ) return false;
+			}
+			else if( (T == SCOPEOBJ_VARIABLE || T == SCOPEOBJ_LIST) && pObject->IsConst() ) continue;
+			else if( dynamic_cast<SLib::Math*>( pObject->GetParent().get() ) ) continue;
+			else return false;
+		}
+	}
+	
+	return true;
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: Blocks that were already known to be pure weren't looked at again,
+		so what they call comes from the cache instead.
+*/
+void Interpreter::GatherCallees( const Block* pBlock,
+								 const std::map< const Block*, std::vector<Block*> >& Calls,
+								 std::vector<Block*>& Callees )
+{
+	std::map< const Block*, std::vector<Block*> >::const_iterator i = Calls.find( pBlock );
+	const std::vector<Block*>& Direct = i != Calls.end() ? i->second : mMemo.GetCallees( pBlock );
+	
+	size_t j;
+	for( j = 0; j < Direct.size(); j++ )
+	{
+		if( std::find( Callees.begin(), Callees.end(), Direct[j] ) != Callees.end() ) continue;
+		
+		Callees.push_back( Direct[j] );
+		GatherCallees( Direct[j], Calls, Callees );
+	}
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Interpreter::FrameSlot& Interpreter::GetFrameSlot( size_t Depth, VariableBasePtr In )
+{
+	static const SymbolID InputSymbol = Intern( LC_Input );
+	static const SymbolID OutputSymbol = Intern( LC_Output );
+	
+	if( Depth == mFramePool.size() ) mFramePool.push_back( FrameSlot() );
+	FrameSlot& Slot = mFramePool[Depth];
+	
+	//The last instance can only be used again if nothing else has hold of
+	//it.  (Blocks declared in it do, for one.)  The pool's own pointers, and
+	//the instance's for 'in' and 'out', are the only ones allowed.
+	if( Slot.pInstance && Slot.pInstance->GetRefCount() == 1 &&
+		Slot.pIn->GetRefCount() == 2 && Slot.pOut->GetRefCount() == 2 )
+	{
+		//Get rid of the non-statics the last call made.
+		Slot.pInstance->ClearExcept( InputSymbol, OutputSymbol );
+		
+		//List assignment reuses the elements already there, which is fine
+		//as long as nothing else has hold of them.
+		ListType& OldIn = Slot.pIn->GetInternalList();
+		size_t i;
+		for( i = 0; i < OldIn.size(); i++ ){
+			if( OldIn[i]->GetRefCount() != 1 ){
+				OldIn.clear();
+				break;
+			}
+		}
+		
+		if( In ) *Slot.pIn = *In;
+		else     OldIn.clear();
+		
+		*Slot.pOut = *RuntimeContext::Current().GetEmptyStringConst()->CastToVariableBase();
+	}
+	else
+	{
+		Slot.pInstance = CreateGeneric<Scope>();
+		Slot.pIn = CreateGeneric<List>( LC_Input, false );
+		Slot.pOut = CreateVariable<Variable>( LC_Output, false, String() );
+		Slot.pInstance->Register( Slot.pIn );
+		Slot.pInstance->Register( Slot.pOut );
+		
+		if( In ) *Slot.pIn = *In;
+	}
+	
+	return Slot;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::RunBlockBody( void* pBody )
+{
+	BlockBody& Body = *(BlockBody*)pBody;
+	Interpreter& I = *Body.pI;
+
+	if( Body.pCode ) I.Run( *Body.pCode, Body.Pos, Body.IgnoreStatic );
+	else             I.Parse( Body.Pos, false, Body.IgnoreStatic );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::ParseOnSegment( void* pCall )
+{
+	ParseCall& Call = *(ParseCall*)pCall;
+	Call.pI->Parse( Call.Pos, Call.OneStatement, Call.IgnoreStatic );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::RunOnNewSegment( StackSegment::Function F, void* pArg )
+{
+	if( mMaxStackSegments && mSegmentDepth >= mMaxStackSegments )
+	{
+		ThrowParserAnomaly( String( TXT("The script went too deep to fit in ") ) +
+							boost::lexical_cast<String>( mMaxStackSegments ) +
+							String( TXT(" stack segments.") ), ANOMALY_TOODEEP );
+	}
+
+	if( mSegmentDepth == mStackSegments.size() ){
+		mStackSegments.push_back( boost::shared_ptr<StackSegment>( new StackSegment( StackSegmentSize ) ) );
+	}
+
+	StackSegment& Segment = *mStackSegments[mSegmentDepth];
+	char* pOldStackBase = mpStackBase;
+	size_t OldStackLimit = mStackLimit;
+	mSegmentDepth++;
+
+	SegmentCall Call;
+	Call.pI = this;
+	Call.F = F;
+	Call.pArg = pArg;
+	try{
+		Segment.Run( &Interpreter::EnterSegment, &Call );
+	}
+	catch( ParserAnomaly E )
+	{
+		LeaveSegment( pOldStackBase, OldStackLimit );
+		throw E;
+	}
+
+	LeaveSegment( pOldStackBase, OldStackLimit );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::EnterSegment( void* pCall )
+{
+	SegmentCall& Call = *(SegmentCall*)pCall;
+	Interpreter& I = *Call.pI;
+
+	char StackHere;
+	I.mpStackBase = &StackHere;
+	I.mStackLimit = StackSegmentSize - StackSegmentReserve;
 
-	//Now the instance gets destroyed
-	pBlock->UnImport( pInstance );
-	pInstance.reset();
+	Call.F( Call.pArg );
+}
 
-	//This should also reset the scopes
-	SetPos( OldPos );
 
-	//ReImport the old instance
-	if( pBlock == mpCurrentStaticScope && mpCurrentScope != mpCurrentStaticScope ){
-		mpCurrentStaticScope->Import( mpCurrentScope );
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: The segment just left is kept, so a call that goes back and forth
+		across the line doesn't allocate every time.  Any deeper ones were
+		only needed by calls that have all returned, so they are freed.
+*/
+void Interpreter::LeaveSegment( char* pOldStackBase, size_t OldStackLimit )
+{
+	mSegmentDepth--;
+	mpStackBase = pOldStackBase;
+	mStackLimit = OldStackLimit;
+
+	if( mStackSegments.size() > mSegmentDepth + 1 ){
+		mStackSegments.resize( mSegmentDepth + 1 );
 	}
+}
 
-	if( !SayBlock ) return;
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::SayLine( BlockPtr pBlock, BlockList& Next )
+{
+	ResetBudget();
+	RunBlock( pBlock, VariableBasePtr() );
 
 	//... and Say the block
 	mpInterface->SayBlock( pBlock );
 	pBlock->SetBeenSaid();
 
-	
-
 
 	//Now figure out what block to say next
+	Next.clear();
 	ListPtr pNextLine = pBlock->GetScopeObjectLocal( LC_NextBlock )->CastToList();
 
 	//Create a list of a actual choices.  Throw out bad values.
 	const ListType& OrigChoices = pNextLine->GetInternalList();
-	std::vector<BlockPtr> GoodChoices;
 	
-    unsigned int i;
+	unsigned int i;
 	for( i = 0; i < OrigChoices.size(); i ++ )
 	{
-		GoodChoices.push_back( GetScopeObject( 
+		Next.push_back( GetScopeObject( 
 				MakeCompoundID( OrigChoices[i]->GetStringData() ) )->CastToBlock() );
 	}
 
-    if( GoodChoices.size() != 0 )
-	{
-		//TODO: Discard non-player choices (maybe?)
-		if( GoodChoices.size() > 1 )
-		{
-			BlockPtr pChoice = GoodChoices[ mpInterface->PresentChoice( GoodChoices ) ];
-			if( pChoice->GetFullName() == mpEndBlock->GetFullName() ) return;
-			else Parse( pChoice );
-		}
-		else if( GoodChoices[0]->GetFullName() == mpEndBlock->GetFullName() ) return;
-		else Parse( GoodChoices[0] );
-	}
-	else if( pBlock->GetListIndex() < mBlockOrder.size() - 1 )
+	//TODO: Discard non-player choices (maybe?)
+	if( Next.empty() && pBlock->GetListIndex() < mBlockOrder.size() - 1 )
 	{
-		Parse( mBlockOrder[pBlock->GetListIndex() + 1] );
+		Next.push_back( mBlockOrder[pBlock->GetListIndex() + 1] );
 	}
 	//else Nothing left to say I guess.
+}
 
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+BlockPtr Interpreter::ChooseLine( const BlockList& Choices, unsigned int Index )
+{
+	if( Choices.empty() ) return BlockPtr();
+
+	if( Index >= Choices.size() ){
+		ThrowParserAnomaly( TXT("Choice index is out of range."), ANOMALY_NOLISTELEMENT );
 	}
-	catch( ParserAnomaly E )
-	{
-		TackOnScriptInfo( E );
-		throw E;
-	}
+
+	if( Choices[Index]->GetFullName() == mpEndBlock->GetFullName() ) return BlockPtr();
+	else return Choices[Index];
 }
 
 
@@ -428,6 +1213,18 @@ void Interpreter::Parse( Bookmark Pos /*Bookmark()*/,
 	if( mVerboseOutput ) mpInterface->LogMessage( TXT("PARSING...\n") );
 
 	if( Pos.IsVoid() ) Pos = GetCurrentPos();	
+	
+	//Bodies nested deep enough carry on in a new segment, like deep calls.
+	if( NeedsNewSegment() )
+	{
+		ParseCall Call;
+		Call.pI = this;
+		Call.Pos = Pos;
+		Call.OneStatement = OneStatement;
+		Call.IgnoreStatic = IgnoreStatic;
+		RunOnNewSegment( &Interpreter::ParseOnSegment, &Call );
+		return;
+	}
 	ReaderSource& MySource = GetSource( Pos );
 	
 	ExpressionPtr pExpression;
@@ -443,14 +1240,15 @@ void Interpreter::Parse( Bookmark Pos /*Bookmark()*/,
 	while( true )
 	{
 		/*
-			When blocks call return this flag gets set and the interpreter ends parsing.
+			When blocks call return this flag gets set and we leave the block,
+			not just the innermost {}.  Every Parse on the way out sees it,
+			and LeaveBlock clears it.
 		*/
-		if( mStop )
-		{
-			while( MySource.GetNextWord().Extra != EXTRA_BRACKET_Right ){}
-			mStop = false;	
-		}		
+		if( mStop ) return;
 		
+		CountStatement();
+		
+
 		/*
 			Grab the next word.
 		*/
@@ -473,6 +1271,8 @@ void Interpreter::Parse( Bookmark Pos /*Bookmark()*/,
  			continue; 
  		}	
  		
+ 		if( mLineProfiling ) mLineProfiler.CountStatement( MySource.GetName(), MySource.GetLineNumber() );
+ 		
  		//If
  		if( pTempWord->Extra == EXTRA_CONTROL_If )
  		{
@@ -569,6 +1369,8 @@ void Interpreter::Parse( Bookmark Pos /*Bookmark()*/,
  			pTempWord = &MySource.GetNextWord();
  			if( pTempWord->Extra == EXTRA_BRACKET_Left )
  			{
+ 				ReaderPos LeftBracketPos = MySource.GetPos() - 1;
+ 				
  				pTempWord = &MySource.GetNextWord();
 				if( pTempWord->Type == WORDTYPE_DOCString )
 				{
@@ -587,25 +1389,7 @@ void Interpreter::Parse( Bookmark Pos /*Bookmark()*/,
 				}
 				
 				//Now we have to skip to the end }
-				unsigned long BracketCount = 1;
-				do{
-					pTempWord = &MySource.GetNextWord();
-					if( pTempWord->Extra == EXTRA_BRACKET_Left ) BracketCount++;
-					else if( pTempWord->Extra == EXTRA_BRACKET_Right ) BracketCount--;					
-				}
-				while( BracketCount > 0 );	
-				
-				
-				
-				/*
-				unsigned long BracketCount;
-				NextWord = MySource.GetNextWord();
-				for( BracketCount = 1; BracketCount > 0; NextWord = MySource.GetNextWord() )
-				{
-					if( NextWord.Extra == EXTRA_BRACKET_Left ) BracketCount++;
-					else if( NextWord.Extra == 	EXTRA_BRACKET_Right ) BracketCount--;
-				}
-				*/
+				MySource.GotoPos( MySource.GetMatchingBracket( LeftBracketPos ) + 1 );
  				
  				if( OneStatement ) return;
  				else continue;
@@ -647,12 +1431,23 @@ Interpreter::ExpressionPtr Interpreter::GetNextExpression( ReaderSource& MySourc
 		return i->second.MyExp;
 	}
 	
+	Tracer* pTracer = GetActiveTracer();
+	if( pTracer ){
+		pTracer->Begin( TRACE_EXPRESSION, TXT("Expression cache miss"), MySource.GetName(), MySource.GetLineNumber() );
+	}
+	TraceSpan Reading( pTracer );
+	
 	ExpressionPtr NextExpression( new Expression( *this ) );
 			
 	while( true )
 	{
 		pTempWord = &MySource.GetNextWord();
 		
+		//Now that we're past any blank lines, we know where it starts.
+		if( NextExpression->empty() ){
+			NextExpression->SetLocation( MySource.GetName(), MySource.GetLineNumber() );
+		}
+		
 		if( pTempWord->Type == WORDTYPE_IDENTIFIER ||
 			pTempWord->Type == WORDTYPE_FLOATLITERAL ||
 			pTempWord->Type == WORDTYPE_StringLITERAL ||
@@ -695,21 +1490,13 @@ bool Interpreter::ParseIf( const Expression& Condition,
 	{
 		//Fast forward to the end of the statement.
 		ReaderSource& FileRef = GetSource( Body );
-		const Word* pTempWord;
-		while( pTempWord->Type != WORDTYPE_TERMINAL ) pTempWord = &FileRef.GetNextWord();
+		FileRef.GotoPos( FileRef.GetNextTerminal( Body.Position ) + 1 );
 	}
 	else
 	{
-		//Fast forward to the end of the body
+		//Fast forward to the end of the body.  (The body starts just after the '{'.)
 		ReaderSource& FileRef = GetSource( Body );
-		unsigned int BracketCount = 1;
-		const Word* pTempWord;
-		while( BracketCount )
-		{
-			pTempWord = &FileRef.GetNextWord();
-			if     ( pTempWord->Extra == EXTRA_BRACKET_Left ) BracketCount++;
-			else if( pTempWord->Extra == EXTRA_BRACKET_Right ) BracketCount--;
-		}
+		FileRef.GotoPos( FileRef.GetMatchingBracket( Body.Position - 1 ) + 1 );
 	}
 
 	return WasParsed;
@@ -734,25 +1521,292 @@ bool Interpreter::ParseWhile( const Expression& Condition,
 	{
 		//Fast forward to the end of the statement.
 		ReaderSource& FileRef = GetSource( Body );
-		const Word* pTempWord;
-		while( pTempWord->Type != WORDTYPE_TERMINAL ) pTempWord = &FileRef.GetNextWord();
+		FileRef.GotoPos( FileRef.GetNextTerminal( Body.Position ) + 1 );
 	}
 	else if( !WasParsed )
 	{
-
-		//Fast forward to the end of the body
+		//Fast forward to the end of the body.  (The body starts just after the '{'.)
 		ReaderSource& FileRef = GetSource( Body );
-		unsigned int BracketCount = 1;
-		
-		while( BracketCount )
+		FileRef.GotoPos( FileRef.GetMatchingBracket( Body.Position - 1 ) + 1 );
+	}
+
+	return WasParsed;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ByteCodePtr Interpreter::GetByteCode( BlockPtr pBlock )
+{
+	if( !pBlock->GetByteCode() )
+	{
+		Bookmark OldPos = GetCurrentPos();
+
+		pBlock->SetByteCode( CompileByteCode( GetSource( pBlock->GetFilePosition() ) ) );
+
+		SetPos( OldPos );
+	}
+
+	return pBlock->GetByteCode();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ByteCodePtr Interpreter::CompileByteCode( ReaderSource& MySource )
+{
+	boost::shared_ptr<ByteCode> pCode( new ByteCode );
+	ReaderPos Start = MySource.GetPos();
+
+	try{
+		CompileBody( MySource, *pCode );
+		pCode->Instructions.push_back( Instruction( OP_RETURN, MySource.GetPos() ) );
+	}
+	catch( ParserAnomaly )
+	{
+		//Anything the compiler doesn't understand is left for Parse
+		//to deal with (or complain about) when it gets there.
+		pCode->Instructions.clear();
+		pCode->Declarations.clear();
+		pCode->UseTokenWalker = true;
+
+		MySource.GotoPos( Start );
+		FastForwardPastBody( MySource );
+	}
+
+	return pCode;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::CompileBody( ReaderSource& MySource, ByteCode& Code )
+{
+	while( CompileStatement( MySource, Code, true ) ){}
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool Interpreter::CompileStatement( ReaderSource& MySource, ByteCode& Code, bool TakeElse )
+{
+	//Words are copied, because the buffer they live in grows while we read.
+	Word FirstWord = MySource.GetNextWord();
+
+	if( FirstWord == EOF_WORD ) ThrowUnexpectedEOF();
+
+	//End of the body
+	if( FirstWord.Extra == EXTRA_BRACKET_Right ) return false;
+
+	//Parse just returns when it finds a stray '{'.  There is no sense in copying that.
+	if( FirstWord.Extra == EXTRA_BRACKET_Left ){
+		ThrowParserAnomaly( TXT("Found \'{\' where a statement was expected."), ANOMALY_BADGRAMMAR );
+	}
+
+	if( FirstWord.Extra == EXTRA_CONTROL_Else ){
+		ThrowParserAnomaly( TXT("Found an \'else\' without a matching \'if\' or \'while\'."), ANOMALY_BADGRAMMAR );
+	}
+
+	//Static
+	if( FirstWord.Extra == EXTRA_CONTROL_Static )
+	{
+		size_t SkipIndex = Code.Instructions.size();
+		Code.Instructions.push_back( Instruction( OP_SKIPSTATIC, MySource.GetPos() ) );
+
+		if( !CompileStatement( MySource, Code, TakeElse ) ){
+			ThrowParserAnomaly( TXT("Expected a statement after \'static\'."), ANOMALY_BADGRAMMAR );
+		}
+
+		Code.Instructions[SkipIndex].Arg = Code.Instructions.size();
+		return true;
+	}
+
+	//If and While
+	if( FirstWord.Extra == EXTRA_CONTROL_If || FirstWord.Extra == EXTRA_CONTROL_While )
+	{
+		ExpressionPtr pCondition = GetNextExpression( MySource );
+
+		Word NextWord = MySource.GetNextWord();
+		bool OneStatement = false;
+		if( NextWord == EOF_WORD ) ThrowUnexpectedEOF();
+		else if( NextWord.Extra == EXTRA_CONTROL_Do ) OneStatement = true;
+		else if( NextWord.Extra != EXTRA_BRACKET_Left )
+		{
+			ThrowParserAnomaly( TXT("Malformed \'if\' statement."), ANOMALY_BADGRAMMAR );
+		}
+
+		size_t FalseJump = Code.Instructions.size();
+		Code.Instructions.push_back( Instruction( OP_JUMPIFFALSE, MySource.GetPos(), pCondition ) );
+
+		size_t BodyIndex = Code.Instructions.size();
+		if( OneStatement )
 		{
-			const Word* pTempWord = &FileRef.GetNextWord();
-			if     ( pTempWord->Extra == EXTRA_BRACKET_Left ) BracketCount++;
-			else if( pTempWord->Extra == EXTRA_BRACKET_Right ) BracketCount--;
+			if( !CompileStatement( MySource, Code, false ) ){
+				ThrowParserAnomaly( TXT("Expected a statement after \'then\'."), ANOMALY_BADGRAMMAR );
+			}
 		}
+		else CompileBody( MySource, Code );
+
+		//Loops are checked again at the bottom.
+		if( FirstWord.Extra == EXTRA_CONTROL_While ){
+			Code.Instructions.push_back( Instruction( OP_JUMPIFTRUE, MySource.GetPos(), pCondition, BodyIndex ) );
+		}
+
+		CompileElse( MySource, Code, FalseJump, TakeElse );
+		return true;
 	}
 
-	return WasParsed;
+	//Block declarations
+	if( FirstWord.Type == WORDTYPE_IDENTIFIER )
+	{
+		if( MySource.GetNextWord().Extra == EXTRA_BRACKET_Left )
+		{
+			BlockDeclaration NewBlock;
+			NewBlock.Id = FirstWord.Str;
+
+			Word NextWord = MySource.GetNextWord();
+			if( NextWord.Type == WORDTYPE_DOCString )
+			{
+				NewBlock.HasDocString = true;
+				NewBlock.DocString = NextWord.Str[0];
+			}
+			else MySource.PutBackWord();
+
+			Code.Instructions.push_back(
+				Instruction( OP_DECLAREBLOCK, MySource.GetPos(), ExpressionPtr(), Code.Declarations.size() ) );
+
+			//The nested block's body gets compiled along with ours.
+			NewBlock.pCode = CompileByteCode( MySource );
+			Code.Declarations.push_back( NewBlock );
+
+			return true;
+		}
+		else MySource.PutBackWord();
+	}
+
+	//Otherwise it's an expression.
+	MySource.PutBackWord();
+	ExpressionPtr pExpression = GetNextExpression( MySource );
+	ReaderPos Pos = MySource.GetPos();
+
+	if( MySource.GetNextWord().Type != WORDTYPE_TERMINAL )
+	{
+		ThrowParserAnomaly( TXT("Missing \';\' at the end of this expression."), ANOMALY_BADPUNCTUATION );
+	}
+
+	Code.Instructions.push_back( Instruction( OP_EVAL, Pos, pExpression ) );
+	return true;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::CompileElse( ReaderSource& MySource, ByteCode& Code,
+							   size_t FalseJump, bool TakeElse )
+{
+	//Inside an 'if ... then' the else belongs to the outer conditional.
+	if( !TakeElse || MySource.GetNextWord().Extra != EXTRA_CONTROL_Else )
+	{
+		if( TakeElse ) MySource.PutBackWord();
+		Code.Instructions[FalseJump].Arg = Code.Instructions.size();
+		return;
+	}
+
+	//When the conditional went through, jump over the else statement.
+	size_t SkipIndex = Code.Instructions.size();
+	Code.Instructions.push_back( Instruction( OP_JUMP, MySource.GetPos() ) );
+
+	Code.Instructions[FalseJump].Arg = Code.Instructions.size();
+
+	Word NextWord = MySource.GetNextWord();
+	if( NextWord.Extra == EXTRA_BRACKET_Left ) CompileBody( MySource, Code );
+	else
+	{
+		//Go ahead and suck up a do/then if its there.
+		if( NextWord.Extra != EXTRA_CONTROL_Do ) MySource.PutBackWord();
+
+		if( !CompileStatement( MySource, Code, TakeElse ) ){
+			ThrowParserAnomaly( TXT("Expected a statement after \'else\'."), ANOMALY_BADGRAMMAR );
+		}
+	}
+
+	Code.Instructions[SkipIndex].Arg = Code.Instructions.size();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::Run( const ByteCode& Code, const Bookmark& Pos, bool IgnoreStatic )
+{
+	if( mVerboseOutput ) mpInterface->LogMessage( TXT("RUNNING...\n") );
+
+	ReaderSource& MySource = GetSource( Pos );
+
+	const Instruction* pFirst = &Code.Instructions[0];
+	const Instruction* pCurrent = pFirst;
+
+	while( true )
+	{
+		switch( pCurrent->Op )
+		{
+		case OP_EVAL:
+			//The position is only kept up to date so errors report the right line.
+			MySource.GotoPos( pCurrent->Pos );
+			if( mLineProfiling ){
+				mLineProfiler.CountStatement( MySource.GetName(), pCurrent->pExpression->GetLine() );
+			}
+			pCurrent->pExpression->Evaluate();
+			pCurrent++;
+			break;
+
+		case OP_JUMP:
+			pCurrent = pFirst + pCurrent->Arg;
+			continue;
+
+		case OP_JUMPIFFALSE:
+			MySource.GotoPos( pCurrent->Pos );
+			if( pCurrent->pExpression->Evaluate()->GetBoolData() == true ) pCurrent++;
+			else pCurrent = pFirst + pCurrent->Arg;
+			break;
+
+		case OP_JUMPIFTRUE:
+			MySource.GotoPos( pCurrent->Pos );
+			if( pCurrent->pExpression->Evaluate()->GetBoolData() == true ) pCurrent = pFirst + pCurrent->Arg;
+			else pCurrent++;
+			break;
+
+		case OP_SKIPSTATIC:
+			if( IgnoreStatic ) pCurrent++;
+			else pCurrent = pFirst + pCurrent->Arg;
+			continue;
+
+		case OP_DECLAREBLOCK:
+			{
+			const BlockDeclaration& Decl = Code.Declarations[pCurrent->Arg];
+
+			//MakeScopeObject takes the block's position from the source.
+			MySource.GotoPos( pCurrent->Pos );
+			BlockPtr pNewBlock = MakeScopeObject( SCOPEOBJ_BLOCK, Decl.Id )->CastToBlock();
+			if( Decl.HasDocString ) pNewBlock->GetDocString() = Decl.DocString;
+			pNewBlock->SetByteCode( Decl.pCode );
+
+			if( mVerboseOutput ){
+				mpInterface->LogMessage( String(TXT("Registered new block: \'")) + CollapseCompoundString(Decl.Id) + String(TXT("\'.\n")) );
+			}
+
+			pCurrent++;
+			}
+			continue;
+
+		case OP_RETURN:
+			return;
+		}
+
+		CountStatement();
+
+		/*
+			When blocks call return this flag gets set and we leave the block.
+		*/
+		if( mStop )
+		{
+			mStop = false;
+			return;
+		}
+	}
 }
 
 
@@ -760,6 +1814,8 @@ bool Interpreter::ParseWhile( const Expression& Condition,
 ScopeObjectPtr Interpreter::MakeScopeObject( ScopeObjectType Type, const CompoundString& S,
 								   bool Static /*= false*/, bool Const /*= false*/ )
  {
+	RuntimeContextGuard Guard( mContext );
+
 	ScopeObjectPtr pNewObj;
 
 	const String& Name = S[S.size()-1];
@@ -818,6 +1874,80 @@ ScopeObjectPtr Interpreter::MakeScopeObject( ScopeObjectType Type, const Compoun
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 ScopeObjectPtr Interpreter::GetScopeObject( const CompoundString& Name )
 {
+	RuntimeContextGuard Guard( mContext );
+
+	CompoundSymbol Symbols;
+	if( !SymbolTable::Instance().Find( Name, Symbols ) )
+	{
+		String tmp = TXT("Cannot find an indentifier by the name \'");
+		tmp += CollapseCompoundString( Name );
+		tmp += TXT("\'.  Check your spelling.");
+		ThrowParserAnomaly( tmp, ANOMALY_IDNOTFOUND );
+	}
+	
+	return GetScopeObject( Symbols );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ScopeObjectPtr Interpreter::GetScopeObject( const CompoundSymbol& Name )
+{
+	RuntimeContextGuard Guard( mContext );
+
+	ScopeObjectPtr pObject = GetScopeObject_NoThrow( Name );
+	if( pObject ) return pObject;
+
+	//Nothing
+	String tmp = TXT("Cannot find an indentifier by the name \'");
+	tmp += CollapseCompoundSymbol( Name );
+	tmp += TXT("\'.  Check your spelling.");
+	ThrowParserAnomaly( tmp, ANOMALY_IDNOTFOUND );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ScopeObjectPtr Interpreter::GetScopeObject_NoThrow( const CompoundSymbol& Name, ScopeResolution& R )
+{
+	if( R.IsCurrent( mpCurrentScope.get(), mpCurrentStaticScope.get(), mpCurrentSource.get() ) )
+	{
+		return R.Found ? R.Result.lock() : ScopeObjectPtr();
+	}
+	
+	R.Reset();
+	
+	//Remember every scope searched, so we know when to look again
+	ScopeTrail* pOldTrail = Scope::SetTrail( &R.Trail );
+	ScopeObjectPtr pObject;
+	try{
+		pObject = GetScopeObject_NoThrow( Name );
+	}
+	catch( ... )
+	{
+		Scope::SetTrail( pOldTrail );
+		R.Reset();
+		throw;
+	}
+	Scope::SetTrail( pOldTrail );
+	
+	R.Valid = true;
+	R.pScope = mpCurrentScope.get();
+	R.pScopeWeak = mpCurrentScope;
+	R.pStaticScope = mpCurrentStaticScope.get();
+	R.pStaticScopeWeak = mpCurrentStaticScope;
+	R.pSource = mpCurrentSource.get();
+	R.Version = Scope::GetNewestVersion();
+	R.Found = pObject.get() != 0;
+	R.Result = pObject;
+	
+	return pObject;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ScopeObjectPtr Interpreter::GetScopeObject_NoThrow( const CompoundSymbol& Name )
+{
+	RuntimeContextGuard Guard( mContext );
+
 	//Try the local scope first
 
 	ScopePtr pPotentialScope = mpCurrentScope;
@@ -858,15 +1988,7 @@ ScopeObjectPtr Interpreter::GetScopeObject( const CompoundString& Name )
 	//but not if it mpCurrentScope belongs to another scope that was imported.
 	String ScopeName( MakeScopeNameFromFileName( mpCurrentSource->GetName() ) );
 	
-	pObject = mpGlobalScope->GetScopeObject( MakeCompoundID( ScopeName ) )->CastToScope()->GetScopeObject_NoThrow( Name );
-	if( pObject ) return pObject;
-
-
-	//Nothing
-	String tmp = TXT("Cannot find an indentifier by the name \'");
-	tmp += CollapseCompoundString( Name );
-	tmp += TXT("\'.  Check your spelling.");
-	ThrowParserAnomaly( tmp, ANOMALY_IDNOTFOUND );
+	return mpGlobalScope->GetScopeObject( MakeCompoundID( ScopeName ) )->CastToScope()->GetScopeObject_NoThrow( Name );
 }
 
 
@@ -894,6 +2016,9 @@ BlockPtr Interpreter::GetBlock( const String& Name ){
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 void Interpreter::TackOnScriptInfo( ParserAnomaly& E )
 {
+	//The first place to catch it is closest to where it happened.
+	if( !E.ScriptFile.empty() ) return;
+
 	AssertSourceOpen();
 
 	E.ScriptFile = mpCurrentSource->GetName();
@@ -901,6 +2026,44 @@ void Interpreter::TackOnScriptInfo( ParserAnomaly& E )
 }
 
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::ResetBudget()
+{
+	mStatementCount = 0;
+	mBudgetStart = mTimeBudget ? GetMicroseconds() : 0;
+	CheckBudget();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::CheckBudget()
+{
+	//How often the clock gets looked at.
+	const boost::uint64_t TimeCheckInterval = 256;
+
+	if( mStatementBudget && mStatementCount > mStatementBudget )
+	{
+		ThrowParserAnomaly( String( TXT("Script ran more than ") ) +
+							boost::lexical_cast<String>( mStatementBudget ) +
+							String( TXT(" statements without stopping.") ), ANOMALY_OVERBUDGET );
+	}
+
+	if( mTimeBudget && mStatementCount != 0 &&
+		GetMicroseconds() - mBudgetStart > (boost::uint64_t)mTimeBudget * 1000 )
+	{
+		ThrowParserAnomaly( String( TXT("Script ran for more than ") ) +
+							boost::lexical_cast<String>( mTimeBudget ) +
+							String( TXT(" milliseconds without stopping.") ), ANOMALY_OVERBUDGET );
+	}
+
+	mNextBudgetCheck = (boost::uint64_t)-1;
+	if( mStatementBudget ) mNextBudgetCheck = mStatementBudget + 1;
+	if( mTimeBudget && mStatementCount + TimeCheckInterval < mNextBudgetCheck ){
+		mNextBudgetCheck = mStatementCount + TimeCheckInterval;
+	}
+}
+
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 void Interpreter::AssertSourceOpen()
 {
@@ -923,40 +2086,37 @@ void Interpreter::AssertAttachedInterface()
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 void Interpreter::FastForwardToNextStatement( ReaderSource& MySource )
 {
-	const Word* pTempWord;
+	ReaderPos Pos = MySource.GetNextTerminalOrBracket( MySource.GetPos() );
 
-	for( pTempWord = &MySource.GetNextWord();
-		 pTempWord->Type != WORDTYPE_TERMINAL;
-		 pTempWord = &MySource.GetNextWord() )
-	{
-		//Override the search for the ';' and instead break on
-		//a complete bracket set.
-		if( pTempWord->Extra == EXTRA_BRACKET_Left )
-		{
-			unsigned long BracketCount = 1;
+	//Override the search for the ';' and instead break on
+	//a complete bracket set.
+	MySource.GotoPos( Pos );
+	if( MySource.GetNextWord().Extra == EXTRA_BRACKET_Left ){
+		MySource.GotoPos( MySource.GetMatchingBracket( Pos ) + 1 );
+	}
+}
 
-			while( true )
-			{
-				pTempWord = &MySource.GetNextWord();
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Interpreter::FastForwardPastBody( ReaderSource& MySource )
+{
+	const Word* pTempWord;
+	unsigned long BracketCount = 1;
 
-				if( pTempWord->Extra == EXTRA_BRACKET_Left ) BracketCount++;
-				else if( pTempWord->Extra == EXTRA_BRACKET_Right )
-				{
-					if( BracketCount == 0 ){
-						ThrowParserAnomaly( TXT("Found \'}\' without a matching \'{\'."), ANOMALY_BADGRAMMAR );
-					}
-					else BracketCount--;
+	while( BracketCount )
+	{
+		pTempWord = &MySource.GetNextWord();
 
-					if( BracketCount == 0 ) return;
-				}
-			}
-		}
+		if( *pTempWord == EOF_WORD ) ThrowUnexpectedEOF();
+		else if( pTempWord->Extra == EXTRA_BRACKET_Left ) BracketCount++;
+		else if( pTempWord->Extra == EXTRA_BRACKET_Right ) BracketCount--;
 	}
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 void Interpreter::ImportIntoCurrentScope( const String& Name )
 {
+	RuntimeContextGuard Guard( mContext );
+
 	if( mVerboseOutput ){
 		mpInterface->LogMessage( String(TXT("Importing \'")) + Name + String(TXT("\'.\n")) );
 	}
@@ -968,6 +2128,8 @@ void Interpreter::ImportIntoCurrentScope( const String& Name )
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 void Interpreter::ImportFileIntoCurrentScope( const String& FileName )
 {
+	RuntimeContextGuard Guard( mContext );
+
 	if( mVerboseOutput ){
 		mpInterface->LogMessage( String(TXT("Importing \'")) + FileName + String(TXT("\'.\n")) );
 	}
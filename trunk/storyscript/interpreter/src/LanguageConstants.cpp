@@ -9,39 +9,21 @@ NOTES: This is a list of language constants that can be changed to effect
 
 
 #include "LanguageConstants.hpp"
-
-//To initialize gpEmptyList
-#include "CreationFuncs.hpp"
-#include "List.hpp"
-#include "Variable.hpp"
+#include "RuntimeContext.hpp"
+#include "Mutex.hpp"
 
 using namespace SS;
 
 #include <clocale>
 
 
-//Don't worry, these get initialized by InitConstants
-VariablePtr SS::gpNANConst;
-VariablePtr SS::gpInfinityConst;
-VariablePtr SS::gpNegInfinityConst;
-VariablePtr SS::gpNewLineConst;
-
-
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
- NOTES: Language option singleton intilization code
+ NOTES: Each runtime context has its own language options.
 */
-
-boost::shared_ptr<LangOpts> LangOpts::mpInstance;
-
 LangOpts& LangOpts::Instance()
 {
-	if( !mpInstance ){
-		mpInstance.reset( new LangOpts );
-	}
-	
-	return *mpInstance;
-	
+	return RuntimeContext::Current().GetLangOpts();
 }
 
 LangOpts::LangOpts()
@@ -51,7 +33,10 @@ LangOpts::LangOpts()
   MaxDigitOutput( 0 ), //0 means infinate
   NumberBase( 10 ),
   UseStrictLists( false ),
-  Verbose( false )
+  Verbose( false ),
+  UseByteCode( false ),
+  MemoizeBlocks( false ),
+  MemoCacheSize( 4096 )
 {
 	
 }
@@ -186,31 +171,18 @@ const SS::Char* LC_SL_LangOpts = TXT("SSLangOpts");
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
  InitConstants
  NOTES: This gets called once to set up all the necessary language constants
-		such as locale info.
+		such as locale info.  The maps are shared by every interpreter,
+		so they're only ever built once, even with interpreters being
+		made on several threads.  (The in-language constants belong to
+		each RuntimeContext.)
 */
 void SS::InitConstants(){
+	static Mutex InitMutex;
+	MutexLock Lock( InitMutex );
+
 	static bool HasBeenCalled = false;
 	if( HasBeenCalled ) return;
 	
-	//Set up the in-language ones
-	gpNANConst = CreateVariable<Variable>( TXT("_NAN_"), false, 0 );
-	mpfr_set_nan( gpNANConst->GetActualNumData().get() );
-	gpNANConst->ForceConversion( VARTYPE_NUM );
-	gpNANConst->SetConst();
-		
-	gpInfinityConst = CreateVariable<Variable>( TXT("_INF_"), false, 0 );
-	mpfr_set_inf( gpInfinityConst->GetActualNumData().get(), 1 );
-	gpInfinityConst->ForceConversion( VARTYPE_NUM );
-	gpInfinityConst->SetConst();
-	
-	gpNegInfinityConst = CreateVariable<Variable>( TXT("_NEGINF_"), false, 0 );
-	mpfr_set_inf( gpNegInfinityConst->GetActualNumData().get(), -1 );
-	gpNegInfinityConst->ForceConversion( VARTYPE_NUM );
-	gpNegInfinityConst->SetConst();
-	
-	gpNewLineConst = CreateVariable<Variable>( TXT("endl"), true, String(TXT("\n")) );
-
-
 	//The below part sets the decimal point and thousands seperator to
 	//whatever the current locale.  This is absolutely absurd, as it
 	//would create different versions of the language for different locales.
@@ -226,10 +198,6 @@ void SS::InitConstants(){
 	*/
 	
 	
-	//VERY IMPORTANT THAT THIS GETS SET
-	gpEmptyList = CreateGeneric<List>( String(), true );
-
-
 
 	//Build Maps
 	gBinaryOperatorMap[ LC_ListSeperator ]     = EXTRA_BINOP_ListSeperator;
@@ -0,0 +1,194 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+#include "LineProfiler.hpp"
+#include "HelperFuncs.hpp"
+
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+using namespace SS;
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: Sorts profiles by exclusive time, most first.
+*/
+static bool MoreExclusiveTime( const LineProfile& A, const LineProfile& B )
+{
+	if( A.ExclusiveTime != B.ExclusiveTime ) return A.ExclusiveTime > B.ExclusiveTime;
+	if( A.FileName != B.FileName ) return A.FileName < B.FileName;
+	return A.Line < B.Line;
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: Right-aligns a number in a column of the given width.  Zeros are
+ 		left blank, so the lines that never ran stand out.
+*/
+static void AppendColumn( String& S, boost::uint64_t N, size_t Width )
+{
+	String Number;
+	if( N ) Number = boost::lexical_cast<String>( N );
+	if( Number.length() < Width ) S.append( Width - Number.length(), ' ' );
+	S += Number;
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: Adds one line of a listing.
+*/
+static void AppendListingLine( String& Listing, const LineProfile* pProfile,
+							   unsigned long Line, const String& Text )
+{
+	if( pProfile )
+	{
+		AppendColumn( Listing, pProfile->Statements, 10 );
+		AppendColumn( Listing, pProfile->Evaluations, 10 );
+		AppendColumn( Listing, pProfile->InclusiveTime, 12 );
+		AppendColumn( Listing, pProfile->ExclusiveTime, 12 );
+	}
+	else Listing.append( 44, ' ' );
+
+	Listing += TXT("  ");
+	AppendColumn( Listing, Line, 5 );
+	Listing += TXT(": ");
+	Listing += Text;
+	Listing += TXT("\n");
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+LineProfiler::LineProfiler()
+{
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+LineProfiler::Record& LineProfiler::GetRecord( const String& FileName, unsigned long Line )
+{
+	Record& R = mFiles[FileName][Line];
+	if( R.Profile.Line == 0 )
+	{
+		R.Profile.FileName = FileName;
+		R.Profile.Line = Line;
+	}
+
+	return R;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void LineProfiler::CountStatement( const String& FileName, unsigned long Line )
+{
+	GetRecord( FileName, Line ).Profile.Statements++;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void LineProfiler::Enter( const String& FileName, unsigned long Line )
+{
+	Record& R = GetRecord( FileName, Line );
+
+	R.Profile.Evaluations++;
+	R.Active++;
+
+	Activation A;
+	A.pRecord = &R;
+	A.ChildTime = 0;
+
+	//Last, so as little as possible of the above gets counted.
+	A.StartTime = GetMicroseconds();
+	mActive.push_back( A );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void LineProfiler::Leave()
+{
+	boost::uint64_t Now = GetMicroseconds();
+
+	if( mActive.empty() ) return;
+
+	Activation& A = mActive.back();
+	Record& R = *A.pRecord;
+
+	boost::uint64_t Time = Now - A.StartTime;
+
+	R.Profile.ExclusiveTime += Time > A.ChildTime ? Time - A.ChildTime : 0;
+	if( --R.Active == 0 ) R.Profile.InclusiveTime += Time;
+
+	mActive.pop_back();
+
+	if( !mActive.empty() ) mActive.back().ChildTime += Time;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void LineProfiler::Clear()
+{
+	mFiles.clear();
+	mActive.clear();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void LineProfiler::GetReport( std::vector<LineProfile>& Report ) const
+{
+	Report.clear();
+
+	std::map< String, LineMap >::const_iterator i;
+	for( i = mFiles.begin(); i != mFiles.end(); i++ )
+	{
+		LineMap::const_iterator j;
+		for( j = i->second.begin(); j != i->second.end(); j++ ) Report.push_back( j->second.Profile );
+	}
+
+	std::sort( Report.begin(), Report.end(), MoreExclusiveTime );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void LineProfiler::GetFiles( std::vector<String>& Files ) const
+{
+	Files.clear();
+
+	std::map< String, LineMap >::const_iterator i;
+	for( i = mFiles.begin(); i != mFiles.end(); i++ ) Files.push_back( i->first );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void LineProfiler::GetListing( const String& FileName, String& Listing ) const
+{
+	Listing = TXT("     stmts     evals    incl(us)    excl(us)   line\n");
+
+	LineMap Empty;
+	std::map< String, LineMap >::const_iterator i = mFiles.find( FileName );
+	const LineMap& Lines = i == mFiles.end() ? Empty : i->second;
+	LineMap::const_iterator j = Lines.begin();
+
+	std::ifstream File( NarrowizeString( FileName ).c_str() );
+	std::string Text;
+	unsigned long Line = 0;
+
+	while( File && std::getline( File, Text ) )
+	{
+		Line++;
+		if( !Text.empty() && Text[Text.length() - 1] == '\r' ) Text.erase( Text.length() - 1 );
+
+		const LineProfile* pProfile = 0;
+		if( j != Lines.end() && j->first == Line ) pProfile = &(j++)->second.Profile;
+
+		AppendListingLine( Listing, pProfile, Line, NormalizeString( Text ) );
+	}
+
+	//Whatever is left wasn't in the file (or the file couldn't be read).
+	for( ; j != Lines.end(); j++ ) AppendListingLine( Listing, &j->second.Profile, j->first, String() );
+}
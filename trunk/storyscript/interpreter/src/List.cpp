@@ -17,12 +17,6 @@ NOTES: Definitions for the List class; a dynamicaly sized list.
 using namespace SS;
 
 
-//The global empty list variable
-ListPtr SS::gpEmptyList;
-
-//const ListPtr SS::gpEmptyList( new List( SS::String(), true, true ) );
-
-
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
  List::List
  NOTES: 
@@ -30,6 +24,7 @@ ListPtr SS::gpEmptyList;
 List::List( SS_DECLARE_BASE_ARGS )
 : VariableBase( SS_BASE_ARGS )
 {
+	mType = SCOPEOBJ_LIST;
 	RegisterPredefinedVars();
 }
 
@@ -53,12 +48,12 @@ void List::AcceptVisitor( ScopeObjectVisitor& V ){
 */
 ListPtr List::CastToList(){
 	AssertCastingAllowed();
-	return boost::dynamic_pointer_cast<List>( ScopeObjectPtr( mpThis ) );
+	return ListPtr( this );
 }
 
 const ListPtr List::CastToList() const{
 	AssertCastingAllowed();
-	return boost::dynamic_pointer_cast<List>( ScopeObjectPtr( mpThis ) );
+	return ListPtr( const_cast<List*>(this) );
 }
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
@@ -435,30 +430,38 @@ const VariablePtr List::CastToVariable() const{
 
 
 
+//What GetScopeObjectHook answers to.  These are interned at startup, so the
+//names can be found even before a script has used them.
+static const SymbolID PopSymbol       = Intern( LC_LIST_Pop );
+static const SymbolID PushSymbol      = Intern( LC_LIST_Push );
+static const SymbolID RemoveAllSymbol = Intern( LC_LIST_RemoveAll );
+static const SymbolID RemoveSymbol    = Intern( LC_LIST_Remove );
+static const SymbolID LengthSymbol    = Intern( LC_Length );
+
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
  NOTES: Overloaded to intercept lookups to predef'ed objecs and creates them
  		on the fly.  Otherwise there is lot of overhead for stuff you probably
  		won't even use.
 */
-ScopeObjectPtr List::GetScopeObjectHook( const String& Name )
+ScopeObjectPtr List::GetScopeObjectHook( SymbolID Name )
 {
-	if( !mPopCreated && Name == LC_LIST_Pop ){
+	if( !mPopCreated && Name == PopSymbol ){
 		mPopCreated = true;
 		return Register( ScopeObjectPtr( new PopOp( *this ) ) );
 	}
-	else if( !mPushCreated && Name == LC_LIST_Push ){
+	else if( !mPushCreated && Name == PushSymbol ){
 		mPushCreated = true;
 		return Register( ScopeObjectPtr( new PushOp( *this ) ) );
 	}
-	else if( !mRemoveAllCreated && Name == LC_LIST_RemoveAll ){
+	else if( !mRemoveAllCreated && Name == RemoveAllSymbol ){
 		mRemoveAllCreated = true;
 		return Register( ScopeObjectPtr( new RemoveAllOp( *this ) ) );
 	}
-	else if( !mRemoveCreated && Name == LC_LIST_Remove ){
+	else if( !mRemoveCreated && Name == RemoveSymbol ){
 		mRemoveCreated = true;
 		return Register( ScopeObjectPtr( new RemoveOp( *this ) ) );
 	}
-	else if( !mLengthCreated && Name == LC_Length ){
+	else if( !mLengthCreated && Name == LengthSymbol ){
 		mLengthCreated = true;
 		return Register( ScopeObjectPtr( new ListLengthVar( LC_Length, true, *this ) ) );
 	}	
@@ -191,7 +191,7 @@ BoundFlagVar::BoundFlagVar( SS_DECLARE_BASE_ARGS, bool& Flag )
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 VariableBasePtr BoundFlagVar::operator=( const VariableBase& X ){
 	mFlag = X.GetBoolData();
-	return boost::dynamic_pointer_cast<VariableBase>( ScopeObjectPtr(mpThis) );
+	return CastToVariableBase();
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
@@ -522,11 +522,7 @@ PrecisionVar::PrecisionVar( const String& Name, Variable& Parent )
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 VariableBasePtr PrecisionVar::operator=(const VariableBase& X )
 {
-	static const NumType MinPrecision( MPFR_PREC_MIN );
-	static const NumType MaxPrecision( MPFR_PREC_MAX );
-    
-
-	if( mpfr_less_p( X.GetNumData().get(), MinPrecision.get() ) )
+	if( mpfr_cmp_ui( X.GetNumData().get(), MPFR_PREC_MIN ) < 0 )
 	{
 		String tmp = TXT("Tried to set precision to \'");
 		tmp += X.GetStringData();
@@ -536,7 +532,7 @@ VariableBasePtr PrecisionVar::operator=(const VariableBase& X )
 		ThrowParserAnomaly( tmp, ANOMALY_BADPRECISION );
 	}
 	
-	if( mpfr_greater_p( X.GetNumData().get(), MaxPrecision.get() ) )
+	if( mpfr_cmp_ui( X.GetNumData().get(), MPFR_PREC_MAX ) > 0 )
 	{
 		String tmp = TXT("Tried to set precision to \'");
 		tmp += X.GetStringData();
@@ -563,7 +559,7 @@ VarType PrecisionVar::GetVariableType() const{
 NumType PrecisionVar::GetNumData() const
 {
 	NumType Out;
-	mpfr_set_ui( Out.get(), mpfr_get_prec(mParent.GetActualNumData().get()), GMP_RNDN );
+	Out.set( (unsigned long)mParent.GetActualNumData().get_prec() );
 	return Out;
 }
 
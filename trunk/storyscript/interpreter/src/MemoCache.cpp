@@ -0,0 +1,214 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+#include "MemoCache.hpp"
+#include "Variable.hpp"
+#include "List.hpp"
+#include "LanguageConstants.hpp"
+#include "CreationFuncs.hpp"
+#include "ScopeObjectVisitor.hpp"
+
+#include <boost/lexical_cast.hpp>
+#include <cstring>
+#include <vector>
+
+using namespace SS;
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: Adds one value of 'in' to a key.  Every value is tagged with its
+ 		type, since a block may well treat "1" and 1 differently.  Numbers
+ 		are written out exactly, along with their precision.
+*/
+static void AppendValue( const VariableBase& X, String& Key )
+{
+	switch( X.GetVariableType() )
+	{
+	case VARTYPE_BOOL:
+		Key += X.GetBoolData() ? TXT("t;") : TXT("f;");
+		break;
+
+	case VARTYPE_NUM:
+	{
+		NumType N;
+		X.GetNumData( N );
+
+		Key += TXT("n");
+		Key += boost::lexical_cast<String>( N.get_prec() );
+		Key += TXT(":");
+
+		if( N.is_small() )
+		{
+			Key += boost::lexical_cast<String>( N.get_small() );
+		}
+		else if( N.is_big() )
+		{
+			//read() would round it to the precision, so use the mpz itself.
+			std::vector<char> Buffer( mpz_sizeinbase( N.get_big(), 16 ) + 2 );
+			mpz_get_str( &Buffer[0], 16, N.get_big() );
+
+			Key += TXT("z");
+			Key.append( &Buffer[0], &Buffer[0] + strlen( &Buffer[0] ) );
+		}
+		else
+		{
+			mp_exp_t Exponent = 0;
+			char* pDigits = mpfr_get_str( 0, &Exponent, 16, 0, N.read(), GMP_RNDN );
+			Key.append( pDigits, pDigits + strlen( pDigits ) );
+			mpfr_free_str( pDigits );
+
+			Key += TXT("@");
+			Key += boost::lexical_cast<String>( Exponent );
+		}
+		Key += TXT(";");
+		break;
+	}
+
+	default:
+	{
+		String S = X.GetStringData();
+		Key += TXT("s");
+		Key += boost::lexical_cast<String>( S.length() );
+		Key += TXT(":");
+		Key += S;
+		break;
+	}
+	}
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+MemoCache::MemoCache()
+{
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+MemoCache::Purity MemoCache::GetPurity( const Block* pBlock ) const
+{
+	BlockMap::const_iterator i = mBlocks.find( pBlock );
+	if( i == mBlocks.end() ) return PURITY_UNKNOWN;
+	return i->second.P;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void MemoCache::SetPurity( const Block* pBlock, Purity P )
+{
+	mBlocks[pBlock].P = P;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+const std::vector<Block*>& MemoCache::GetCallees( const Block* pBlock ) const
+{
+	static const std::vector<Block*> None;
+
+	BlockMap::const_iterator i = mBlocks.find( pBlock );
+	if( i == mBlocks.end() ) return None;
+	return i->second.Callees;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void MemoCache::SetCallees( const Block* pBlock, const std::vector<Block*>& Callees )
+{
+	mBlocks[pBlock].Callees = Callees;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void MemoCache::MakeKey( const VariableBasePtr& In, String& Key )
+{
+	Key.clear();
+
+	//Anything the block's numbers depend on, besides 'in'.
+	const LangOpts& Opts = LangOpts::Instance();
+	Key += boost::lexical_cast<String>( Opts.DefaultPrecision );
+	Key += TXT(",");
+	Key += boost::lexical_cast<String>( (int)Opts.RoundingMode );
+	Key += TXT(",");
+	Key += boost::lexical_cast<String>( Opts.NumberBase );
+	Key += TXT("|");
+
+	if( !In ) return;
+
+	//A lone value ends up as a list of one in 'in', so it gets the same key.
+	if( GetScopeObjectType( In ) == SCOPEOBJ_LIST )
+	{
+		const ListType& Values = In->CastToList()->GetInternalList();
+		size_t i;
+		for( i = 0; i < Values.size(); i++ ) AppendValue( *Values[i], Key );
+	}
+	else AppendValue( *In, Key );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+const MemoCache::Result* MemoCache::Find( const Block* pBlock, const String& Key )
+{
+	BlockMap::iterator i = mBlocks.find( pBlock );
+	if( i != mBlocks.end() )
+	{
+		std::map< String, Result >::iterator j = i->second.Results.find( Key );
+		if( j != i->second.Results.end() )
+		{
+			mStats.Hits++;
+			return &j->second;
+		}
+	}
+
+	mStats.Misses++;
+	return 0;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void MemoCache::Insert( const Block* pBlock, const String& Key,
+						const VariableBase& Out, const std::vector<VariablePtr>& CalleeOuts,
+						size_t Limit )
+{
+	if( Limit && mStats.Entries >= Limit )
+	{
+		//Keep what is known about the blocks, just not their results.
+		BlockMap::iterator i;
+		for( i = mBlocks.begin(); i != mBlocks.end(); i++ ) i->second.Results.clear();
+
+		mStats.Entries = 0;
+		mStats.Flushes++;
+	}
+
+	Result& Slot = mBlocks[pBlock].Results[Key];
+	if( !Slot.pOut ) mStats.Entries++;
+
+	Slot.pOut = CreateVariable<Variable>( String(), false, String() );
+	*Slot.pOut = Out;
+
+	Slot.CalleeOuts.resize( CalleeOuts.size() );
+	size_t i;
+	for( i = 0; i < CalleeOuts.size(); i++ )
+	{
+		Slot.CalleeOuts[i] = CreateVariable<Variable>( String(), false, String() );
+		*Slot.CalleeOuts[i] = *CalleeOuts[i]->CastToVariableBase();
+	}
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void MemoCache::Clear()
+{
+	mBlocks.clear();
+	mStats.Entries = 0;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+const MemoStats& MemoCache::GetStats() const
+{
+	return mStats;
+}
@@ -0,0 +1,268 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+#include "Mutex.hpp"
+#include "ParserAnomaly.hpp"
+#include "Unicode.hpp"
+
+#if defined(PLAT_WIN32)
+	#include <windows.h>
+	#include <process.h>
+#else
+	#include <pthread.h>
+#endif
+
+using namespace SS;
+
+
+//What a new thread is told to run.
+struct ThreadStart
+{
+	Thread::Function F;
+	void* pArg;
+};
+
+
+#if defined(PLAT_WIN32)
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Mutex::Mutex()
+{
+	CRITICAL_SECTION* pSection = new CRITICAL_SECTION;
+	InitializeCriticalSection( pSection );
+	mpHandle = pSection;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Mutex::~Mutex()
+{
+	CRITICAL_SECTION* pSection = (CRITICAL_SECTION*)mpHandle;
+	DeleteCriticalSection( pSection );
+	delete pSection;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Mutex::Lock()
+{
+	EnterCriticalSection( (CRITICAL_SECTION*)mpHandle );
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Mutex::Unlock()
+{
+	LeaveCriticalSection( (CRITICAL_SECTION*)mpHandle );
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Condition::Condition()
+{
+	CONDITION_VARIABLE* pCondition = new CONDITION_VARIABLE;
+	InitializeConditionVariable( pCondition );
+	mpHandle = pCondition;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Condition::~Condition()
+{
+	delete (CONDITION_VARIABLE*)mpHandle;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Condition::Wait( Mutex& M )
+{
+	SleepConditionVariableCS( (CONDITION_VARIABLE*)mpHandle,
+							  (CRITICAL_SECTION*)M.mpHandle, INFINITE );
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Condition::Signal()
+{
+	WakeConditionVariable( (CONDITION_VARIABLE*)mpHandle );
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Condition::Broadcast()
+{
+	WakeAllConditionVariable( (CONDITION_VARIABLE*)mpHandle );
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+static unsigned __stdcall StartThread( void* pStart )
+{
+	ThreadStart Start = *(ThreadStart*)pStart;
+	delete (ThreadStart*)pStart;
+
+	Start.F( Start.pArg );
+	return 0;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Thread::Thread( Function F, void* pArg )
+	: mJoined( false )
+{
+	ThreadStart* pStart = new ThreadStart;
+	pStart->F = F;
+	pStart->pArg = pArg;
+	mpHandle = (void*)_beginthreadex( 0, 0, StartThread, pStart, 0, 0 );
+
+	if( !mpHandle )
+	{
+		delete pStart;
+		ThrowParserAnomaly( TXT("Couldn't start a new thread."), ANOMALY_PANIC );
+	}
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Thread::~Thread()
+{
+	Join();
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Thread::Join()
+{
+	if( mJoined ) return;
+	mJoined = true;
+
+	WaitForSingleObject( (HANDLE)mpHandle, INFINITE );
+	CloseHandle( (HANDLE)mpHandle );
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+boost::uint64_t SS::AtomicIncrement( volatile boost::uint64_t& X )
+{
+	return (boost::uint64_t)InterlockedIncrement64( (volatile LONGLONG*)&X );
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+boost::uint64_t SS::AtomicDecrement( volatile boost::uint64_t& X )
+{
+	return (boost::uint64_t)InterlockedDecrement64( (volatile LONGLONG*)&X );
+}
+
+#else
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Mutex::Mutex()
+{
+	pthread_mutex_t* pMutex = new pthread_mutex_t;
+	pthread_mutex_init( pMutex, 0 );
+	mpHandle = pMutex;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Mutex::~Mutex()
+{
+	pthread_mutex_t* pMutex = (pthread_mutex_t*)mpHandle;
+	pthread_mutex_destroy( pMutex );
+	delete pMutex;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Mutex::Lock()
+{
+	pthread_mutex_lock( (pthread_mutex_t*)mpHandle );
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Mutex::Unlock()
+{
+	pthread_mutex_unlock( (pthread_mutex_t*)mpHandle );
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Condition::Condition()
+{
+	pthread_cond_t* pCondition = new pthread_cond_t;
+	pthread_cond_init( pCondition, 0 );
+	mpHandle = pCondition;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Condition::~Condition()
+{
+	pthread_cond_t* pCondition = (pthread_cond_t*)mpHandle;
+	pthread_cond_destroy( pCondition );
+	delete pCondition;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Condition::Wait( Mutex& M )
+{
+	pthread_cond_wait( (pthread_cond_t*)mpHandle, (pthread_mutex_t*)M.mpHandle );
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Condition::Signal()
+{
+	pthread_cond_signal( (pthread_cond_t*)mpHandle );
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Condition::Broadcast()
+{
+	pthread_cond_broadcast( (pthread_cond_t*)mpHandle );
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+static void* StartThread( void* pStart )
+{
+	ThreadStart Start = *(ThreadStart*)pStart;
+	delete (ThreadStart*)pStart;
+
+	Start.F( Start.pArg );
+	return 0;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Thread::Thread( Function F, void* pArg )
+	: mJoined( false )
+{
+	ThreadStart* pStart = new ThreadStart;
+	pStart->F = F;
+	pStart->pArg = pArg;
+
+	pthread_t* pThread = new pthread_t;
+	if( pthread_create( pThread, 0, StartThread, pStart ) != 0 )
+	{
+		delete pThread;
+		delete pStart;
+		ThrowParserAnomaly( TXT("Couldn't start a new thread."), ANOMALY_PANIC );
+	}
+	mpHandle = pThread;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Thread::~Thread()
+{
+	Join();
+	delete (pthread_t*)mpHandle;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Thread::Join()
+{
+	if( mJoined ) return;
+	mJoined = true;
+
+	pthread_join( *(pthread_t*)mpHandle, 0 );
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+boost::uint64_t SS::AtomicIncrement( volatile boost::uint64_t& X )
+{
+	return __sync_add_and_fetch( &X, 1 );
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+boost::uint64_t SS::AtomicDecrement( volatile boost::uint64_t& X )
+{
+	return __sync_sub_and_fetch( &X, 1 );
+}
+
+#endif
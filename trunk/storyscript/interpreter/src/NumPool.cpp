@@ -0,0 +1,164 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+#include "NumPool.hpp"
+#include "RuntimeContext.hpp"
+
+using namespace SS;
+
+
+//No bucket holds more numbers than this.
+const size_t MAX_POOLED = 4096;
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NumPool::NumPool()
+	: mLastBucket( 0 )
+{
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NumPool::~NumPool()
+{
+	Clear();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NumPool& NumPool::Instance()
+{
+	return RuntimeContext::Current().GetNumPool();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+NumPool::Bucket& NumPool::GetBucket( mpfr_prec_t Prec )
+{
+	if( mLastBucket < mBuckets.size() && mBuckets[mLastBucket].Prec == Prec ){
+		return mBuckets[mLastBucket];
+	}
+
+	size_t i;
+	for( i = 0; i < mBuckets.size(); i++ ){
+		if( mBuckets[i].Prec == Prec ) break;
+	}
+
+	if( i == mBuckets.size() )
+	{
+		mBuckets.push_back( Bucket() );
+		mBuckets.back().Prec = Prec;
+	}
+
+	mLastBucket = i;
+	return mBuckets[i];
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void NumPool::Acquire( mpfr_ptr X, mpfr_prec_t Prec )
+{
+	Bucket& B = GetBucket( Prec );
+
+	if( B.Numbers.empty() )
+	{
+		mpfr_init2( X, Prec );
+		mMpfrCounters.Inits++;
+		return;
+	}
+
+	*X = B.Numbers.back();
+	B.Numbers.pop_back();
+	mMpfrCounters.Reuses++;
+
+	mpfr_set_nan( X );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void NumPool::Acquire( mpz_ptr X )
+{
+	if( mIntegers.empty() )
+	{
+		mpz_init( X );
+		mMpzCounters.Inits++;
+		return;
+	}
+
+	*X = mIntegers.back();
+	mIntegers.pop_back();
+	mMpzCounters.Reuses++;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void NumPool::Release( mpfr_ptr X )
+{
+	RuntimeContext* pContext = RuntimeContext::Find();
+	if( pContext )
+	{
+		NumPool& Pool = pContext->GetNumPool();
+		Bucket& B = Pool.GetBucket( mpfr_get_prec( X ) );
+		if( B.Numbers.size() < MAX_POOLED )
+		{
+			B.Numbers.push_back( *X );
+			return;
+		}
+
+		Pool.mMpfrCounters.Clears++;
+	}
+
+	mpfr_clear( X );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void NumPool::Release( mpz_ptr X )
+{
+	RuntimeContext* pContext = RuntimeContext::Find();
+	if( pContext )
+	{
+		NumPool& Pool = pContext->GetNumPool();
+		if( Pool.mIntegers.size() < MAX_POOLED )
+		{
+			Pool.mIntegers.push_back( *X );
+			return;
+		}
+
+		Pool.mMpzCounters.Clears++;
+	}
+
+	mpz_clear( X );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void NumPool::Clear()
+{
+	size_t i, j;
+	for( i = 0; i < mBuckets.size(); i++ )
+	{
+		std::vector<__mpfr_struct>& Numbers = mBuckets[i].Numbers;
+		for( j = 0; j < Numbers.size(); j++ ) mpfr_clear( &Numbers[j] );
+
+		mMpfrCounters.Clears += (unsigned long)Numbers.size();
+		Numbers.clear();
+	}
+
+	for( i = 0; i < mIntegers.size(); i++ ) mpz_clear( &mIntegers[i] );
+	mMpzCounters.Clears += (unsigned long)mIntegers.size();
+	mIntegers.clear();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void NumPool::ResetCounters()
+{
+	mMpfrCounters = NumPoolCounters();
+	mMpzCounters = NumPoolCounters();
+}
@@ -21,18 +21,21 @@ using namespace SS;
 Operator::Operator( SS_DECLARE_BASE_ARGS )
 	: Scope( SS_BASE_ARGS )
 {
+	mType = SCOPEOBJ_OPERATOR;
 	RegisterPredefinedVars();
 }
 
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 OperatorPtr Operator::CastToOperator(){
-	return boost::dynamic_pointer_cast<Operator>( ScopeObjectPtr( mpThis ) );
+	AssertCastingAllowed();
+	return OperatorPtr( this );
 }
 
 
 const OperatorPtr Operator::CastToOperator() const{
-    return boost::dynamic_pointer_cast<Operator>( ScopeObjectPtr( mpThis ) );
+	AssertCastingAllowed();
+	return OperatorPtr( const_cast<Operator*>(this) );
 }
 
 
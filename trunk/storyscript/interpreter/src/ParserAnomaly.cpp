@@ -68,10 +68,9 @@ ParserAnomaly::ParserAnomaly( const String& Desc,
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 const char* ParserAnomaly::what() const throw()
 {
-	static std::string LowerWhat;
-    LowerWhat = NarrowizeString( ErrorDesc );
+	mNarrowWhat = NarrowizeString( ErrorDesc );
 	
-	return LowerWhat.c_str();
+	return mNarrowWhat.c_str();
 }
 
 
@@ -0,0 +1,135 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+#include "Profiler.hpp"
+#include "Block.hpp"
+#include "HelperFuncs.hpp"
+#include "RuntimeContext.hpp"
+
+#include <algorithm>
+
+using namespace SS;
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: Adds what was found out about a block to what was known already.
+*/
+static void MergeProfile( BlockProfile& Total, const BlockProfile& P )
+{
+	Total.Name = P.Name;
+	Total.Calls += P.Calls;
+	Total.InclusiveTime += P.InclusiveTime;
+	Total.ExclusiveTime += P.ExclusiveTime;
+	Total.Allocations += P.Allocations;
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: Sorts profiles by exclusive time, most first.
+*/
+static bool MoreExclusiveTime( const BlockProfile& A, const BlockProfile& B )
+{
+	if( A.ExclusiveTime != B.ExclusiveTime ) return A.ExclusiveTime > B.ExclusiveTime;
+	return A.Name < B.Name;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Profiler::Profiler()
+{
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Profiler::Enter( const Block* pBlock )
+{
+	Record& R = mRecords[pBlock];
+	if( R.Profile.Name.empty() ) R.Profile.Name = pBlock->GetFullName();
+
+	R.Profile.Calls++;
+	R.Active++;
+
+	Activation A;
+	A.pRecord = &R;
+	A.StartObjects = RuntimeContext::Current().GetObjectsCreated();
+	A.ChildTime = A.ChildObjects = 0;
+
+	//Last, so as little as possible of the above gets counted.
+	A.StartTime = GetMicroseconds();
+	mActive.push_back( A );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Profiler::Leave()
+{
+	boost::uint64_t Now = GetMicroseconds();
+
+	if( mActive.empty() ) return;
+
+	Activation& A = mActive.back();
+	Record& R = *A.pRecord;
+
+	boost::uint64_t Time = Now - A.StartTime;
+	boost::uint64_t Objects = RuntimeContext::Current().GetObjectsCreated() - A.StartObjects;
+
+	//Children can't have taken longer than this did, but the clock
+	//is only so fine.
+	R.Profile.ExclusiveTime += Time > A.ChildTime ? Time - A.ChildTime : 0;
+	R.Profile.Allocations += Objects > A.ChildObjects ? Objects - A.ChildObjects : 0;
+
+	if( --R.Active == 0 ) R.Profile.InclusiveTime += Time;
+
+	mActive.pop_back();
+
+	if( !mActive.empty() )
+	{
+		mActive.back().ChildTime += Time;
+		mActive.back().ChildObjects += Objects;
+	}
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Profiler::Forget()
+{
+	std::map< const Block*, Record >::const_iterator i;
+	for( i = mRecords.begin(); i != mRecords.end(); i++ ){
+		MergeProfile( mRetired[i->second.Profile.Name], i->second.Profile );
+	}
+
+	mRecords.clear();
+	mActive.clear();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Profiler::Clear()
+{
+	mRecords.clear();
+	mActive.clear();
+	mRetired.clear();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Profiler::GetReport( std::vector<BlockProfile>& Report ) const
+{
+	std::map< SS::String, BlockProfile > All( mRetired );
+
+	std::map< const Block*, Record >::const_iterator i;
+	for( i = mRecords.begin(); i != mRecords.end(); i++ ){
+		MergeProfile( All[i->second.Profile.Name], i->second.Profile );
+	}
+
+	Report.clear();
+	std::map< SS::String, BlockProfile >::const_iterator j;
+	for( j = All.begin(); j != All.end(); j++ ) Report.push_back( j->second );
+
+	std::sort( Report.begin(), Report.end(), MoreExclusiveTime );
+}
@@ -11,6 +11,9 @@ directory named "license".
 #include "ParserAnomaly.hpp"
 
 #include <queue>
+#include <ostream>
+#include <cstring>
+#include <boost/cstdint.hpp>
 
 using namespace SS;
 
@@ -20,12 +23,22 @@ const Char EOF_Char = 3; //ETX Character (I'm not exactly sure what to use here)
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 ReaderSource::ReaderSource() 
-	: mReadStringPos(0),
+	: mpReadLine(0),
+	  mReadLineLength(0),
+	  mpPeekLine(0),
+	  mPeekLineLength(0),
+	  mHavePeekLine(false),
+	  mReadStringPos(0),
+	  mBracketCount(0),
+	  mNameOfBracketCount(0),
+	  mpOwnWords(new SourceWords),
       mBufferPos(0),
 	  mCurrentLine(0)
 {
+	mpWords.reset( mpOwnWords );
+	
 	//First line starts at 0 pos of course.
-	mLinePositions.push_back(0);
+	mpOwnWords->LinePositions.push_back(0);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
@@ -37,25 +50,25 @@ ReaderSource::~ReaderSource()
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 const Word& ReaderSource::GetNextWord()
 {
-	static unsigned int BracketCount = 0;
-	static unsigned int NameOfBracketCount = 0;
-	
-	static std::queue< Word > QueuedWords;
+	const WordBuffer& Buffer = mpWords->Words;
 	
 	//If we are not at the end, just read off of the buffer.
-	if( mBufferPos != mBuffer.size() )
+	if( mBufferPos != Buffer.size() )
 	{
-		const Word& ReturnWord = mBuffer[ mBufferPos ];
+		const Word& ReturnWord = Buffer[ mBufferPos ];
 		mBufferPos++;
 		//UpdateCurrentLine();
 		return ReturnWord;		
 	}
+	
+	//Finished words are all there is, so stay on the last one (EOF).
+	if( !mpOwnWords ) return Buffer.back();
 
 
-	if( QueuedWords.size() != 0 )
+	if( mQueuedWords.size() != 0 )
 	{
-		Word TempWord = QueuedWords.front();
-		QueuedWords.pop();
+		Word TempWord = mQueuedWords.front();
+		mQueuedWords.pop();
 
 		return PushWord( TempWord );
 	}
@@ -71,17 +84,19 @@ const Word& ReaderSource::GetNextWord()
 
 	if( TempChar == EOF_Char )
 	{
-		return PushWord( EOF_WORD );
+		const Word& EOFWord = PushWord( EOF_WORD );
+		EndOfStream();
+		return EOFWord;
 	}	
 
 	//TERMINAL
 	if( TempChar == LC_Terminal[0] )
 	{
-		if( BracketCount != 0 ){
+		if( mBracketCount != 0 ){
 			ThrowParserAnomaly( TXT("Found one or more \'[\' without matching \']\'"), ANOMALY_BADPUNCTUATION );
 		}
 		
-		if( NameOfBracketCount != 0 ){
+		if( mNameOfBracketCount != 0 ){
 			ThrowParserAnomaly( TXT("Found a \'|\' without an ending \'|\'."), ANOMALY_BADPUNCTUATION );
 		}
 
@@ -91,38 +106,38 @@ const Word& ReaderSource::GetNextWord()
 	//BRACKET OPERATORS
 	else if( TempChar == '[' )
 	{
-		BracketCount++;
+		mBracketCount++;
 
-		QueuedWords.push( Word( WORDTYPE_PARENTHESIS, EXTRA_PARENTHESIS_Left ) );
+		mQueuedWords.push( Word( WORDTYPE_PARENTHESIS, EXTRA_PARENTHESIS_Left ) );
 
 		return PushWord( Word( WORDTYPE_BINARYOPERATOR, EXTRA_BINOP_ListAccess ) );
 	}
 	else if( TempChar == ']' )
 	{
-		if( BracketCount == 0 )
+		if( mBracketCount == 0 )
 		{
 			ThrowParserAnomaly( TXT("\']\' bracket found without coresponding \'[\'"),
 								ANOMALY_BADPUNCTUATION );
 		}
 
-		BracketCount--;
+		mBracketCount--;
 		return PushWord( Word( WORDTYPE_PARENTHESIS, EXTRA_PARENTHESIS_Right ) );
 	}
 	//NAME-OF BRACKETS
 	else if( TempChar == LC_NameOfBracket[0] )
 	{
-		if( NameOfBracketCount == 0 )
+		if( mNameOfBracketCount == 0 )
 		{
-			NameOfBracketCount++;
-			QueuedWords.push( Word( WORDTYPE_PARENTHESIS, EXTRA_PARENTHESIS_Left ) );
+			mNameOfBracketCount++;
+			mQueuedWords.push( Word( WORDTYPE_PARENTHESIS, EXTRA_PARENTHESIS_Left ) );
 			return PushWord( Word( WORDTYPE_PARENTHESIS, EXTRA_PARENTHESIS_Left ) );
 		}
 		else
 		{
-			NameOfBracketCount--;
-			QueuedWords.push( Word( WORDTYPE_BINARYOPERATOR, EXTRA_BINOP_ScopeResolution ) );
-			QueuedWords.push( Word( LC_FullName, WORDTYPE_IDENTIFIER ) );
-			QueuedWords.push( Word( WORDTYPE_PARENTHESIS, EXTRA_PARENTHESIS_Right ) );
+			mNameOfBracketCount--;
+			mQueuedWords.push( Word( WORDTYPE_BINARYOPERATOR, EXTRA_BINOP_ScopeResolution ) );
+			mQueuedWords.push( Word( LC_FullName, WORDTYPE_IDENTIFIER ) );
+			mQueuedWords.push( Word( WORDTYPE_PARENTHESIS, EXTRA_PARENTHESIS_Right ) );
 			return PushWord( Word( WORDTYPE_PARENTHESIS, EXTRA_PARENTHESIS_Right ) );
 		}
 	}
@@ -157,10 +172,10 @@ const Word& ReaderSource::GetNextWord()
 					{
 						//Output something like: (out = "Foo")
 	
-						QueuedWords.push( Word( LC_Output, WORDTYPE_IDENTIFIER ) );
-						QueuedWords.push( Word( WORDTYPE_BINARYOPERATOR, EXTRA_BINOP_PlusAssign ) );
-						QueuedWords.push( Word( TempString, WORDTYPE_StringLITERAL ) );
-						QueuedWords.push( Word( WORDTYPE_PARENTHESIS, EXTRA_PARENTHESIS_Right ) );
+						mQueuedWords.push( Word( LC_Output, WORDTYPE_IDENTIFIER ) );
+						mQueuedWords.push( Word( WORDTYPE_BINARYOPERATOR, EXTRA_BINOP_PlusAssign ) );
+						mQueuedWords.push( Word( TempString, WORDTYPE_StringLITERAL ) );
+						mQueuedWords.push( Word( WORDTYPE_PARENTHESIS, EXTRA_PARENTHESIS_Right ) );
 						
 						return PushWord( Word( WORDTYPE_PARENTHESIS, EXTRA_PARENTHESIS_Left ) );						
 					}
@@ -343,9 +358,9 @@ const Word& ReaderSource::GetNextWord()
 				   Peek() == '[' )
 		{
 			Get();
-			BracketCount++;
+			mBracketCount++;
 
-			QueuedWords.push( Word( WORDTYPE_PARENTHESIS, EXTRA_PARENTHESIS_Left ) );
+			mQueuedWords.push( Word( WORDTYPE_PARENTHESIS, EXTRA_PARENTHESIS_Left ) );
 
 			if( TempChar == '+' ) return PushWord( Word( WORDTYPE_BINARYOPERATOR, EXTRA_BINOP_ListAppend ) );
 			else return PushWord( Word( WORDTYPE_BINARYOPERATOR, EXTRA_BINOP_ListRemove ) );
@@ -397,7 +412,7 @@ const Word& ReaderSource::GetNextWord()
 	Temp += TempString;
 	Temp += TXT("\n");
 	ThrowParserAnomaly( Temp, ANOMALY_UNKNOWNWORD );
-	return mBuffer[0]; //To placate the compiler.
+	return Buffer[0]; //To placate the compiler.
 }
 
 
@@ -405,13 +420,24 @@ const Word& ReaderSource::GetNextWord()
 const Word& ReaderSource::PutBackWord()
 {
 	mBufferPos--;
-	if( mBufferPos ) return mBuffer[mBufferPos-1];
+	if( mBufferPos ) return mpWords->Words[mBufferPos-1];
 	else return NULL_WORD; 
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 void ReaderSource::GotoPos( ReaderPos Pos )
 {
+	//Words that have already been read can be jumped to directly.
+	if( Pos > mBufferPos && Pos <= mpWords->Words.size() )
+	{
+		mBufferPos = Pos;
+		UpdateCurrentLine();
+		return;
+	}
+	
+	//Finished words can't be read any further.
+	if( !mpOwnWords && Pos > mpWords->Words.size() ) Pos = (ReaderPos)mpWords->Words.size();
+	
 	while( Pos > mBufferPos )
 	{
 		GetNextWord();
@@ -427,11 +453,78 @@ void ReaderSource::GotoPos( ReaderPos Pos )
 }
 
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ReaderPos ReaderSource::GetMatchingBracket( ReaderPos Pos )
+{
+	const WordBuffer& Buffer = mpWords->Words;
+	
+	if( Pos >= Buffer.size() || Buffer[Pos].Extra != EXTRA_BRACKET_Left )
+	{
+		ThrowParserAnomaly( TXT("Tried to find the match of something that isn't a '{'. "
+								"Probably a bug, please report."), ANOMALY_PANIC );
+	}
+	
+	while( mpWords->MatchingBracket[Pos] == 0 )
+	{
+		if( Buffer.back().Type == WORDTYPE_EOFWORD ) return (ReaderPos)Buffer.size() - 1;
+		ReadAhead();
+	}
+	
+	return mpWords->MatchingBracket[Pos];
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ReaderPos ReaderSource::GetNextTerminal( ReaderPos Pos )
+{
+	const WordBuffer& Buffer = mpWords->Words;
+	
+	while( Pos >= mpWords->NextTerminal.size() )
+	{
+		if( !Buffer.empty() && Buffer.back().Type == WORDTYPE_EOFWORD ){
+			return (ReaderPos)Buffer.size() - 1;
+		}
+		ReadAhead();
+	}
+	
+	return mpWords->NextTerminal[Pos];
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ReaderPos ReaderSource::GetNextTerminalOrBracket( ReaderPos Pos )
+{
+	const WordBuffer& Buffer = mpWords->Words;
+	
+	while( Pos >= mpWords->NextTerminalOrBracket.size() )
+	{
+		if( !Buffer.empty() && Buffer.back().Type == WORDTYPE_EOFWORD ){
+			return (ReaderPos)Buffer.size() - 1;
+		}
+		ReadAhead();
+	}
+	
+	return mpWords->NextTerminalOrBracket[Pos];
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void ReaderSource::ReadAhead()
+{
+	size_t OldPos = mBufferPos;
+	
+	mBufferPos = mpWords->Words.size();
+	GetNextWord();
+	
+	mBufferPos = OldPos;
+}
+
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 void ReaderSource::GotoLine( unsigned long LineNumber )
 {
-	if( LineNumber < mLinePositions.size() ){	
-		GotoPos( mLinePositions[LineNumber] );
+	if( LineNumber < mpWords->LinePositions.size() ){	
+		GotoPos( mpWords->LinePositions[LineNumber] );
 		return;
 	}
 	
@@ -462,16 +555,161 @@ unsigned long ReaderSource::GetLineNumber() const
 		the previous line.  Otherwise it will report the wrong line
 		when it throws errors sometimes.
 	*/
-	if( mLinePositions[mCurrentLine] == mBufferPos )
+	const std::vector<ReaderPos>& LinePositions = mpWords->LinePositions;
+	
+	if( LinePositions[mCurrentLine] == mBufferPos )
 	{
 		unsigned long i = mCurrentLine;
-		while( mBufferPos <= mLinePositions[i] && i > 0 ) i--;
+		while( mBufferPos <= LinePositions[i] && i > 0 ) i--;
 		return i+1;
 	}
 	else return mCurrentLine + 1;
 }
 
 
+/*
+	The cache is just the words and the line table written out field by field.
+	It's only ever read back on the machine that wrote it, so no effort is
+	made to make it portable.
+*/
+
+static void WriteCacheValue( std::ostream& Out, boost::uint32_t Value )
+{
+	Out.write( (const char*)&Value, sizeof(Value) );
+}
+
+static bool ReadCacheValue( const char*& pData, const char* pEnd, boost::uint32_t& Value )
+{
+	if( (size_t)(pEnd - pData) < sizeof(Value) ) return false;
+	memcpy( &Value, pData, sizeof(Value) );
+	pData += sizeof(Value);
+	return true;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void ReaderSource::WriteCache( std::ostream& Out ) const
+{
+	const WordBuffer& Buffer = mpWords->Words;
+	const std::vector<ReaderPos>& LinePositions = mpWords->LinePositions;
+	
+	WriteCacheValue( Out, (boost::uint32_t)Buffer.size() );
+	
+	WordBuffer::const_iterator i;
+	for( i = Buffer.begin(); i != Buffer.end(); i++ )
+	{
+		WriteCacheValue( Out, (boost::uint32_t)i->Type );
+		WriteCacheValue( Out, (boost::uint32_t)i->Extra );
+		WriteCacheValue( Out, (boost::uint32_t)i->Str.size() );
+		
+		CompoundString::const_iterator j;
+		for( j = i->Str.begin(); j != i->Str.end(); j++ )
+		{
+			WriteCacheValue( Out, (boost::uint32_t)j->size() );
+			Out.write( (const char*)j->data(), j->size() * sizeof(Char) );
+		}
+	}
+	
+	WriteCacheValue( Out, (boost::uint32_t)LinePositions.size() );
+	
+	std::vector<ReaderPos>::const_iterator k;
+	for( k = LinePositions.begin(); k != LinePositions.end(); k++ ){
+		WriteCacheValue( Out, (boost::uint32_t)*k );
+	}
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool ReaderSource::ReadCache( const char* pData, size_t Size )
+{
+	if( !mpOwnWords || !mpOwnWords->Words.empty() ) return false;
+	
+	const char* pEnd = pData + Size;
+	boost::uint32_t WordCount, Type, Extra, StrCount, Length, LineCount, LinePos;
+	
+	WordBuffer Words;
+	if( !ReadCacheValue( pData, pEnd, WordCount ) ) return false;
+	Words.reserve( WordCount );
+	
+	while( Words.size() < WordCount )
+	{
+		if( !ReadCacheValue( pData, pEnd, Type ) ||
+			!ReadCacheValue( pData, pEnd, Extra ) ||
+			!ReadCacheValue( pData, pEnd, StrCount ) )
+		{
+			return false;
+		}
+		
+		Words.push_back( Word( (WordType)Type, (ExtraDesc)Extra ) );
+		
+		while( Words.back().Str.size() < StrCount )
+		{
+			if( !ReadCacheValue( pData, pEnd, Length ) ||
+				(size_t)(pEnd - pData) < Length * sizeof(Char) )
+			{
+				return false;
+			}
+			
+			Words.back().Str.push_back( String( (const Char*)pData, Length ) );
+			pData += Length * sizeof(Char);
+		}
+	}
+	
+	std::vector<ReaderPos> LinePositions;
+	if( !ReadCacheValue( pData, pEnd, LineCount ) ) return false;
+	
+	while( LinePositions.size() < LineCount )
+	{
+		if( !ReadCacheValue( pData, pEnd, LinePos ) ) return false;
+		LinePositions.push_back( LinePos );
+	}
+	
+	if( pData != pEnd || LinePositions.empty() ) return false;
+	
+	
+	//Push the words one at a time so that the jump tables get built.
+	mpOwnWords->Words.reserve( Words.size() );
+	for( WordBuffer::const_iterator i = Words.begin(); i != Words.end(); i++ ){
+		PushWord( *i );
+	}
+	
+	//Nothing has actually been read yet.
+	mBufferPos = 0;
+	mpOwnWords->LinePositions.swap( LinePositions );
+	mCurrentLine = 0;
+	
+	return true;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+SourceWordsPtr ReaderSource::FinishWords()
+{
+	if( mpOwnWords )
+	{
+		while( mpOwnWords->Words.empty() || mpOwnWords->Words.back().Type != WORDTYPE_EOFWORD ){
+			ReadAhead();
+		}
+		
+		mpOwnWords = 0;
+	}
+	
+	return mpWords;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void ReaderSource::UseWords( SourceWordsPtr pWords )
+{
+	mpWords = pWords;
+	mpOwnWords = 0;
+	mOpenBrackets.clear();
+	
+	mBufferPos = 0;
+	mCurrentLine = 0;
+}
+
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 bool ReaderSource::SkipWhitespace()
 {
@@ -544,32 +782,52 @@ bool ReaderSource::FastForward()
 
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
-const Char& ReaderSource::Get()
+void ReaderSource::GetNextLine( String& Storage, const Char*& pLine, size_t& Length )
 {
-	if( mReadStringPos >= mReadString.size() )
+	Storage = GetNextLine();
+	pLine = Storage.data();
+	Length = Storage.size();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void ReaderSource::NextLine()
+{
+	mReadStringPos = 0;
+	
+	if( mHavePeekLine )
 	{
-		mReadStringPos = 0;
+		//The swap can move short strings around, so the pointer has to follow.
+		bool InStorage = mpPeekLine == mPeekString.data();
+		mReadString.swap( mPeekString );
+		mPeekString.clear();
 		
-		if( !mPeekString.empty() ){
-			mReadString.swap( mPeekString );
-			mPeekString.clear();
-		}
-		else{
-			mReadString = GetNextLine();
-		}
+		mpReadLine = InStorage ? mReadString.data() : mpPeekLine;
+		mReadLineLength = mPeekLineLength;
+		mHavePeekLine = false;
+	}
+	else{
+		GetNextLine( mReadString, mpReadLine, mReadLineLength );
 	}
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+const Char& ReaderSource::Get()
+{
+	if( mReadStringPos >= mReadLineLength ) NextLine();
 	
-	if( mReadString.empty() ) return EOF_Char;
+	if( mReadLineLength == 0 ) return EOF_Char;
 	
 	
-	const Char& R = mReadString[mReadStringPos];
+	const Char& R = mpReadLine[mReadStringPos];
 	mReadStringPos++;
 	
 	if( R == '\n' || R == '\r' ){
-		 mLinePositions.push_back( GetPos() );
+		 mpOwnWords->LinePositions.push_back( GetPos() );
 		 
 		 //This is to (hopefully) handle every whack-ass kind of newline correctly.
-		 mReadStringPos = mReadString.size();
+		 mReadStringPos = mReadLineLength;
 	}
 	
 	return R;
@@ -579,14 +837,17 @@ const Char& ReaderSource::Get()
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 const void ReaderSource::UnGet()
 {
+	//Nothing to put back at the end of the stream.
+	if( mReadLineLength == 0 ) return;
+	
 	//This is the compensate for the fact that any group of newline
 	//characters at the of the string are streated as one newline.
-	if( mReadStringPos == mReadString.size() )
+	if( mReadStringPos == mReadLineLength )
 	{
 		do{
 			mReadStringPos--;
 		}while( mReadStringPos > 0 && 
-			    IsNewline( mReadString[mReadStringPos] ) );
+			    IsNewline( mpReadLine[mReadStringPos] ) );
 		
 		return;
 	}
@@ -598,42 +859,74 @@ const void ReaderSource::UnGet()
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 const Char& ReaderSource::Peek()
 {
-	if( mReadStringPos >= mReadString.size() )
+	if( mReadStringPos >= mReadLineLength )
 	{
-		if( mPeekString.empty() ) mPeekString = GetNextLine();
+		if( !mHavePeekLine ){
+			GetNextLine( mPeekString, mpPeekLine, mPeekLineLength );
+			mHavePeekLine = true;
+		}
 		
-		if( mPeekString.empty() ) return EOF_Char;		
-		else return mPeekString[0];		
+		if( mPeekLineLength == 0 ) return EOF_Char;		
+		else return mpPeekLine[0];		
 	}
-	else return mReadString[mReadStringPos];
+	else return mpReadLine[mReadStringPos];
 }
 
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 const Word& ReaderSource::PushWord( const Word& W )
 {
-	mBuffer.push_back( W );
+	SourceWords& Own = *mpOwnWords;
+	
+	Own.Words.push_back( W );
+	Own.MatchingBracket.push_back( 0 );
+	
+	ReaderPos Pos = (ReaderPos)Own.Words.size() - 1;
+	
+	//Identifiers are interned here, so nobody down the line has to compare strings.
+	if( W.Type == WORDTYPE_IDENTIFIER ){
+		SymbolTable::Instance().Intern( W.Str, Own.Words.back().Sym );
+	}
+	
+	//Fill in the jump tables that the interpreter uses to skip over things.
+	if( W.Extra == EXTRA_BRACKET_Left )
+	{
+		mOpenBrackets.push_back( Pos );
+		Own.NextTerminalOrBracket.resize( Own.Words.size(), Pos );
+	}
+	else if( W.Extra == EXTRA_BRACKET_Right && !mOpenBrackets.empty() )
+	{
+		Own.MatchingBracket[ mOpenBrackets.back() ] = Pos;
+		mOpenBrackets.pop_back();
+	}
+	else if( W.Type == WORDTYPE_TERMINAL )
+	{
+		Own.NextTerminal.resize( Own.Words.size(), Pos );
+		Own.NextTerminalOrBracket.resize( Own.Words.size(), Pos );
+	}
 	
 	//There isn't a better place to do this, so...
 	mBufferPos++;
 	//UpdateCurrentLine();
 	
-	return mBuffer.back();	
+	return Own.Words.back();	
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 void ReaderSource::UpdateCurrentLine() const
 {
+	const std::vector<ReaderPos>& LinePositions = mpWords->LinePositions;
+	
 	//Go down a line
 	while( mCurrentLine != 0 &&
-		   mBufferPos < mLinePositions[mCurrentLine] )
+		   mBufferPos < LinePositions[mCurrentLine] )
 	{
 		mCurrentLine--;		
 	}
 	
 	//Go up a line
-	while( mLinePositions.size() > mCurrentLine + 1 &&
-		   mBufferPos >= mLinePositions[mCurrentLine + 1] )
+	while( LinePositions.size() > mCurrentLine + 1 &&
+		   mBufferPos >= LinePositions[mCurrentLine + 1] )
 	{
 		mCurrentLine++;
 	}	
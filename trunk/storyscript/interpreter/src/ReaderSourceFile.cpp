@@ -8,23 +8,54 @@ NOTES: A specialization of ReaderSource that reads from files.
 
 #include "ReaderSourceFile.hpp"
 #include "ParserAnomaly.hpp"
+#include "HelperFuncs.hpp"
+
+#include <iterator>
+#include <cstring>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <cstdio>
+
+#if !defined(PLAT_WIN32)
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 using namespace SS;
 
-//Thats 1K - 2K per file extra, which isn't too bad I guess.
-const int BUFFER_SIZE = 1024;
+//Change this whenever the cache format changes.
+const char CACHE_MAGIC[4] = { 'S', 'S', 'C', '1' };
+const size_t CACHE_HEADER_SIZE = sizeof(CACHE_MAGIC) + sizeof(boost::uint32_t) + 3 * sizeof(boost::uint64_t);
 
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
  NOTES: ctors
 */
 ReaderSourceFile::ReaderSourceFile()
-	: mpBuffer( new Char[BUFFER_SIZE] )
+	: mIsOpen( false ),
+	  mUseCache( false ),
+	  mCacheCurrent( false ),
+	  mFileTime( 0 ),
+	  mFileHash( 0 ),
+	  mpData( 0 ),
+	  mDataSize( 0 ),
+	  mDataPos( 0 ),
+	  mpMapping( 0 )
 {
 }
 
-ReaderSourceFile::ReaderSourceFile( const String& FileName )
-	: mpBuffer( new Char[BUFFER_SIZE] )
+ReaderSourceFile::ReaderSourceFile( const String& FileName, bool UseCache /*=false*/ )
+	: mIsOpen( false ),
+	  mUseCache( UseCache ),
+	  mCacheCurrent( false ),
+	  mFileTime( 0 ),
+	  mFileHash( 0 ),
+	  mpData( 0 ),
+	  mDataSize( 0 ),
+	  mDataPos( 0 ),
+	  mpMapping( 0 )
 {
 	Open( FileName );
 }
@@ -35,7 +66,6 @@ ReaderSourceFile::ReaderSourceFile( const String& FileName )
 ReaderSourceFile::~ReaderSourceFile()
 {
 	Close();
-	delete [] mpBuffer;
 }
 
 
@@ -46,17 +76,85 @@ void ReaderSourceFile::Open( const String& FileName )
 {
 	if( IsOpen() ) Close();
 
-	mFile.open( NarrowizeString( FileName ).c_str() /*, std::ios::binary*/ );
+	mFileName = FileName;
+
+	if( !MapFile() ) ReadFile();
+
+	mDataPos = 0;
+	mIsOpen = true;
+	mCacheCurrent = false;
+
+	if( mUseCache )
+	{
+		HashFile();
+
+		if( LoadCache() )
+		{
+			//Every word is already in the buffer, so there's nothing left to read.
+			mDataPos = mDataSize;
+			mCacheCurrent = true;
+		}
+	}
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: Maps the file into memory.  Returns false if the file isn't something
+ 		that can be mapped (a pipe, an empty file, or just not supported here),
+ 		in which case it has to be read instead.
+*/
+bool ReaderSourceFile::MapFile()
+{
+#if !defined(PLAT_WIN32)
+	int File = open( NarrowizeString( mFileName ).c_str(), O_RDONLY );
+	if( File < 0 ) return false;
 
-	if( !mFile )
+	struct stat Info;
+	if( fstat( File, &Info ) != 0 || !S_ISREG( Info.st_mode ) || Info.st_size == 0 )
+	{
+		close( File );
+		return false;
+	}
+
+	void* pMapping = mmap( 0, (size_t)Info.st_size, PROT_READ, MAP_PRIVATE, File, 0 );
+	close( File );
+
+	if( pMapping == MAP_FAILED ) return false;
+
+	//It all gets read front to back.
+	madvise( pMapping, (size_t)Info.st_size, MADV_SEQUENTIAL );
+
+	mpMapping = pMapping;
+	mpData = (const char*)pMapping;
+	mDataSize = (size_t)Info.st_size;
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: Reads the whole file into memory in one go.
+*/
+void ReaderSourceFile::ReadFile()
+{
+	std::ifstream File( NarrowizeString( mFileName ).c_str(), std::ios::binary );
+
+	if( !File )
 	{
 		String tmp = TXT("Cannot find file \'");
-		tmp += FileName;
+		tmp += mFileName;
 		tmp += TXT("\'. Check your spelling.");
+		mFileName.clear();
 		ThrowParserAnomaly( tmp, ANOMALY_BADFILE );
 	}
 
-	mFileName = FileName;	
+	mContents.assign( std::istreambuf_iterator<char>( File ),
+					  std::istreambuf_iterator<char>() );
+
+	mpData = mContents.data();
+	mDataSize = mContents.size();
 }
 
 
@@ -65,11 +163,19 @@ void ReaderSourceFile::Open( const String& FileName )
 */
 void ReaderSourceFile::Close()
 {
-	if( mFile.is_open() )
-	{
-		mFile.close();
-		mFileName.clear();		
-	}
+	if( !mIsOpen ) return;
+
+#if !defined(PLAT_WIN32)
+	if( mpMapping ) munmap( mpMapping, mDataSize );
+#endif
+
+	mpMapping = 0;
+	mpData = 0;
+	mDataSize = mDataPos = 0;
+	mContents.clear();
+
+	mFileName.clear();
+	mIsOpen = false;
 }
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
@@ -77,7 +183,7 @@ void ReaderSourceFile::Close()
 */
 bool ReaderSourceFile::IsOpen()
 {
-	return mFile.is_open();
+	return mIsOpen;
 }
 
 
@@ -90,17 +196,207 @@ String ReaderSourceFile::GetName() const
 }
 
 
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: Turns the token cache on or off.
+*/
+void ReaderSourceFile::SetUseCache( bool Flag /*=true*/ )
+{
+	mUseCache = Flag;
+}
+
+bool ReaderSourceFile::IsUsingCache() const
+{
+	return mUseCache;
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: Returns the name of the cache file, which just has ".ssc" tacked on.
+*/
+String ReaderSourceFile::GetCacheName() const
+{
+	return mFileName + TXT(".ssc");
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: Works out what the cache is keyed on: the modification time and a
+ 		hash of the contents (FNV-1a).  The size is just mDataSize.
+*/
+void ReaderSourceFile::HashFile()
+{
+	struct stat Info;
+	if( stat( NarrowizeString( mFileName ).c_str(), &Info ) == 0 ) mFileTime = (boost::uint64_t)Info.st_mtime;
+	else mFileTime = 0;
+
+	mFileHash = 14695981039346656037ULL;
+	for( size_t i = 0; i < mDataSize; i++ )
+	{
+		mFileHash ^= (unsigned char)mpData[i];
+		mFileHash *= 1099511628211ULL;
+	}
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: Reads the cache file in one go and hands the words to the
+ 		ReaderSource.  Returns false if there's no cache, or if it is out of
+ 		date or corrupt, in which case the file just gets tokenized as usual.
+*/
+bool ReaderSourceFile::LoadCache()
+{
+	std::ifstream File( NarrowizeString( GetCacheName() ).c_str(), std::ios::binary );
+	if( !File ) return false;
+
+	File.seekg( 0, std::ios::end );
+	std::streamoff Size = File.tellg();
+	File.seekg( 0, std::ios::beg );
+
+	if( Size < (std::streamoff)CACHE_HEADER_SIZE ) return false;
+
+	std::string Data( (size_t)Size, '\0' );
+	if( !File.read( &Data[0], Size ) ) return false;
+
+	const char* pData = Data.data();
+
+	boost::uint32_t CharSize;
+	boost::uint64_t Key[3];
+	memcpy( &CharSize, pData + sizeof(CACHE_MAGIC), sizeof(CharSize) );
+	memcpy( Key, pData + sizeof(CACHE_MAGIC) + sizeof(CharSize), sizeof(Key) );
+
+	if( memcmp( pData, CACHE_MAGIC, sizeof(CACHE_MAGIC) ) != 0 ||
+		CharSize != sizeof(Char) ||
+		Key[0] != mDataSize || Key[1] != mFileTime || Key[2] != mFileHash )
+	{
+		return false;
+	}
+
+	return ReadCache( pData + CACHE_HEADER_SIZE, Data.size() - CACHE_HEADER_SIZE );
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: Writes the cache file.  It's written to a temporary file first
+ 		so that nobody ever sees half of one.  If it can't be written
+ 		(read-only directory, etc.) it is just skipped.
+*/
+void ReaderSourceFile::SaveCache()
+{
+	std::string CacheName = NarrowizeString( GetCacheName() );
+	std::string TempName = CacheName + ".tmp";
+
+	{
+		std::ofstream File( TempName.c_str(), std::ios::binary | std::ios::trunc );
+		if( !File ) return;
+
+		boost::uint32_t CharSize = sizeof(Char);
+		boost::uint64_t Key[3] = { mDataSize, mFileTime, mFileHash };
+
+		File.write( CACHE_MAGIC, sizeof(CACHE_MAGIC) );
+		File.write( (const char*)&CharSize, sizeof(CharSize) );
+		File.write( (const char*)Key, sizeof(Key) );
+
+		WriteCache( File );
+
+		if( !File )
+		{
+			File.close();
+			remove( TempName.c_str() );
+			return;
+		}
+	}
+
+	//Windows won't rename over an existing file.
+	remove( CacheName.c_str() );
+	if( rename( TempName.c_str(), CacheName.c_str() ) != 0 ) remove( TempName.c_str() );
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: The whole file has been tokenized, so save it if the cache is on.
+*/
+void ReaderSourceFile::EndOfStream()
+{
+	if( mUseCache && !mCacheCurrent )
+	{
+		SaveCache();
+		mCacheCurrent = true;
+	}
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: Finds the bounds of the next line, including its line-break
+ 		(which can be "\n", "\r\n", or "\r").  Returns false at the end
+ 		of the file.
+*/
+bool ReaderSourceFile::FindNextLine( const char*& pBegin, const char*& pEnd )
+{
+	if( mDataPos >= mDataSize ) return false;
+
+	pBegin = mpData + mDataPos;
+	const char* pLast = mpData + mDataSize;
+
+	pEnd = pBegin;
+	while( pEnd != pLast && *pEnd != '\n' && *pEnd != '\r' ) pEnd++;
+
+	if( pEnd != pLast )
+	{
+		if( *pEnd == '\r' && pEnd + 1 != pLast && *(pEnd + 1) == '\n' ) pEnd++;
+		pEnd++;
+	}
+
+	mDataPos = pEnd - mpData;
+	return true;
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: Hands the tokenizer the next line straight out of the file's contents.
+*/
+void ReaderSourceFile::GetNextLine( String& Storage, const Char*& pLine, size_t& Length )
+{
+	const char* pBegin;
+	const char* pEnd;
+
+	if( !FindNextLine( pBegin, pEnd ) )
+	{
+		pLine = 0;
+		Length = 0;
+		return;
+	}
+
+#if !defined(USING_UNICODE)
+	if( pEnd[-1] == '\n' || pEnd[-1] == '\r' )
+	{
+		pLine = pBegin;
+		Length = pEnd - pBegin;
+		return;
+	}
+#endif
+
+	//Either the characters need widening, or this is the last line and it
+	//is missing its line-break (the tokenizer expects every line to have one).
+	Storage.assign( pBegin, pEnd );
+	if( !IsNewline( Storage[Storage.size() - 1] ) ) Storage += TXT("\n");
+
+	pLine = Storage.data();
+	Length = Storage.size();
+}
+
+
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
  NOTES: Returns the next line from the file including all
  		line-breaks/carriage-returns.  Returns a blank string if eof reached.
 */
 String ReaderSourceFile::GetNextLine()
 {
-	if( mFile.eof() ) return String();
-	mFile.getline( mpBuffer, BUFFER_SIZE );
-
-	//I have to add the newline since getline won't store it.
-	return String( mpBuffer ) + String(TXT("\n"));
-}
+	const char* pBegin;
+	const char* pEnd;
 
+	if( !FindNextLine( pBegin, pEnd ) ) return String();
 
+	String Line( pBegin, pEnd );
+	if( !IsNewline( Line[Line.size() - 1] ) ) Line += TXT("\n");
+	return Line;
+}
@@ -0,0 +1,172 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+#include "RuntimeContext.hpp"
+#include "CreationFuncs.hpp"
+#include "List.hpp"
+#include "Variable.hpp"
+
+using namespace SS;
+
+
+SS_THREAD_LOCAL RuntimeContext* RuntimeContext::smpCurrent = 0;
+volatile boost::uint64_t RuntimeContext::smCountingContexts = 0;
+
+//The default context, once it has been made.
+static RuntimeContext* gpDefaultContext = 0;
+//True once the default context has been destroyed at exit.
+static bool gDefaultContextDestroyed = false;
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+static RuntimeContext& GetDefaultContext()
+{
+	static RuntimeContext TheDefault;
+	//Only the first call gets to this.
+	static RuntimeContext* const pTheDefault = gpDefaultContext = &TheDefault;
+	return *pTheDefault;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+RuntimeContext::RuntimeContext()
+	: mObjectsCreated( 0 ),
+	  mCountingObjects( false )
+{
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+RuntimeContext::~RuntimeContext()
+{
+	//Let go of everything while this is still current, so its numbers
+	//come back to this pool rather than some other context's.
+	RuntimeContext* pOldContext = SetCurrent( this );
+	mpNANConst.reset();
+	mpInfinityConst.reset();
+	mpNegInfinityConst.reset();
+	mpNewLineConst.reset();
+	mpEmptyStringConst.reset();
+	mpEmptyList.reset();
+	mNumPool.Clear();
+
+	SetCurrent( pOldContext == this ? 0 : pOldContext );
+	SetCountingObjects( false );
+
+	if( gpDefaultContext == this )
+	{
+		gpDefaultContext = 0;
+		gDefaultContextDestroyed = true;
+	}
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void RuntimeContext::SetCountingObjects( bool flag /*=true*/ )
+{
+	if( flag == mCountingObjects ) return;
+	mCountingObjects = flag;
+
+	if( flag ) AtomicIncrement( smCountingContexts );
+	else AtomicDecrement( smCountingContexts );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+RuntimeContext& RuntimeContext::Current()
+{
+	if( smpCurrent ) return *smpCurrent;
+	return GetDefaultContext();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+RuntimeContext* RuntimeContext::Find()
+{
+	if( smpCurrent ) return smpCurrent;
+	if( gDefaultContextDestroyed ) return 0;
+	return &GetDefaultContext();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+RuntimeContext* RuntimeContext::SetCurrent( RuntimeContext* pContext )
+{
+	RuntimeContext* pOldContext = smpCurrent;
+	smpCurrent = pContext;
+	return pOldContext;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void RuntimeContext::InitConstants()
+{
+	mpNANConst = CreateVariable<Variable>( TXT("_NAN_"), false, 0 );
+	mpfr_set_nan( mpNANConst->GetActualNumData().get() );
+	mpNANConst->ForceConversion( VARTYPE_NUM );
+	mpNANConst->SetConst();
+
+	mpInfinityConst = CreateVariable<Variable>( TXT("_INF_"), false, 0 );
+	mpfr_set_inf( mpInfinityConst->GetActualNumData().get(), 1 );
+	mpInfinityConst->ForceConversion( VARTYPE_NUM );
+	mpInfinityConst->SetConst();
+
+	mpNegInfinityConst = CreateVariable<Variable>( TXT("_NEGINF_"), false, 0 );
+	mpfr_set_inf( mpNegInfinityConst->GetActualNumData().get(), -1 );
+	mpNegInfinityConst->ForceConversion( VARTYPE_NUM );
+	mpNegInfinityConst->SetConst();
+
+	mpNewLineConst = CreateVariable<Variable>( TXT("endl"), true, String(TXT("\n")) );
+	mpEmptyStringConst = CreateVariable<Variable>( String(), true, String() );
+
+	//VERY IMPORTANT THAT THIS GETS SET
+	mpEmptyList = CreateGeneric<List>( String(), true );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+const VariablePtr& RuntimeContext::GetNANConst()
+{
+	if( !mpNANConst ) InitConstants();
+	return mpNANConst;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+const VariablePtr& RuntimeContext::GetInfinityConst()
+{
+	if( !mpNANConst ) InitConstants();
+	return mpInfinityConst;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+const VariablePtr& RuntimeContext::GetNegInfinityConst()
+{
+	if( !mpNANConst ) InitConstants();
+	return mpNegInfinityConst;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+const VariablePtr& RuntimeContext::GetNewLineConst()
+{
+	if( !mpNANConst ) InitConstants();
+	return mpNewLineConst;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+const VariablePtr& RuntimeContext::GetEmptyStringConst()
+{
+	if( !mpNANConst ) InitConstants();
+	return mpEmptyStringConst;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+const ListPtr& RuntimeContext::GetEmptyList()
+{
+	if( !mpNANConst ) InitConstants();
+	return mpEmptyList;
+}
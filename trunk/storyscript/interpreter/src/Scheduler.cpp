@@ -0,0 +1,459 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+#include "Scheduler.hpp"
+#include "Interface.hpp"
+#include "ParserAnomaly.hpp"
+#include "HelperFuncs.hpp"
+#include "Block.hpp"
+#include "Unicode.hpp"
+
+#include <exception>
+
+using namespace SS;
+
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Session::Session( const String& FileName, const String& BlockName /*=String()*/,
+				  ScriptImagePtr pImage /*=ScriptImagePtr()*/ )
+	: mFileName( FileName ),
+	  mBlockName( BlockName ),
+	  mStarted( false ),
+	  mHasChoice( false ),
+	  mChoice( 0 ),
+	  mpScheduler( 0 ),
+	  mState( SESSION_READY )
+{
+	mI.SetScriptImage( pImage );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Session::~Session()
+{
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Interpreter& Session::GetInterpreter()
+{
+	return mI;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+SessionState Session::GetState() const
+{
+	//The state is settled before the scheduler lets go of the session.
+	Scheduler* pScheduler = AtomicLoadPointer( mpScheduler );
+	if( !pScheduler ) return mState;
+
+	MutexLock Lock( pScheduler->mMutex );
+	return mState;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+SessionStats Session::GetStats() const
+{
+	Scheduler* pScheduler = AtomicLoadPointer( mpScheduler );
+	if( !pScheduler ) return mStats;
+
+	MutexLock Lock( pScheduler->mMutex );
+	return mStats;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+const BlockList& Session::GetPendingChoices() const
+{
+	return mI.GetPendingChoices();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Session::OnWaiting()
+{
+}
+
+void Session::OnFinished()
+{
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+StepState Session::RunSlice( unsigned int MaxLines, boost::uint64_t MaxTime,
+							 unsigned int& Lines )
+{
+	Lines = 0;
+	boost::uint64_t StartTime = MaxTime ? GetMicroseconds() : 0;
+
+	try{
+		if( !mStarted )
+		{
+			mStarted = true;
+			mI.OpenFile( mFileName );
+
+			if( mBlockName.length() != 0 ) mI.Start( mBlockName );
+			else mI.Start( mI.GetFirstBlock() );
+		}
+
+		if( mHasChoice )
+		{
+			mHasChoice = false;
+			mI.ResumeWithChoice( mChoice );
+		}
+
+		while( Lines < MaxLines && mI.GetStepState() == STEP_RUNNING )
+		{
+			Lines++;
+			mI.Step();
+
+			if( MaxTime && GetMicroseconds() - StartTime >= MaxTime ) break;
+		}
+	}
+	catch( ParserAnomaly E )
+	{
+		Abandon( E );
+		return STEP_FINISHED;
+	}
+	catch( std::exception& E )
+	{
+		Abandon( ParserAnomaly( NormalizeString( E.what() ), ANOMALY_PANIC,
+								SS_FILE, SS_LINE, SS_FUNC ) );
+		return STEP_FINISHED;
+	}
+	catch( ... )
+	{
+		Abandon( ParserAnomaly( TXT("Unknown exception while running a session."),
+								ANOMALY_PANIC, SS_FILE, SS_LINE, SS_FUNC ) );
+		return STEP_FINISHED;
+	}
+
+	return mI.GetStepState();
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: This is on a worker thread, and anything thrown past it would take
+		the whole process down.  So if the interface throws (NullInterface
+		does), or there isn't one, the anomaly is dropped.
+*/
+void Session::Abandon( const ParserAnomaly& E )
+{
+	try{
+		//Same as Interface::StartConversation
+		if( E.ErrorCode == ANOMALY_NOBLOCKS )
+		{
+			if( mI.IsVerbose() ){
+				mI.GetInterface().LogMessage( TXT("\nNo blocks to execute.  Exiting...\n") );
+			}
+		}
+		else mI.GetInterface().HandleParserAnomaly( E );
+	}
+	catch( ... )
+	{
+	}
+
+	mI.Start( BlockPtr() );
+}
+
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Scheduler::Scheduler( unsigned int WorkerCount, unsigned int SliceLines /*=8*/,
+					  unsigned int SliceTime /*=0*/ )
+	: mSliceLines( SliceLines ? SliceLines : 1 ),
+	  mSliceTime( (boost::uint64_t)SliceTime * 1000 ),
+	  mReady( 0 ),
+	  mRunning( 0 ),
+	  mNextWorker( 0 ),
+	  mStopping( false )
+{
+	if( WorkerCount == 0 ) WorkerCount = 1;
+
+	//Every worker has to be there before any of them starts stealing.
+	size_t i;
+	for( i = 0; i < WorkerCount; i++ ){
+		mWorkers.push_back( new Worker( *this, i ) );
+	}
+
+	//If a thread can't be started, the ones that were have to be stopped
+	//before this goes away.
+	try{
+		for( i = 0; i < mWorkers.size(); i++ ){
+			mWorkers[i]->pThread = new Thread( &Scheduler::WorkerMain, mWorkers[i] );
+		}
+	}
+	catch( ParserAnomaly E )
+	{
+		StopWorkers();
+		throw E;
+	}
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Scheduler::~Scheduler()
+{
+	StopWorkers();
+
+	std::map< Session*, SessionPtr >::iterator j;
+	for( j = mSessions.begin(); j != mSessions.end(); j++ ){
+		AtomicStorePointer( j->first->mpScheduler, (Scheduler*)0 );
+	}
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Scheduler::StopWorkers()
+{
+	{
+		MutexLock Lock( mMutex );
+		mStopping = true;
+		mWorkReady.Broadcast();
+	}
+
+	size_t i;
+	for( i = 0; i < mWorkers.size(); i++ ){
+		if( mWorkers[i]->pThread ) mWorkers[i]->pThread->Join();
+	}
+
+	for( i = 0; i < mWorkers.size(); i++ )
+	{
+		delete mWorkers[i]->pThread;
+		delete mWorkers[i];
+	}
+	mWorkers.clear();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Scheduler::Add( SessionPtr pSession )
+{
+	size_t WorkerIndex;
+	{
+		MutexLock Lock( mMutex );
+		if( AtomicLoadPointer( pSession->mpScheduler ) ){
+			ThrowParserAnomaly( TXT("Session has already been added to a scheduler."),
+								ANOMALY_PANIC );
+		}
+
+		AtomicStorePointer( pSession->mpScheduler, this );
+		pSession->mState = SESSION_READY;
+		mSessions[pSession.get()] = pSession;
+		mReady++;
+
+		WorkerIndex = mNextWorker++ % mWorkers.size();
+	}
+
+	Push( pSession, WorkerIndex );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Scheduler::Resume( Session& S, unsigned int Choice )
+{
+	SessionPtr pSession;
+	size_t WorkerIndex;
+	{
+		MutexLock Lock( mMutex );
+		if( S.mpScheduler != this || S.mState != SESSION_WAITING ){
+			ThrowParserAnomaly( TXT("Session is not waiting on a choice."), ANOMALY_PANIC );
+		}
+
+		if( Choice >= S.mI.GetPendingChoices().size() ){
+			ThrowParserAnomaly( TXT("Choice index is out of range."), ANOMALY_NOLISTELEMENT );
+		}
+
+		S.mChoice = Choice;
+		S.mHasChoice = true;
+		S.mState = SESSION_READY;
+		pSession = mSessions[&S];
+		mReady++;
+
+		WorkerIndex = mNextWorker++ % mWorkers.size();
+	}
+
+	Push( pSession, WorkerIndex );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Scheduler::Wait()
+{
+	MutexLock Lock( mMutex );
+	while( mReady != 0 || mRunning != 0 ) mAllIdle.Wait( mMutex );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+size_t Scheduler::GetWorkerCount() const
+{
+	return mWorkers.size();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+SchedulerStats Scheduler::GetStats() const
+{
+	MutexLock Lock( mMutex );
+	return mStats;
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: The caller has already counted the session in mReady.  Once it is
+		in a queue a worker can take it, run it, and finish it before we
+		get mMutex back, and counting it after that would leave mReady
+		wrapped around, and Wait stuck.
+*/
+void Scheduler::Push( SessionPtr pSession, size_t WorkerIndex )
+{
+	{
+		Worker& W = *mWorkers[WorkerIndex];
+		MutexLock Lock( W.QueueMutex );
+		W.Queue.push_back( pSession );
+	}
+
+	MutexLock Lock( mMutex );
+	mWorkReady.Signal();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+SessionPtr Scheduler::Pop( Worker& W, bool& Stolen )
+{
+	SessionPtr pSession;
+	Stolen = false;
+
+	//Our own queue goes oldest first, so everyone gets their turn.
+	{
+		MutexLock Lock( W.QueueMutex );
+		if( !W.Queue.empty() )
+		{
+			pSession = W.Queue.front();
+			W.Queue.pop_front();
+			return pSession;
+		}
+	}
+
+	//Otherwise take the newest from someone else.
+	size_t i;
+	for( i = 1; i < mWorkers.size(); i++ )
+	{
+		Worker& Victim = *mWorkers[(W.Index + i) % mWorkers.size()];
+		MutexLock Lock( Victim.QueueMutex );
+		if( !Victim.Queue.empty() )
+		{
+			pSession = Victim.Queue.back();
+			Victim.Queue.pop_back();
+			Stolen = true;
+			return pSession;
+		}
+	}
+
+	return pSession;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Scheduler::WorkerMain( void* pWorker )
+{
+	Worker& W = *(Worker*)pWorker;
+	Scheduler& S = W.Owner;
+	SessionPtr pSession;
+	bool Stolen;
+
+	while( true )
+	{
+		pSession = S.Pop( W, Stolen );
+
+		if( pSession )
+		{
+			{
+				MutexLock Lock( S.mMutex );
+				S.mReady--;
+				S.mRunning++;
+				pSession->mState = SESSION_RUNNING;
+			}
+
+			S.RunSlice( W, pSession, Stolen );
+			pSession.reset();
+			continue;
+		}
+
+		MutexLock Lock( S.mMutex );
+		if( S.mStopping ) return;
+
+		//mReady can count a session that is still on its way into a
+		//queue, so only sleep when there is truly nothing.
+		if( S.mReady == 0 ) S.mWorkReady.Wait( S.mMutex );
+		if( S.mStopping ) return;
+	}
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Scheduler::RunSlice( Worker& W, SessionPtr pSession, bool Stolen )
+{
+	unsigned int Lines;
+	StepState State = pSession->RunSlice( mSliceLines, mSliceTime, Lines );
+
+	bool Requeue = false;
+	{
+		MutexLock Lock( mMutex );
+		mRunning--;
+
+		mStats.Lines += Lines;
+		mStats.Slices++;
+		if( Stolen ) mStats.Steals++;
+		pSession->mStats.Lines += Lines;
+		pSession->mStats.Slices++;
+
+		if( State == STEP_RUNNING )
+		{
+			pSession->mState = SESSION_READY;
+			Requeue = true;
+		}
+		else if( State == STEP_CHOICE )
+		{
+			pSession->mState = SESSION_WAITING;
+			pSession->mStats.Choices++;
+		}
+		else
+		{
+			pSession->mState = SESSION_FINISHED;
+			AtomicStorePointer( pSession->mpScheduler, (Scheduler*)0 );
+			mSessions.erase( pSession.get() );
+			mStats.Finished++;
+		}
+
+		//Counted as ready before it leaves the running count, so Wait
+		//never sees it as idle in between.
+		if( Requeue ) mReady++;
+		else if( mReady == 0 && mRunning == 0 ) mAllIdle.Broadcast();
+	}
+
+	//To the back of our own queue, behind everyone waiting their turn.
+	if( Requeue )
+	{
+		Push( pSession, W.Index );
+		return;
+	}
+
+	//Nothing may get out of a hook onto the worker either.
+	try{
+		if( State == STEP_CHOICE ) pSession->OnWaiting();
+		else pSession->OnFinished();
+	}
+	catch( ... )
+	{
+	}
+}
@@ -19,6 +19,9 @@ using namespace SS;
 
 const ScopeObjectPtr NULL_SO_PTR;
 
+volatile boost::uint64_t Scope::smNewestVersion = 0;
+SS_THREAD_LOCAL ScopeTrail* Scope::smpTrail = 0;
+
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 void Scope::AcceptVisitor( ScopeObjectVisitor& V )
@@ -32,6 +35,7 @@ void Scope::AcceptVisitor( ScopeObjectVisitor& V )
 Scope::Scope( SS_DECLARE_BASE_ARGS )
 : ScopeObject( SS_BASE_ARGS )
 {
+	mType = SCOPEOBJ_SCOPE;
 	RegisterPredefinedVars();
 }
 
@@ -41,6 +45,7 @@ Scope::Scope( SS_DECLARE_BASE_ARGS )
 void Scope::RegisterPredefinedVars()
 {
 	mNameCreated = mFullNameCreated = mDocStringCreated = false;
+	mVersion = GetNewestVersion();
 }
 
 
@@ -56,7 +61,9 @@ ScopeObjectPtr Scope::Register( ScopeObjectPtr pNewScopeObject )
 {
 	AssertNonConst();
 	
-	if( Exists( pNewScopeObject->GetName() ) )
+	SymbolID NameSymbol = Intern( pNewScopeObject->GetName() );
+	
+	if( Exists( NameSymbol ) )
 	{
 		String Temp = TXT("An object called \'");
 		Temp += pNewScopeObject->GetName();
@@ -72,11 +79,19 @@ ScopeObjectPtr Scope::Register( ScopeObjectPtr pNewScopeObject )
 	pNewScopeObject->UnRegister();
 	
 	//Put it on the list!
-	mList[pNewScopeObject->GetName()] = pNewScopeObject;
+	mList[NameSymbol] = pNewScopeObject;
 	
 	
 	pNewScopeObject->mpParent = this;
-	pNewScopeObject->mpThis = pNewScopeObject;
+	pNewScopeObject->mRegisteredSymbol = NameSymbol;
+	
+	//Lookups starting in the object now travel up through this scope
+	//(Everything but a plain ScopeObject is a Scope.)
+	if( pNewScopeObject->GetType() != SCOPEOBJ_SCOPEOBJECT )
+	{
+		static_cast<Scope*>( pNewScopeObject.get() )->Touch();
+	}
+	Touch();
 
 	return pNewScopeObject;
 }
@@ -85,6 +100,20 @@ ScopeObjectPtr Scope::Register( ScopeObjectPtr pNewScopeObject )
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 ScopeObjectPtr Scope::UnRegister( const SS::String& ObjName )
+{
+	SymbolID Symbol;
+	if( !SymbolTable::Instance().Find( ObjName, Symbol ) )
+	{
+		String tmp = TXT("Cannot delete object \'");
+		tmp += ObjName;
+		tmp += TXT("\'.  No such object exists.  This is probably caused by a bug in the interpreter.");
+		ThrowParserAnomaly( tmp, ANOMALY_PANIC );
+	}
+	
+	return UnRegister( Symbol );
+}
+
+ScopeObjectPtr Scope::UnRegister( SymbolID ObjName )
 {
 	AssertNonConst();
 	
@@ -93,7 +122,7 @@ ScopeObjectPtr Scope::UnRegister( const SS::String& ObjName )
 	if( i == mList.end() )
 	{
 		String tmp = TXT("Cannot delete object \'");
-		tmp += ObjName;
+		tmp += SymbolTable::Instance().GetString( ObjName );
 		tmp += TXT("\'.  No such object exists.  This is probably caused by a bug in the interpreter.");
 		ThrowParserAnomaly( tmp, ANOMALY_PANIC );		
 	}
@@ -104,6 +133,10 @@ ScopeObjectPtr Scope::UnRegister( const SS::String& ObjName )
 	
 	mList.erase( i );
 	
+	Scope* pOldScope = dynamic_cast<Scope*>( RetVal.get() );
+	if( pOldScope ) pOldScope->Touch();
+	Touch();
+	
 	return RetVal;
 }
 
@@ -121,15 +154,49 @@ void Scope::Clear()
 	*/
 	
 	mList.clear();
+	Touch();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Scope::ClearExcept( SymbolID Keep1, SymbolID Keep2 )
+{
+	bool Changed = false;
+
+	ScopeListType::iterator i = mList.begin();
+	while( i != mList.end() )
+	{
+		if( i->first == Keep1 || i->first == Keep2 ){
+			++i;
+			continue;
+		}
+
+		i->second->mpParent = 0;
+		Scope* pOldScope = dynamic_cast<Scope*>( i->second.get() );
+		if( pOldScope ) pOldScope->Touch();
+
+		mList.erase( i++ );
+		Changed = true;
+	}
+
+	//Nothing changed, so any lookups through here are still good.
+	if( Changed ) Touch();
 }
 
 
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 bool Scope::Exists( const String& ID )
+{
+	SymbolID Symbol;
+	if( !SymbolTable::Instance().Find( ID, Symbol ) ) return false;
+	return Exists( Symbol );
+}
+
+bool Scope::Exists( SymbolID ID )
 {
 	//Unnamed objects are ignored by this
-	if( ID.length() == 0 ) return false;
+	if( ID == NULL_SYMBOL ) return false;
 	
 	if( mList.find( ID ) != mList.end() ) return true;
 	
@@ -146,10 +213,22 @@ bool Scope::Exists( const String& ID )
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 ScopeObjectPtr Scope::GetScopeObject_NoThrow( const CompoundString& Identifier, unsigned long Level /*= 0*/  )
+{
+	CompoundSymbol Symbols;
+	if( !SymbolTable::Instance().Find( Identifier, Symbols ) ) return NULL_SO_PTR;
+	
+	return GetScopeObject_NoThrow( Symbols, Level );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ScopeObjectPtr Scope::GetScopeObject_NoThrow( const CompoundSymbol& Identifier, unsigned long Level /*= 0*/  )
 {	
 	if( Level >= Identifier.size() ) return NULL_SO_PTR;
+	
+	LeaveTrail();
 
-	if( Level == 0 && Identifier[0].empty() )
+	if( Level == 0 && Identifier[0] == NULL_SYMBOL )
 	{
 		return GetGlobalScope().GetScopeObject_NoThrow( Identifier, 1 );	
 	}
@@ -208,8 +287,39 @@ ScopeObjectPtr Scope::GetScopeObject( const CompoundString& Identifer )
 	}
 }
 
+ScopeObjectPtr Scope::GetScopeObject( const CompoundSymbol& Identifer )
+{
+	ScopeObjectPtr pReturnValue;
+	if( (pReturnValue = GetScopeObject_NoThrow( Identifer )) )
+	{
+		return pReturnValue;
+	}
+	else 
+	{
+		//Nothing found
+		String Temp = TXT("Cannot find any object named \'");
+		Temp += CollapseCompoundSymbol( Identifer );
+		Temp += TXT("\'.");
+		ThrowParserAnomaly( Temp, ANOMALY_IDNOTFOUND );
+	}
+}
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 ScopeObjectPtr Scope::GetScopeObjectLocal( const String& Identifier )
+{
+	SymbolID Symbol;
+	if( !SymbolTable::Instance().Find( Identifier, Symbol ) )
+	{
+		String Temp = TXT("Cannot find any object named \'");
+		Temp += Identifier;
+		Temp += TXT("\'.");
+		ThrowParserAnomaly( Temp, ANOMALY_IDNOTFOUND );
+	}
+	
+	return GetScopeObjectLocal( Symbol );
+}
+
+ScopeObjectPtr Scope::GetScopeObjectLocal( SymbolID Identifier )
 {
 	ScopeObjectPtr pReturnValue;
 	if( (pReturnValue = GetScopeObjectLocal_NoThrow( Identifier )) )
@@ -220,7 +330,7 @@ ScopeObjectPtr Scope::GetScopeObjectLocal( const String& Identifier )
 	{
 		//Nothing found
 		String Temp = TXT("Cannot find any object named \'");
-		Temp += Identifier;
+		Temp += SymbolTable::Instance().GetString( Identifier );
 		Temp += TXT("\'.");
 		ThrowParserAnomaly( Temp, ANOMALY_IDNOTFOUND );
 	}
@@ -228,6 +338,15 @@ ScopeObjectPtr Scope::GetScopeObjectLocal( const String& Identifier )
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 ScopeObjectPtr Scope::GetScopeObjectLocal_NoThrow( const String& Identifier )
 {
+	SymbolID Symbol;
+	if( !SymbolTable::Instance().Find( Identifier, Symbol ) ) return NULL_SO_PTR;
+	return GetScopeObjectLocal_NoThrow( Symbol );
+}
+
+ScopeObjectPtr Scope::GetScopeObjectLocal_NoThrow( SymbolID Identifier )
+{
+	LeaveTrail();
+	
 	/*
 		This object's hook gets called in case the implementer wants
 		to spring something into existance or do some other voodoo.
@@ -279,6 +398,7 @@ void Scope::Import( ScopePtr pScope )
 	}
 	
 	mImportedScopes.push_back( pScope );
+	Touch();
 }
 
 
@@ -287,12 +407,15 @@ void Scope::UnImport( ScopePtr pScope )
 {
     AssertNonConst();
 
-	unsigned int i;
-	for( i = 0; i < mImportedScopes.size(); i++ )
+	//Scopes are almost always un-imported in the reverse order they were
+	//imported in, so start looking at the back.
+	size_t i = mImportedScopes.size();
+	while( i-- )
 	{
 		if( pScope == mImportedScopes[i] )
 		{
             mImportedScopes.erase( mImportedScopes.begin() + i );
+			Touch();
 			return;
 		}
 	}
@@ -307,16 +430,25 @@ void Scope::UnImport( ScopePtr pScope )
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 ScopePtr Scope::CastToScope(){
 	AssertCastingAllowed();
-	return boost::dynamic_pointer_cast<Scope>( ScopeObjectPtr(mpThis) );
+	return ScopePtr( this );
 }
 
 const ScopePtr Scope::CastToScope() const{
 	AssertCastingAllowed();
-	return boost::dynamic_pointer_cast<Scope>( ScopeObjectPtr(mpThis) );
+	return ScopePtr( const_cast<Scope*>(this) );
 }
 
 
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ScopeTrail* Scope::SetTrail( ScopeTrail* pTrail )
+{
+	ScopeTrail* pOldTrail = smpTrail;
+	smpTrail = pTrail;
+	return pOldTrail;
+}
+
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 Scope& Scope::GetGlobalScope()
 {
@@ -325,20 +457,26 @@ Scope& Scope::GetGlobalScope()
 }
 
 
+//What GetScopeObjectHook answers to.  These are interned at startup, so the
+//names can be found even before a script has used them.
+static const SymbolID NameSymbol     = Intern( LC_Name );
+static const SymbolID FullNameSymbol = Intern( LC_FullName );
+static const SymbolID DocSymbol      = Intern( LC_Doc );
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
-ScopeObjectPtr Scope::GetScopeObjectHook( const String& Name )
+ScopeObjectPtr Scope::GetScopeObjectHook( SymbolID Name )
 {
-	if( !mNameCreated && Name == LC_Name )
+	if( !mNameCreated && Name == NameSymbol )
 	{
 		mNameCreated = true;	
 		return Register( ScopeObjectPtr( new BoundStringVar( LC_Name, true, mName ) ) );
 	}
-	else if( !mFullNameCreated && Name == LC_FullName )
+	else if( !mFullNameCreated && Name == FullNameSymbol )
 	{
 		mFullNameCreated = true;
 		return Register( ScopeObjectPtr( new FullNameVar( LC_FullName, true, *this ) ) );
 	}
-	else if( !mDocStringCreated && Name == LC_Doc )
+	else if( !mDocStringCreated && Name == DocSymbol )
 	{
 		mDocStringCreated = true;
 		ScopeObjectPtr Tmp = Register( ScopeObjectPtr( CreateVariable<Variable>( LC_Doc, false, String() ) ) );
@@ -356,3 +494,47 @@ String& Scope::GetDocString()
 }
 
 
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ScopeResolution::ScopeResolution()
+	: Valid( false ), pScope( 0 ), pStaticScope( 0 ), pSource( 0 ),
+	  Version( 0 ), Found( false )
+{
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool ScopeResolution::IsCurrent( const Scope* pNewScope, const Scope* pNewStaticScope, const ReaderSource* pNewSource )
+{
+	if( !Valid || pNewScope != pScope || pNewStaticScope != pStaticScope || pNewSource != pSource ) return false;
+	
+	if( pScopeWeak.expired() || (pStaticScope && pStaticScopeWeak.expired()) ) return false;
+	
+	//Nothing anywhere has changed
+	if( Version == Scope::GetNewestVersion() ) return true;
+	
+	//Something has, so make sure it wasn't anything we looked at
+	ScopeTrail::const_iterator i;
+	for( i = Trail.begin(); i != Trail.end(); i++ )
+	{
+		if( i->second.expired() || i->first->GetVersion() > Version ) return false;
+	}
+	
+	if( Found && Result.expired() ) return false;
+	
+	Version = Scope::GetNewestVersion();
+	return true;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void ScopeResolution::Reset()
+{
+	Valid = Found = false;
+	pScope = pStaticScope = 0;
+	pSource = 0;
+	pScopeWeak.reset();
+	pStaticScopeWeak.reset();
+	Trail.clear();
+	Result.reset();
+}
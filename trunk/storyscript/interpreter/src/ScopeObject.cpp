@@ -8,11 +8,12 @@ NOTES: Anything that can reside in a scope derives from this (Scope).
 
 #include "ScopeObject.hpp"
 #include "Block.hpp"
+#include "List.hpp"
 #include "ParserAnomaly.hpp"
 #include "Interpreter.hpp"
 #include "HelperFuncs.hpp"
 #include "CreationFuncs.hpp"
-#include <boost/shared_ptr.hpp>
+#include "RuntimeContext.hpp"
 
 
 
@@ -26,7 +27,38 @@ ScopeObject::ScopeObject( const String& Name /*= String()*/,
 {
 	mName = Name;
 	mConst = Const;
+	mType = SCOPEOBJ_SCOPEOBJECT;
 	mpParent = 0;
+	mRegisteredSymbol = NULL_SYMBOL;
+	mRefCount = 0;
+	mpWeakFlag = 0;
+	
+	RuntimeContext::CountObject();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ScopeObject::ScopeObject( const ScopeObject& O )
+	: mName( O.mName ),
+	  mType( O.mType ),
+	  mConst( O.mConst ),
+	  mpParent( O.mpParent ),
+	  mRegisteredSymbol( O.mRegisteredSymbol ),
+	  mRefCount( 0 ),
+	  mpWeakFlag( 0 )
+{
+	RuntimeContext::CountObject();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ScopeObject& ScopeObject::operator=( const ScopeObject& O )
+{
+	mName = O.mName;
+	mConst = O.mConst;
+	mpParent = O.mpParent;
+	mRegisteredSymbol = O.mRegisteredSymbol;
+	return *this;
 }
 
 
@@ -35,12 +67,18 @@ void ScopeObject::ZeroVars()
 {
 	mConst = false;
 	mpParent = 0;
+	mRegisteredSymbol = NULL_SYMBOL;
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 ScopeObject::~ScopeObject()
 {
-
+	//Let any WeakPtrs know.
+	if( mpWeakFlag )
+	{
+		mpWeakFlag->Alive = false;
+		if( --mpWeakFlag->Refs == 0 ) delete mpWeakFlag;
+	}
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
@@ -70,7 +108,7 @@ bool ScopeObject::IsRegistered() const
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 ScopePtr ScopeObject::GetParent() const
 {
-	return ScopePtr( mpParent, null_deleter() );
+	return ScopePtr( mpParent );
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
@@ -83,10 +121,9 @@ void ScopeObject::SetName( const String& NewName )
 	{
 		//I'm not using "this" because I'm afraid this
 		//will get deleted when the pointer is reset() in UnRegister
-		ScopeObjectPtr pTemp = (*mpParent)[MakeCompoundID(GetName())];
 		Scope* pParentScope = this->mpParent;
+		ScopeObjectPtr pTemp = pParentScope->UnRegister( mRegisteredSymbol );
 		
-		pParentScope->UnRegister( GetName() );
 		pParentScope->Register  ( pTemp  );
 	}
 }
@@ -130,15 +167,10 @@ SS::Char* ScopeObject::GetFullName( SS::Char* Buffer, unsigned int BufferSize )
 
 
 
-//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
-void ScopeObject::SetSharedPtr( const ScopeObjectPtr& pY ){
-	mpThis = pY;
-}
-
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 void ScopeObject::UnRegister()
 {
-	if(mpParent) mpParent->UnRegister( GetName() );
+	if(mpParent) mpParent->UnRegister( mRegisteredSymbol );
 }
 
 
@@ -155,7 +187,7 @@ void ScopeObject::AssertNonConst() const
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 void ScopeObject::AssertCastingAllowed() const
 {
-	if( mpThis.expired() )
+	if( mRefCount == 0 )
 	{
 		String tmp = TXT("Cannot cast \'");
 		tmp += GetFullName();
@@ -169,12 +201,12 @@ void ScopeObject::AssertCastingAllowed() const
 //ScopeObject
 ScopeObjectPtr ScopeObject::CastToScopeObject(){
 	AssertCastingAllowed();
-	return ScopeObjectPtr(mpThis);
+	return ScopeObjectPtr( this );
 }
 
 const ScopeObjectPtr ScopeObject::CastToScopeObject() const{
 	AssertCastingAllowed();
-	return ScopeObjectPtr(mpThis);
+	return ScopeObjectPtr( const_cast<ScopeObject*>(this) );
 }
 
 //Scope
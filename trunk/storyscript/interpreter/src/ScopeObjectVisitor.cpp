@@ -25,20 +25,6 @@ ScopeObjectVisitor::~ScopeObjectVisitor() {}
 
 
 
-/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
- GetScopeObjectType
- NOTES: A wrapper for the TypeCheckVisitor
-*/
-ScopeObjectType SS::GetScopeObjectType( ScopeObjectPtr pSO )
-{
-	TypeCheckVisitor TypeChecker;
-	pSO->AcceptVisitor( TypeChecker );
-	return TypeChecker.ReturnType();
-}
-
-
-
-
 //~~~~~~~FUNCTION~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // TypeCheckVisitor:: Visit*
 // NOTES: Functions that set mType to the type that of the visited
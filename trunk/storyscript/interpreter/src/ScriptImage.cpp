@@ -0,0 +1,87 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+#include "ScriptImage.hpp"
+#include "ReaderSourceFile.hpp"
+#include "LanguageConstants.hpp"
+
+using namespace SS;
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~CLASS~~~~~~
+/*
+ NOTES: A source that reads one file from a ScriptImage.  It has no text
+ 		of its own; all it keeps is its position.
+*/
+class ReaderSourceImage : public ReaderSource
+{
+public:
+	ReaderSourceImage( const String& Name, SourceWordsPtr pWords )
+		: mName( Name )
+	{
+		UseWords( pWords );
+	}
+
+	String GetName() const { return mName; }
+
+private:
+	String GetNextLine() { return String(); }
+
+	String mName;
+};
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ScriptImage::ScriptImage()
+{
+	//The image may well be built before any interpreter is, and the
+	//tokenizer needs the operator tables.
+	InitConstants();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void ScriptImage::AddFile( const String& FileName, bool UseCache /*=false*/ )
+{
+	ReaderSourceFile File;
+	File.SetUseCache( UseCache );
+	File.Open( FileName );
+
+	mFiles[FileName] = File.FinishWords();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void ScriptImage::AddSource( ReaderSource& Source )
+{
+	mFiles[Source.GetName()] = Source.FinishWords();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool ScriptImage::HasFile( const String& FileName ) const
+{
+	return mFiles.find( FileName ) != mFiles.end();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ReaderSourcePtr ScriptImage::OpenSource( const String& FileName ) const
+{
+	FileMap::const_iterator i = mFiles.find( FileName );
+	if( i == mFiles.end() ) return ReaderSourcePtr();
+
+	return ReaderSourcePtr( new ReaderSourceImage( FileName, i->second ) );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+size_t ScriptImage::size() const
+{
+	return mFiles.size();
+}
@@ -8,6 +8,7 @@ NOTES: S-Lib functions/mvars that are miscilaneous and used often.
 
 #include "Slib-Common.hpp"
 #include "LanguageConstants.hpp"
+#include "RuntimeContext.hpp"
 #include "Variable.hpp"
 
 //Needed by print
@@ -43,10 +44,11 @@ Common::Common()
 */
 void Common::RegisterPredefined()
 {
-	Register( ScopeObjectPtr( gpNANConst ) );
-	Register( ScopeObjectPtr( gpInfinityConst ) );
-	Register( ScopeObjectPtr( gpNegInfinityConst ) );
-	Register( ScopeObjectPtr( gpNewLineConst ) );
+	RuntimeContext& Context = RuntimeContext::Current();
+	Register( ScopeObjectPtr( Context.GetNANConst() ) );
+	Register( ScopeObjectPtr( Context.GetInfinityConst() ) );
+	Register( ScopeObjectPtr( Context.GetNegInfinityConst() ) );
+	Register( ScopeObjectPtr( Context.GetNewLineConst() ) );
 }
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
@@ -78,6 +80,12 @@ void SS::SLib::LangOpts::RegisterPredefined()
 		new BoundFlagVar(      TXT("use_strict_lists"),  false, MyLangOpts.UseStrictLists ) ) );
 	Register( ScopeObjectPtr(
 		new BoundFlagVar(      TXT("verbose"),           false, MyLangOpts.Verbose ) ) );
+	Register( ScopeObjectPtr(
+		new BoundFlagVar(      TXT("use_bytecode"),      false, MyLangOpts.UseByteCode ) ) );
+	Register( ScopeObjectPtr(
+		new BoundFlagVar(      TXT("memoize_blocks"),    false, MyLangOpts.MemoizeBlocks ) ) );
+	Register( ScopeObjectPtr(
+		new BoundULongVar(     TXT("memo_cache_size"),   false, MyLangOpts.MemoCacheSize ) ) );
 }
 
 
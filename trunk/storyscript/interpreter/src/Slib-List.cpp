@@ -16,11 +16,7 @@
 #include <boost/random.hpp>
 #include "HelperFuncs.hpp"
 #include "List.hpp"
-
-//I may need to put this somewhere else if it
-//turns out that its needed other places.
-boost::mt19937 gRNG;
-//boost::uniform_smallint< boost::mt19937, unsigned int > gRNG;
+#include "RuntimeContext.hpp"
 
 
 using namespace SS;
@@ -272,7 +268,7 @@ VariableBasePtr PickOne::Operate( VariableBasePtr X )
 	if( pList->GetInternalList().size() == 0 ) return CreateVariable<Variable>( SS_BASE_ARGS_DEFAULTS, false );
 
 	boost::uniform_int<unsigned int> DistributedRandom( 0, (unsigned int)pList->GetInternalList().size() - 1 );
-	return pList->GetInternalList()[ DistributedRandom( gRNG ) ];
+	return pList->GetInternalList()[ DistributedRandom( RuntimeContext::Current().GetRNG() ) ];
 	
 	/*
 	ListPtr pList = X->CastToList();
@@ -268,11 +268,7 @@ MathConstPrec::MathConstPrec( const SS::String& Name, bool Const, MathConst& Par
 */
 VariableBasePtr MathConstPrec::operator=( const VariableBase& X )
 {
-	static const NumType MinPrecision( MPFR_PREC_MIN );
-	static const NumType MaxPrecision( MPFR_PREC_MAX );
-    
-
-	if( mpfr_less_p( X.GetNumData().get(), MinPrecision.get() ) )
+	if( mpfr_cmp_ui( X.GetNumData().get(), MPFR_PREC_MIN ) < 0 )
 	{
 		String tmp = TXT("Tried to set precision to \'");
 		tmp += X.GetStringData();
@@ -282,7 +278,7 @@ VariableBasePtr MathConstPrec::operator=( const VariableBase& X )
 		ThrowParserAnomaly( tmp, ANOMALY_BADPRECISION );
 	}
 	
-	if( mpfr_greater_p( X.GetNumData().get(), MaxPrecision.get() ) )
+	if( mpfr_cmp_ui( X.GetNumData().get(), MPFR_PREC_MAX ) > 0 )
 	{
 		String tmp = TXT("Tried to set precision to \'");
 		tmp += X.GetStringData();
@@ -297,6 +293,7 @@ VariableBasePtr MathConstPrec::operator=( const VariableBase& X )
 	
 	//regenerate the constant
 	mParent.Generate();
+	mParent.mGenerated = true;
 
 	return CastToVariableBase();
 }
@@ -336,7 +333,7 @@ StringType MathConstPrec::GetStringData() const
  NOTES: 
 */
 MathConst::MathConst( SS_DECLARE_BASE_ARGS )
-	: MagicVarBase( SS_BASE_ARGS )
+	: MagicVarBase( SS_BASE_ARGS ), mGenerated( false )
 {
 	bool WasConst = mConst;
 	SetConst( false );
@@ -359,10 +356,9 @@ VarType MathConst::GetVariableType() const
 */
 NumType MathConst::GetNumData() const
 {
-	static bool FirstCall = true;
-	if( FirstCall ){
+	if( !mGenerated ){
 		 Generate();
-		 FirstCall = false;
+		 mGenerated = true;
 	}
 	
 	return mBufferValue;
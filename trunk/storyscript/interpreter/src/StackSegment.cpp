@@ -0,0 +1,198 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+#include "StackSegment.hpp"
+#include "ParserAnomaly.hpp"
+#include "Unicode.hpp"
+
+#if defined(PLAT_WIN32)
+	#include <windows.h>
+#else
+	#include <ucontext.h>
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+
+#include <exception>
+
+using namespace SS;
+
+
+#if defined(PLAT_WIN32)
+
+//On windows each segment is a fiber, which is given its stack by the system.
+struct SegmentHandle
+{
+	void* pFiber;
+	void* pCaller;
+};
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void __stdcall StackSegment::StartFiber( void* pSegment )
+{
+	//Fibers mustn't return, so this one goes round once for every Run.
+	while( true ) StackSegment::Enter( *(StackSegment*)pSegment );
+}
+
+#else
+
+#if !defined(MAP_ANONYMOUS)
+	#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+struct SegmentHandle
+{
+	ucontext_t Segment;
+	ucontext_t Caller;
+};
+
+//makecontext can only pass ints along, so the segment is handed over here.
+static SS_THREAD_LOCAL StackSegment* gpStartingSegment = 0;
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void StackSegment::StartContext()
+{
+	StackSegment::Enter( *gpStartingSegment );
+	//Returning goes back to Caller, through uc_link.
+}
+
+#endif
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+StackSegment::StackSegment( size_t Size )
+	: mpStack( 0 ),
+	  mSize( Size ),
+	  mGuardSize( 0 ),
+	  mFunction( 0 ),
+	  mpArg( 0 ),
+	  mpError( 0 )
+{
+	SegmentHandle* pHandle = new SegmentHandle;
+	mpHandle = pHandle;
+
+#if defined(PLAT_WIN32)
+	pHandle->pFiber = CreateFiber( Size, StartFiber, this );
+	pHandle->pCaller = 0;
+	if( !pHandle->pFiber )
+	{
+		delete pHandle;
+		ThrowParserAnomaly( TXT("Couldn't make a new stack segment."), ANOMALY_PANIC );
+	}
+#else
+	//The page below the stack is left inaccessible, so running off the end
+	//of it faults straight away instead of writing over the heap.  (Fibers
+	//get one of these from windows.)
+	mGuardSize = (size_t)sysconf( _SC_PAGESIZE );
+	Size = (Size + mGuardSize - 1) / mGuardSize * mGuardSize;
+	mSize = Size;
+
+	void* pMemory = mmap( 0, mGuardSize + Size, PROT_READ | PROT_WRITE,
+						  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+	if( pMemory == MAP_FAILED )
+	{
+		delete pHandle;
+		ThrowParserAnomaly( TXT("Couldn't make a new stack segment."), ANOMALY_PANIC );
+	}
+
+	if( mprotect( pMemory, mGuardSize, PROT_NONE ) != 0 )
+	{
+		munmap( pMemory, mGuardSize + Size );
+		delete pHandle;
+		ThrowParserAnomaly( TXT("Couldn't make a new stack segment."), ANOMALY_PANIC );
+	}
+
+	mpStack = (char*)pMemory + mGuardSize;
+#endif
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+StackSegment::~StackSegment()
+{
+	SegmentHandle* pHandle = (SegmentHandle*)mpHandle;
+
+#if defined(PLAT_WIN32)
+	DeleteFiber( pHandle->pFiber );
+#else
+	munmap( mpStack - mGuardSize, mGuardSize + mSize );
+#endif
+
+	delete pHandle;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void StackSegment::Run( Function F, void* pArg )
+{
+	SegmentHandle* pHandle = (SegmentHandle*)mpHandle;
+
+	mFunction = F;
+	mpArg = pArg;
+	mpError = 0;
+
+#if defined(PLAT_WIN32)
+	bool ConvertedThread = false;
+	if( !IsThreadAFiber() )
+	{
+		ConvertThreadToFiber( 0 );
+		ConvertedThread = true;
+	}
+
+	pHandle->pCaller = GetCurrentFiber();
+	SwitchToFiber( pHandle->pFiber );
+
+	if( ConvertedThread ) ConvertFiberToThread();
+#else
+	getcontext( &pHandle->Segment );
+	pHandle->Segment.uc_stack.ss_sp = mpStack;
+	pHandle->Segment.uc_stack.ss_size = mSize;
+	pHandle->Segment.uc_link = &pHandle->Caller;
+	makecontext( &pHandle->Segment, StartContext, 0 );
+
+	gpStartingSegment = this;
+	swapcontext( &pHandle->Caller, &pHandle->Segment );
+#endif
+
+	if( mpError )
+	{
+		ParserAnomaly E( *mpError );
+		delete mpError;
+		mpError = 0;
+		throw E;
+	}
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void StackSegment::Enter( StackSegment& S )
+{
+	//Nothing can be thrown past the bottom of a segment, so it is all
+	//caught here and handed back to Run.
+	try{
+		S.mFunction( S.mpArg );
+	}
+	catch( ParserAnomaly& E )
+	{
+		S.mpError = new ParserAnomaly( E );
+	}
+	catch( std::exception& E )
+	{
+		S.mpError = new ParserAnomaly( NormalizeString( E.what() ), ANOMALY_PANIC,
+									   SS_FILE, SS_LINE, SS_FUNC );
+	}
+	catch( ... )
+	{
+		S.mpError = new ParserAnomaly( TXT("Unknown exception on a stack segment."),
+									   ANOMALY_PANIC, SS_FILE, SS_LINE, SS_FUNC );
+	}
+
+#if defined(PLAT_WIN32)
+	SwitchToFiber( ((SegmentHandle*)S.mpHandle)->pCaller );
+#endif
+}
@@ -0,0 +1,190 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+#include "SymbolTable.hpp"
+#include "ParserAnomaly.hpp"
+
+#include <boost/functional/hash.hpp>
+
+using namespace SS;
+
+
+//How many buckets the first index has.
+static const size_t FirstBucketCount = 1024;
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+static size_t HashString( const String& S )
+{
+	return boost::hash<String>()( S );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+SymbolTable& SymbolTable::Instance()
+{
+	static SymbolTable TheTable;
+	return TheTable;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+SymbolTable::SymbolTable()
+	: mCount( 0 ),
+	  mpIndex( new Index( FirstBucketCount ) )
+{
+	unsigned int i;
+	for( i = 0; i < MaxChunks; i++ ) mpChunks[i] = 0;
+
+	//Make sure the empty string is NULL_SYMBOL.
+	Intern( String() );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+SymbolTable::~SymbolTable()
+{
+	unsigned int i;
+	for( i = 0; i < MaxChunks; i++ ) delete [] mpChunks[i];
+
+	for( i = 0; i < mOldIndexes.size(); i++ ) delete mOldIndexes[i];
+	delete mpIndex;
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: Nearly always the string is already there, and this doesn't lock.
+*/
+SymbolID SymbolTable::Intern( const String& S )
+{
+	SymbolID Symbol;
+	if( Find( S, Symbol ) ) return Symbol;
+
+	MutexLock Lock( mMutex );
+
+	//Someone else may have added it while we weren't looking.
+	if( Find( S, Symbol ) ) return Symbol;
+
+	return Add( S );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void SymbolTable::Intern( const std::vector<String>& CS, CompoundSymbol& Out )
+{
+	Out.resize( CS.size() );
+
+	size_t i;
+	for( i = 0; i < CS.size(); i++ ){
+		Out[i] = Intern( CS[i] );
+	}
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: Entries are filled in before they are linked, and never changed after,
+		so following the chain needs no lock.  An index that has just been
+		outgrown may not have the newest symbols, but Intern checks again
+		under the lock before it adds anything.
+*/
+bool SymbolTable::Find( const String& S, SymbolID& Symbol ) const
+{
+	const Index& I = *AtomicLoadPointer( mpIndex );
+	size_t Bucket = HashString( S ) & (I.Buckets.size() - 1);
+
+	const Entry* pEntry;
+	for( pEntry = AtomicLoadPointer( I.Buckets[Bucket] ); pEntry; pEntry = pEntry->pNext )
+	{
+		if( *pEntry->pString == S )
+		{
+			Symbol = pEntry->Symbol;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool SymbolTable::Find( const std::vector<String>& CS, CompoundSymbol& Out ) const
+{
+	Out.resize( CS.size() );
+
+	size_t i;
+	for( i = 0; i < CS.size(); i++ ){
+		if( !Find( CS[i], Out[i] ) ) return false;
+	}
+
+	return true;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+SymbolID SymbolTable::Add( const String& S )
+{
+	if( mCount >= (size_t)MaxChunks * ChunkSize ){
+		ThrowParserAnomaly( TXT("Too many different identifiers."), ANOMALY_PANIC );
+	}
+
+	SymbolID NewSymbol = (SymbolID)mCount;
+
+	String*& pChunk = mpChunks[NewSymbol >> ChunkBits];
+	if( !pChunk ) pChunk = new String[ChunkSize];
+	pChunk[NewSymbol & (ChunkSize - 1)] = S;
+	mCount++;
+
+	//Past one symbol per bucket, the chains start getting long.
+	if( mCount > mpIndex->Buckets.size() )
+	{
+		Index* pBigger = new Index( mpIndex->Buckets.size() * 2 );
+
+		SymbolID i;
+		for( i = 0; i < (SymbolID)mCount; i++ ) Link( *pBigger, i );
+
+		mOldIndexes.push_back( mpIndex );
+		AtomicStorePointer( mpIndex, pBigger );
+	}
+	else Link( *mpIndex, NewSymbol );
+
+	return NewSymbol;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void SymbolTable::Link( Index& I, SymbolID Symbol )
+{
+	const String& S = GetString( Symbol );
+	size_t Bucket = HashString( S ) & (I.Buckets.size() - 1);
+
+	Entry NewEntry;
+	NewEntry.pString = &S;
+	NewEntry.Symbol = Symbol;
+	NewEntry.pNext = I.Buckets[Bucket];
+	I.Entries.push_back( NewEntry );
+
+	AtomicStorePointer( I.Buckets[Bucket], &I.Entries.back() );
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: Whoever has the symbol got it after the string was put in, and
+		strings never move, so this doesn't lock either.
+*/
+const String& SymbolTable::GetString( SymbolID Symbol ) const
+{
+	return mpChunks[Symbol >> ChunkBits][Symbol & (ChunkSize - 1)];
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+size_t SymbolTable::size() const
+{
+	MutexLock Lock( mMutex );
+	return mCount;
+}
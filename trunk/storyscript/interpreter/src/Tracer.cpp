@@ -0,0 +1,167 @@
+/*
+Copyright (c) 2004-2006 Daniel Jones (DanielCJones@gmail.com)
+
+This is part of the  StoryScript (AKA: SS, S^2, SSqared, etc) software.
+Full license information is included in the file in the top
+directory named "license".
+*/
+
+#include "Tracer.hpp"
+#include "HelperFuncs.hpp"
+
+#include <cstdio>
+
+using namespace SS;
+
+
+const char* const SS::TRACE_LOAD       = "load";
+const char* const SS::TRACE_BLOCK      = "block";
+const char* const SS::TRACE_EXPRESSION = "expression";
+const char* const SS::TRACE_CHOICE     = "choice";
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: Writes S as a JSON string, quotes and all.
+*/
+static void WriteJSONString( std::ostream& Out, const std::string& S )
+{
+	Out << '\"';
+
+	size_t i;
+	for( i = 0; i < S.length(); i++ )
+	{
+		unsigned char C = (unsigned char)S[i];
+
+		if( C == '\"' || C == '\\' ) Out << '\\' << (char)C;
+		else if( C == '\n' ) Out << "\\n";
+		else if( C == '\t' ) Out << "\\t";
+		else if( C < 0x20 )
+		{
+			char Escape[8];
+			std::sprintf( Escape, "\\u%04x", (unsigned int)C );
+			Out << Escape;
+		}
+		else Out << (char)C;
+	}
+
+	Out << '\"';
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Tracer::Tracer()
+	: mStartTime( GetMicroseconds() )
+{
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+Tracer::Event& Tracer::AddEvent( char Phase, const char* Category, const String& Name )
+{
+	mEvents.push_back( Event() );
+
+	Event& E = mEvents.back();
+	E.Phase = Phase;
+	E.Category = Category;
+	E.Name = Name;
+	E.Line = 0;
+	E.Time = GetTime();
+	E.Duration = 0;
+
+	return E;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Tracer::Begin( const char* Category, const String& Name,
+					const String& File /*=String()*/, unsigned long Line /*=0*/ )
+{
+	Event& E = AddEvent( 'B', Category, Name );
+	E.File = File;
+	E.Line = Line;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Tracer::End()
+{
+	//The viewer matches it up with the last 'B', so it needs nothing else.
+	AddEvent( 'E', "", String() );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Tracer::Complete( const char* Category, const String& Name, boost::uint64_t Start )
+{
+	Event& E = AddEvent( 'X', Category, Name );
+	E.Duration = E.Time > Start ? E.Time - Start : 0;
+	E.Time = Start;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Tracer::Instant( const char* Category, const String& Name )
+{
+	AddEvent( 'i', Category, Name );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+boost::uint64_t Tracer::GetTime() const
+{
+	return GetMicroseconds() - mStartTime;
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void Tracer::Clear()
+{
+	mEvents.clear();
+	mStartTime = GetMicroseconds();
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+size_t Tracer::GetEventCount() const
+{
+	return mEvents.size();
+}
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: One event per line, so the file can be looked at (and diffed)
+		without a viewer.  There is only ever one thread to speak of.
+*/
+void Tracer::Write( std::ostream& Out ) const
+{
+	Out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+	size_t i;
+	for( i = 0; i < mEvents.size(); i++ )
+	{
+		const Event& E = mEvents[i];
+
+		Out << "{\"ph\":\"" << E.Phase << "\",\"pid\":1,\"tid\":1,\"ts\":" << E.Time;
+
+		if( E.Phase != 'E' )
+		{
+			Out << ",\"cat\":\"" << E.Category << "\",\"name\":";
+			WriteJSONString( Out, NarrowizeString( E.Name ) );
+		}
+
+		if( E.Phase == 'X' ) Out << ",\"dur\":" << E.Duration;
+		if( E.Phase == 'i' ) Out << ",\"s\":\"t\"";
+
+		if( !E.File.empty() )
+		{
+			Out << ",\"args\":{\"file\":";
+			WriteJSONString( Out, NarrowizeString( E.File ) );
+			if( E.Line ) Out << ",\"line\":" << E.Line;
+			Out << "}";
+		}
+
+		Out << "}" << (i + 1 < mEvents.size() ? ",\n" : "\n");
+	}
+
+	Out << "]}\n";
+}
@@ -15,7 +15,10 @@ directory named "license".
 //#include "BaseFuncs.hpp"
 #include "List.hpp"
 #include "CreationFuncs.hpp"
+#include "NumPool.hpp"
+#include "RuntimeContext.hpp"
 #include <cstring>
+#include <vector>
 
 //Just for a quick test.  Please remove this later.
 #include <iostream>
@@ -30,44 +33,227 @@ using namespace SS;
 
 */
 
+//Inline integers have to be smaller than this...
+const boost::int64_t SMALL_LIMIT = (boost::int64_t)1 << 53;
+//...and only numbers with at least this much precision hold integers.
+const mpfr_prec_t SMALL_PRECISION = 53;
+//Powers that would be bigger than this many bits are left to mpfr.
+const unsigned long BIG_POW_LIMIT = 1 << 20;
+
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 mpfr_t_wrap::mpfr_t_wrap()
+	: mPrec( 0 ), mSmall( 0 ), mInitialized( false ), mBigInitialized( false ),
+	  mIsSmall( false ), mIsBig( false ), mSynced( false )
 {
-	mpfr_init(N);	
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 mpfr_t_wrap::mpfr_t_wrap( int prec )
+	: mPrec( prec ), mSmall( 0 ), mInitialized( false ), mBigInitialized( false ),
+	  mIsSmall( false ), mIsBig( false ), mSynced( false )
 {
-	mpfr_init2( N, prec );
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 mpfr_t_wrap::mpfr_t_wrap( const mpfr_t_wrap& X )
+	: mPrec( 0 ), mSmall( 0 ), mInitialized( false ), mBigInitialized( false ),
+	  mIsSmall( false ), mIsBig( false ), mSynced( false )
 {
-	mpfr_init(N);
-	mpfr_set( N, X.get(), LangOpts::Instance().RoundingMode );	
+	*this = X;
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 mpfr_t_wrap& mpfr_t_wrap::operator=( const mpfr_t_wrap& X )
 {
-	mpfr_set( N, X.get(), LangOpts::Instance().RoundingMode );
+	if( &X == this ) return *this;
+	
+	if( X.mIsSmall && SetSmall( X.mSmall ) ) return *this;
+	
+	if( X.mIsBig )
+	{
+		if( get_prec() >= SMALL_PRECISION )
+		{
+			InitBig();
+			mpz_set( Z, X.Z );
+			mIsSmall = false;
+			mIsBig = true;
+			mSynced = false;
+		}
+		else mpfr_set_z( get(), X.Z, LangOpts::Instance().RoundingMode );
+		
+		return *this;
+	}
+	
+	if( X.nan_p() ) return set_nan();
+	
+	mpfr_set( get(), X.read(), LangOpts::Instance().RoundingMode );
 	return *this;
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 mpfr_t_wrap::~mpfr_t_wrap()
 {
-	mpfr_clear(N);	
+	if( mInitialized ) NumPool::Release(N);	
+	if( mBigInitialized ) NumPool::Release(Z);
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void mpfr_t_wrap::Sync() const
+{
+	if( !mInitialized )
+	{
+		NumPool::Instance().Acquire( N, mPrec ? mPrec : mpfr_get_default_prec() );
+		mInitialized = true;
+	}
+	
+	if( mSynced ) return;
+	
+	//Anything smaller than SMALL_LIMIT is exact as a double.
+	if( mIsSmall )
+	{
+		mpfr_set_d( N, (double)mSmall, GMP_RNDN );
+		mSynced = true;
+	}
+	else if( mIsBig )
+	{
+		mpfr_set_z( N, Z, LangOpts::Instance().RoundingMode );
+		mSynced = true;
+	}
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 mpfr_t& mpfr_t_wrap::get() const
 {
+	Sync();
+	mIsSmall = mIsBig = false;
 	return N;	
 }
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+mpfr_srcptr mpfr_t_wrap::read() const
+{
+	Sync();
+	return N;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool mpfr_t_wrap::SetSmall( boost::int64_t X )
+{
+	if( X >= SMALL_LIMIT || X <= -SMALL_LIMIT || get_prec() < SMALL_PRECISION ) return false;
+	
+	mSmall = X;
+	mIsSmall = true;
+	mIsBig = false;
+	mSynced = false;
+	return true;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void mpfr_t_wrap::InitBig()
+{
+	if( !mBigInitialized )
+	{
+		NumPool::Instance().Acquire( Z );
+		mBigInitialized = true;
+	}
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void mpfr_t_wrap::ShrinkBig()
+{
+	//(The size of 0 is 1.)
+	if( mIsBig && mpz_sizeinbase( Z, 2 ) <= (size_t)SMALL_PRECISION )
+	{
+		mSmall = (boost::int64_t)mpz_get_d( Z );
+		mIsSmall = true;
+		mIsBig = false;
+	}
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void mpfr_t_wrap::GetInteger( mpz_ptr Out ) const
+{
+	if( mIsBig ) mpz_set( Out, Z );
+	else mpz_set_d( Out, (double)mSmall );
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool mpfr_t_wrap::BigOp( bool (*Op)( mpz_ptr, mpz_srcptr, mpz_srcptr ),
+						  const mpfr_t_wrap& A, const mpfr_t_wrap& B )
+{
+	if( get_prec() < SMALL_PRECISION ) return false;
+	
+	mpz_t SmallA, SmallB;
+	mpz_srcptr pA = A.Z, pB = B.Z;
+	
+	if( A.mIsSmall ){ NumPool::Instance().Acquire( SmallA ); A.GetInteger( SmallA ); pA = SmallA; }
+	if( B.mIsSmall ){ NumPool::Instance().Acquire( SmallB ); B.GetInteger( SmallB ); pB = SmallB; }
+	
+	//A or B may well be this, so nothing is changed until Op is done.
+	InitBig();
+	const bool Done = Op( Z, pA, pB );
+	
+	if( A.mIsSmall ) NumPool::Release( SmallA );
+	if( B.mIsSmall ) NumPool::Release( SmallB );
+	
+	if( Done )
+	{
+		mIsSmall = false;
+		mIsBig = true;
+		mSynced = false;
+		ShrinkBig();
+	}
+	
+	return Done;
+}
+
+
+/*
+	The operations BigOp performs.  Each returns false, without touching
+	the result, if the result wouldn't be a whole number (or would be
+	absurdly big).
+*/
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+static bool BigAdd( mpz_ptr R, mpz_srcptr A, mpz_srcptr B ){
+	mpz_add( R, A, B );
+	return true;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+static bool BigSub( mpz_ptr R, mpz_srcptr A, mpz_srcptr B ){
+	mpz_sub( R, A, B );
+	return true;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+static bool BigMul( mpz_ptr R, mpz_srcptr A, mpz_srcptr B ){
+	mpz_mul( R, A, B );
+	return true;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+static bool BigDiv( mpz_ptr R, mpz_srcptr A, mpz_srcptr B )
+{
+	if( !mpz_divisible_p( A, B ) ) return false;
+	mpz_divexact( R, A, B );
+	return true;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+static bool BigPow( mpz_ptr R, mpz_srcptr A, mpz_srcptr B )
+{
+	if( !mpz_fits_ulong_p( B ) ) return false;
+	
+	const unsigned long Exponent = mpz_get_ui( B );
+	if( Exponent > BIG_POW_LIMIT / mpz_sizeinbase( A, 2 ) ) return false;
+	
+	mpz_pow_ui( R, A, Exponent );
+	return true;
+}
+
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 mpfr_t_wrap& mpfr_t_wrap::set( int x )
 {
@@ -77,31 +263,374 @@ mpfr_t_wrap& mpfr_t_wrap::set( int x )
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 mpfr_t_wrap& mpfr_t_wrap::set( signed long x )
 {
-	mpfr_set_si( N, x, LangOpts::Instance().RoundingMode );
+	if( !SetSmall( x ) ) mpfr_set_si( get(), x, LangOpts::Instance().RoundingMode );
 	return *this;
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 mpfr_t_wrap& mpfr_t_wrap::set( unsigned long x )
 {
-	mpfr_set_ui( N, x, LangOpts::Instance().RoundingMode );
+	if( (boost::uint64_t)x >= (boost::uint64_t)SMALL_LIMIT || !SetSmall( (boost::int64_t)x ) ){
+		mpfr_set_ui( get(), x, LangOpts::Instance().RoundingMode );
+	}
 	return *this;	
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 mpfr_t_wrap& mpfr_t_wrap::set( double x )
 {
-	mpfr_set_d( N, x, LangOpts::Instance().RoundingMode );
+	mpfr_set_d( get(), x, LangOpts::Instance().RoundingMode );
 	return *this;	
 }
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+mpfr_t_wrap& mpfr_t_wrap::set_nan()
+{
+	mIsSmall = mIsBig = false;
+	if( mInitialized ) mpfr_set_nan( N );
+	return *this;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void mpfr_t_wrap::set_prec( mpfr_prec_t Prec )
+{
+	mIsSmall = mIsBig = false;
+	if( !mInitialized ){ mPrec = Prec; return; }
+	
+	//Swapping for a pooled number saves reallocating the limbs.
+	if( mpfr_get_prec( N ) == Prec ){ mpfr_set_nan( N ); return; }
+	NumPool::Release( N );
+	NumPool::Instance().Acquire( N, Prec );
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+mpfr_prec_t mpfr_t_wrap::get_prec() const
+{
+	if( mInitialized ) return mpfr_get_prec( N );
+	return mPrec ? mPrec : mpfr_get_default_prec();
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+void mpfr_t_wrap::compact()
+{
+	if( IsInteger() || !mInitialized || get_prec() < SMALL_PRECISION ) return;
+	
+	//This also rules out NaN and Inf.
+	if( !mpfr_integer_p( N ) ) return;
+	
+	//-0 can't be held inline.
+	if( mpfr_zero_p( N ) && MPFR_SIGN( N ) < 0 ) return;
+	
+	//Rounding can't take anything at or over the limit under it.
+	const double X = mpfr_get_d( N, GMP_RNDN );
+	if( X >= (double)SMALL_LIMIT || X <= -(double)SMALL_LIMIT ) return;
+	
+	mSmall = (boost::int64_t)X;
+	mIsSmall = true;
+	mSynced = true;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool mpfr_t_wrap::set_integer( const char* Str, int Base )
+{
+	if( get_prec() < SMALL_PRECISION ) return false;
+	
+	mpz_t Tmp;
+	NumPool::Instance().Acquire( Tmp );
+	
+	const bool Valid = mpz_set_str( Tmp, Str, Base ) == 0;
+	if( Valid )
+	{
+		InitBig();
+		mpz_swap( Z, Tmp );
+		mIsSmall = false;
+		mIsBig = true;
+		mSynced = false;
+		ShrinkBig();
+	}
+	
+	NumPool::Release( Tmp );
+	return Valid;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool mpfr_t_wrap::nan_p() const
+{
+	if( IsInteger() ) return false;
+	if( !mInitialized ) return true;
+	return mpfr_nan_p( N ) != 0;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+int mpfr_t_wrap::IntegerSign() const
+{
+	if( mIsBig ) return mpz_sgn( Z );
+	return mSmall < 0 ? -1 : (mSmall > 0 ? 1 : 0);
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+int mpfr_t_wrap::IntegerCmp( const mpfr_t_wrap& X ) const
+{
+	if( mIsSmall && X.mIsSmall ) return mSmall < X.mSmall ? -1 : (mSmall > X.mSmall ? 1 : 0);
+	if( mIsBig && X.mIsBig ) return mpz_cmp( Z, X.Z );
+	
+	//Big integers are always further from zero than small ones.
+	if( mIsBig ) return IntegerSign();
+	else return -X.IntegerSign();
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool mpfr_t_wrap::equal_p( const mpfr_t_wrap& X ) const
+{
+	if( IsInteger() && X.IsInteger() ) return IntegerCmp( X ) == 0;
+	return mpfr_equal_p( read(), X.read() ) != 0;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool mpfr_t_wrap::less_p( const mpfr_t_wrap& X ) const
+{
+	if( IsInteger() && X.IsInteger() ) return IntegerCmp( X ) < 0;
+	return mpfr_less_p( read(), X.read() ) != 0;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool mpfr_t_wrap::lessequal_p( const mpfr_t_wrap& X ) const
+{
+	if( IsInteger() && X.IsInteger() ) return IntegerCmp( X ) <= 0;
+	return mpfr_lessequal_p( read(), X.read() ) != 0;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool mpfr_t_wrap::greater_p( const mpfr_t_wrap& X ) const
+{
+	if( IsInteger() && X.IsInteger() ) return IntegerCmp( X ) > 0;
+	return mpfr_greater_p( read(), X.read() ) != 0;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+bool mpfr_t_wrap::greaterequal_p( const mpfr_t_wrap& X ) const
+{
+	if( IsInteger() && X.IsInteger() ) return IntegerCmp( X ) >= 0;
+	return mpfr_greaterequal_p( read(), X.read() ) != 0;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+int mpfr_t_wrap::cmp( const mpfr_t_wrap& X ) const
+{
+	if( IsInteger() && X.IsInteger() ) return IntegerCmp( X );
+	return mpfr_cmp( read(), X.read() );
+}
+
+
+/*
+	The arithmetic functions only use the integer forms when the result is
+	a whole number.  Zeros need care, since mpfr gives them a sign: x - x
+	is -0 when rounding down, and 0 * -x is -0.
+*/
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+mpfr_t_wrap& mpfr_t_wrap::add( const mpfr_t_wrap& A, const mpfr_t_wrap& B )
+{
+	const mpfr_rnd_t RoundingMode = LangOpts::Instance().RoundingMode;
+	
+	if( A.mIsSmall && B.mIsSmall )
+	{
+		const boost::int64_t Result = A.mSmall + B.mSmall;
+		if( (Result != 0 || RoundingMode != GMP_RNDD) && SetSmall( Result ) ) return *this;
+	}
+	
+	//(When rounding down, big integers are left to mpfr rather than checking for x - x.)
+	if( A.IsInteger() && B.IsInteger() && RoundingMode != GMP_RNDD && BigOp( BigAdd, A, B ) ){
+		return *this;
+	}
+	
+	mpfr_add( get(), A.read(), B.read(), RoundingMode );
+	compact();
+	return *this;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+mpfr_t_wrap& mpfr_t_wrap::sub( const mpfr_t_wrap& A, const mpfr_t_wrap& B )
+{
+	const mpfr_rnd_t RoundingMode = LangOpts::Instance().RoundingMode;
+	
+	if( A.mIsSmall && B.mIsSmall )
+	{
+		const boost::int64_t Result = A.mSmall - B.mSmall;
+		if( (Result != 0 || RoundingMode != GMP_RNDD) && SetSmall( Result ) ) return *this;
+	}
+	
+	if( A.IsInteger() && B.IsInteger() && RoundingMode != GMP_RNDD && BigOp( BigSub, A, B ) ){
+		return *this;
+	}
+	
+	mpfr_sub( get(), A.read(), B.read(), RoundingMode );
+	compact();
+	return *this;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+mpfr_t_wrap& mpfr_t_wrap::mul( const mpfr_t_wrap& A, const mpfr_t_wrap& B )
+{
+	if( A.IsInteger() && B.IsInteger() )
+	{
+		const int SignA = A.IntegerSign(), SignB = B.IntegerSign();
+		
+		if( SignA == 0 || SignB == 0 ){
+			if( SignA >= 0 && SignB >= 0 && SetSmall( 0 ) ) return *this;
+		}
+		else
+		{
+			if( A.mIsSmall && B.mIsSmall )
+			{
+				const boost::int64_t AbsA = SignA * A.mSmall, AbsB = SignB * B.mSmall;
+				if( AbsA <= (SMALL_LIMIT - 1) / AbsB && SetSmall( A.mSmall * B.mSmall ) ) return *this;
+			}
+			
+			if( BigOp( BigMul, A, B ) ) return *this;
+		}
+	}
+	
+	mpfr_mul( get(), A.read(), B.read(), LangOpts::Instance().RoundingMode );
+	compact();
+	return *this;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+mpfr_t_wrap& mpfr_t_wrap::div( const mpfr_t_wrap& A, const mpfr_t_wrap& B )
+{
+	if( A.IsInteger() && B.IsInteger() )
+	{
+		const int SignA = A.IntegerSign(), SignB = B.IntegerSign();
+		
+		//Division by zero, and 0 / -x (which is -0), are left to mpfr.
+		if( SignB != 0 && (SignA != 0 || SignB > 0) )
+		{
+			if( A.mIsSmall && B.mIsSmall )
+			{
+				if( A.mSmall % B.mSmall == 0 && SetSmall( A.mSmall / B.mSmall ) ) return *this;
+			}
+			else if( BigOp( BigDiv, A, B ) ) return *this;
+		}
+	}
+	
+	mpfr_div( get(), A.read(), B.read(), LangOpts::Instance().RoundingMode );
+	compact();
+	return *this;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+mpfr_t_wrap& mpfr_t_wrap::pow( const mpfr_t_wrap& A, const mpfr_t_wrap& B )
+{
+	if( A.IsInteger() && B.mIsSmall && B.mSmall >= 0 )
+	{
+		boost::int64_t e = B.mSmall;
+		
+		if( A.mIsSmall )
+		{
+			const boost::int64_t a = A.mSmall;
+			
+			if( e == 0 || a == 1 ){
+				if( SetSmall( 1 ) ) return *this;
+			}
+			else if( a == 0 ){
+				if( SetSmall( 0 ) ) return *this;
+			}
+			else if( a == -1 ){
+				if( SetSmall( e % 2 ? -1 : 1 ) ) return *this;
+			}
+			//Anything else is too big for the inline integer long before this.
+			else if( e < 64 )
+			{
+				const boost::int64_t AbsA = a < 0 ? -a : a;
+				boost::int64_t Result = 1, AbsResult = 1;
+				
+				for( ; e > 0; e-- )
+				{
+					if( AbsResult > (SMALL_LIMIT - 1) / AbsA ) break;
+					Result *= a;
+					AbsResult *= AbsA;
+				}
+				
+				if( e == 0 && SetSmall( Result ) ) return *this;
+			}
+		}
+		
+		//(0, 1 and -1 were all taken care of above.)
+		if( BigOp( BigPow, A, B ) ) return *this;
+	}
+	
+	mpfr_pow( get(), A.read(), B.read(), LangOpts::Instance().RoundingMode );
+	compact();
+	return *this;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+mpfr_t_wrap& mpfr_t_wrap::neg( const mpfr_t_wrap& A )
+{
+	if( A.mIsSmall && A.mSmall != 0 && SetSmall( -A.mSmall ) ) return *this;
+	
+	if( A.mIsBig && get_prec() >= SMALL_PRECISION )
+	{
+		InitBig();
+		mpz_neg( Z, A.Z );
+		mIsSmall = false;
+		mIsBig = true;
+		mSynced = false;
+		return *this;
+	}
+	
+	mpfr_neg( get(), A.read(), LangOpts::Instance().RoundingMode );
+	compact();
+	return *this;
+}
+
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 void SS::NumType2StringType( const NumType& In, StringType& Out )
 {
 	//Special Cases
-	if( mpfr_nan_p( In.get() ) ){ Out = TXT(""); return; }
-	if( mpfr_inf_p( In.get() ) ){ Out = TXT("%Inf%"); return; }
+	if( In.nan_p() ){ Out = TXT(""); return; }
+	
+	//Inline integers can be written straight out, as long as mpfr wouldn't
+	//have to round them.  (They are always under 17 digits.)
+	if( In.is_small() && LangOpts::Instance().NumberBase == 10 &&
+		(LangOpts::Instance().MaxDigitOutput == 0 || LangOpts::Instance().MaxDigitOutput >= 16) )
+	{
+		boost::int64_t X = In.get_small();
+		Char Buffer[20];
+		Char* pDigit = Buffer + 20;
+		
+		do{
+			boost::int64_t Digit = X % 10;
+			*--pDigit = (Char)( '0' + (Digit < 0 ? -Digit : Digit) );
+			X /= 10;
+		} while( X != 0 );
+		if( In.get_small() < 0 ) *--pDigit = '-';
+		
+		Out.assign( pDigit, Buffer + 20 );
+		return;
+	}
+	
+	//So can big ones, unless they have more digits than we're allowed.
+	if( In.is_big() )
+	{
+		const int Base = LangOpts::Instance().NumberBase;
+		std::vector<char> Buffer( mpz_sizeinbase( In.get_big(), Base ) + 2 );
+		mpz_get_str( &Buffer[0], Base, In.get_big() );
+		
+		const char* pDigits = &Buffer[0];
+		const size_t Length = strlen( pDigits );
+		const size_t Digits = Length - (pDigits[0] == '-' ? 1 : 0);
+		
+		if( LangOpts::Instance().MaxDigitOutput == 0 || Digits <= LangOpts::Instance().MaxDigitOutput )
+		{
+			Out.assign( pDigits, pDigits + Length );
+			return;
+		}
+	}
+	
+	if( mpfr_inf_p( In.read() ) ){ Out = TXT("%Inf%"); return; }
 
 	mp_exp_t Exponent = 0;
 	
@@ -110,7 +639,7 @@ void SS::NumType2StringType( const NumType& In, StringType& Out )
 				  &Exponent,
 				  LangOpts::Instance().NumberBase,
 				  LangOpts::Instance().MaxDigitOutput,
-				  In.get(),  
+				  In.read(),  
 				  LangOpts::Instance().RoundingMode );
 	
 	if( TmpString == 0 )  ThrowParserAnomaly(
@@ -183,10 +712,21 @@ void SS::StringType2NumType( const StringType& In, NumType& Out )
 {
 	//We are trusting in mpfr to do The Right Thing.
 	//We may want to check for a -1 (error) return value in the future.
+	const std::string& Narrow = NarrowizeString(In);
+	const int Result =
 	mpfr_set_str( Out.get(),
-	              NarrowizeString(In).c_str(),
+	              Narrow.c_str(),
 	              LangOpts::Instance().NumberBase,
 	              LangOpts::Instance().RoundingMode );
+	
+	Out.compact();
+	
+	//Whole numbers too big to be inline are read again exactly, in case
+	//mpfr had to round them.  (Anything with a point or an exponent
+	//is left alone.)
+	if( Result == 0 && !Out.is_small() && mpfr_integer_p( Out.read() ) && !mpfr_zero_p( Out.read() ) ){
+		Out.set_integer( Narrow.c_str(), LangOpts::Instance().NumberBase );
+	}
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
@@ -205,6 +745,7 @@ const VarType DEFAULT_VARTYPE = VARTYPE_BOOL;
 VariableBase::VariableBase( SS_DECLARE_BASE_ARGS )
 : Scope( SS_BASE_ARGS )
 {
+	mType = SCOPEOBJ_VARIABLEBASE;
 }
 
 
@@ -218,12 +759,12 @@ VariableBase::~VariableBase()
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 VariableBasePtr VariableBase::CastToVariableBase(){
 	AssertCastingAllowed();
-	return boost::dynamic_pointer_cast<VariableBase>( ScopeObjectPtr( mpThis ) );
+	return VariableBasePtr( this );
 }
 
 const VariableBasePtr VariableBase::CastToVariableBase() const{
 	AssertCastingAllowed();
-	return boost::dynamic_pointer_cast<VariableBase>( ScopeObjectPtr( mpThis ) );
+	return VariableBasePtr( const_cast<VariableBase*>(this) );
 }
 
 
@@ -281,7 +822,7 @@ StringType VariableBase::GetStringData() const{
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 NumType& VariableBase::GetNumData( NumType& Out ) const{
-	mpfr_set( Out.get(), GetNumData().get(), LangOpts::Instance().RoundingMode );
+	Out = GetNumData();
 	return Out;
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
@@ -427,7 +968,8 @@ Variable::Variable( SS_DECLARE_BASE_ARGS,
 	  mStringPart( X.mStringPart )
 	  
 {
-	mpfr_set( mNumPart.get(), X.mNumPart.get(), LangOpts::Instance().RoundingMode );
+	mType = SCOPEOBJ_VARIABLE;
+	mNumPart = X.mNumPart;
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
@@ -437,6 +979,7 @@ Variable::Variable( SS_DECLARE_BASE_ARGS )
   mNumPart( LangOpts::Instance().DefaultPrecision ),
   mBoolPart(false)
  {
+	mType = SCOPEOBJ_VARIABLE;
  	RegisterPredefinedVars();
  }
 
@@ -448,7 +991,8 @@ Variable::Variable( SS_DECLARE_BASE_ARGS,
   mCurrentType( VARTYPE_NUM ),
   mBoolPart(false)
 {
-	mpfr_set( mNumPart.get(), X.get(), LangOpts::Instance().RoundingMode );
+	mType = SCOPEOBJ_VARIABLE;
+	mNumPart = X;
 	RegisterPredefinedVars();
 }
 
@@ -461,6 +1005,7 @@ Variable::Variable( SS_DECLARE_BASE_ARGS,
   mBoolPart(false),
   mStringPart( X )
 {
+	mType = SCOPEOBJ_VARIABLE;
 	RegisterPredefinedVars();
 }
 
@@ -472,6 +1017,7 @@ Variable::Variable( SS_DECLARE_BASE_ARGS,
   mNumPart( LangOpts::Instance().DefaultPrecision ),
   mBoolPart( X )
 {
+	mType = SCOPEOBJ_VARIABLE;
 	RegisterPredefinedVars();
 }
 
@@ -495,10 +1041,14 @@ void Variable::RegisterPredefinedVars()
 
 
 
+//What GetScopeObjectHook answers to.  Interned at startup, so the name can
+//be found even before a script has used it.
+static const SymbolID PrecisionSymbol = Intern( LC_Precision );
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
-ScopeObjectPtr Variable::GetScopeObjectHook( const String& Name )
+ScopeObjectPtr Variable::GetScopeObjectHook( SymbolID Name )
 {
-	if( !mPrecisionVarCreated && Name == LC_Precision ){
+	if( !mPrecisionVarCreated && Name == PrecisionSymbol ){
 		mPrecisionVarCreated = true;
 		return Register( ScopeObjectPtr( new PrecisionVar( LC_Precision, *this ) ) );
 	}
@@ -517,13 +1067,25 @@ void Variable::AcceptVisitor( ScopeObjectVisitor& V )
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 VariablePtr Variable::CastToVariable(){
 	AssertCastingAllowed();
-	return boost::dynamic_pointer_cast<Variable>( ScopeObjectPtr(mpThis) );
+	return VariablePtr( this );
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 const VariablePtr Variable::CastToVariable() const{
 	AssertCastingAllowed();
-	return boost::dynamic_pointer_cast<Variable>( ScopeObjectPtr(mpThis) );
+	return VariablePtr( const_cast<Variable*>(this) );
+}
+
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+VariablePtr Variable::Duplicate() const
+{
+	VariablePtr pNew = CreateVariable<Variable>( UNNAMMED, true, mStringPart );
+	pNew->mCurrentType = mCurrentType;
+	pNew->mBoolPart = mBoolPart;
+	mpfr_set( pNew->mNumPart.get(), mNumPart.get(), LangOpts::Instance().RoundingMode );
+
+	return pNew;
 }
 
 
@@ -544,7 +1106,7 @@ VariableBasePtr Variable::operator+(const VariableBase& X) const
 		case VARTYPE_NUM:
 		{
 			VariablePtr tmp = CreateVariable<Variable>( SS_BASE_ARGS_DEFAULTS, false );
-			mpfr_add( tmp->mNumPart.get(), this->GetNumData().get(), X.GetNumData().get(), LangOpts::Instance().RoundingMode );
+			tmp->mNumPart.add( this->GetNumData(), X.GetNumData() );
 			tmp->mCurrentType = VARTYPE_NUM;
 			
 			return tmp;
@@ -581,7 +1143,7 @@ VariableBasePtr Variable::operator-(const VariableBase& X) const
 		case VARTYPE_NUM:
 		{
 			VariablePtr tmp = CreateVariable<Variable>( SS_BASE_ARGS_DEFAULTS, false );
-			mpfr_sub( tmp->mNumPart.get(), this->GetNumData().get(), X.GetNumData().get(), LangOpts::Instance().RoundingMode );
+			tmp->mNumPart.sub( this->GetNumData(), X.GetNumData() );
 			tmp->mCurrentType = VARTYPE_NUM;
 			
 			return tmp;
@@ -618,7 +1180,7 @@ VariableBasePtr Variable::operator*(const VariableBase& X) const
 		case VARTYPE_NUM:
 		{
 			VariablePtr tmp = CreateVariable<Variable>( SS_BASE_ARGS_DEFAULTS, false );
-			mpfr_mul( tmp->mNumPart.get(), this->GetNumData().get(), X.GetNumData().get(), LangOpts::Instance().RoundingMode );
+			tmp->mNumPart.mul( this->GetNumData(), X.GetNumData() );
 			tmp->mCurrentType = VARTYPE_NUM;
 			
 			return tmp;
@@ -648,7 +1210,7 @@ VariableBasePtr Variable::operator*(const VariableBase& X) const
 VariableBasePtr Variable::operator_pow( const VariableBase& X ) const
 {
 	VariablePtr tmp = CreateVariable<Variable>( SS_BASE_ARGS_DEFAULTS, false );
-	mpfr_pow( tmp->mNumPart.get(), GetNumData().get(), X.GetNumData().get(), LangOpts::Instance().RoundingMode );
+	tmp->mNumPart.pow( GetNumData(), X.GetNumData() );
 	tmp->mCurrentType = VARTYPE_NUM;
 	
 	return tmp;
@@ -677,7 +1239,7 @@ VariableBasePtr Variable::operator/(const VariableBase& X) const
 		case VARTYPE_NUM:
 		{
 			VariablePtr tmp = CreateVariable<Variable>( SS_BASE_ARGS_DEFAULTS, false );
-			mpfr_div( tmp->mNumPart.get(), this->GetNumData().get(), X.GetNumData().get(),LangOpts::Instance().RoundingMode );
+			tmp->mNumPart.div( this->GetNumData(), X.GetNumData() );
 			tmp->mCurrentType = VARTYPE_NUM;
 			
 			return tmp;
@@ -706,7 +1268,7 @@ VariableBasePtr Variable::operator=( const VariableBase& X )
 	//Zero everything first.  Remember that if it is not zeroed it will
 	//be assumed that the value held is the correct one.
 	this->mStringPart.clear();
-	mpfr_set_nan( mNumPart.get() );
+	mNumPart.set_nan();
 	this->mBoolPart = false;
 
 	switch( X.GetVariableType() ){
@@ -715,7 +1277,7 @@ VariableBasePtr Variable::operator=( const VariableBase& X )
 			this->mCurrentType = VARTYPE_String;
 			break;
 		case VARTYPE_NUM:
-			mpfr_set( mNumPart.get(), X.GetNumData().get(), LangOpts::Instance().RoundingMode );
+			mNumPart = X.GetNumData();
 			this->mCurrentType = VARTYPE_NUM;
 			break;
 		case VARTYPE_BOOL:
@@ -729,12 +1291,7 @@ VariableBasePtr Variable::operator=( const VariableBase& X )
 	}
 	
 
-	//return *this;
-	//return VariableBasePtr( this, null_deleter() );
-	return VariableBasePtr( 
-		boost::dynamic_pointer_cast<VariableBase>(
-			ScopeObjectPtr(mpThis) ) 
-		);
+	return CastToVariableBase();
 }
 
 
@@ -749,7 +1306,7 @@ VariableBasePtr Variable::operator==( const VariableBase& X ) const
 		case VARTYPE_NUM:
 			return VariableBasePtr(
 				CreateVariable<Variable>( SS_BASE_ARGS_DEFAULTS,
-					mpfr_equal_p( GetNumData().get(), X.GetNumData().get() ) ) );
+					GetNumData().equal_p( X.GetNumData() ) ) );
 				
 		case VARTYPE_String:
 			return VariableBasePtr(
@@ -786,7 +1343,7 @@ VariableBasePtr Variable::operator!=( const VariableBase& X ) const
 		case VARTYPE_NUM:
 			return VariableBasePtr(
 				CreateVariable<Variable>( SS_BASE_ARGS_DEFAULTS,
-					!mpfr_equal_p( GetNumData().get(), X.GetNumData().get() ) ) );
+					!GetNumData().equal_p( X.GetNumData() ) ) );
 			break;
 		case VARTYPE_String:
 			return VariableBasePtr(
@@ -823,7 +1380,7 @@ VariableBasePtr Variable::operator>=( const VariableBase& X ) const
 		case VARTYPE_NUM:
 			return VariableBasePtr(
 				CreateVariable<Variable>( SS_BASE_ARGS_DEFAULTS,
-					mpfr_greaterequal_p( GetNumData().get(), X.GetNumData().get() ) ) );
+					GetNumData().greaterequal_p( X.GetNumData() ) ) );
 
 		case VARTYPE_String:
 			return VariableBasePtr(
@@ -860,7 +1417,7 @@ VariableBasePtr Variable::operator<=( const VariableBase& X ) const
 		case VARTYPE_NUM:
 			return VariableBasePtr(
 				CreateVariable<Variable>( SS_BASE_ARGS_DEFAULTS,
-					mpfr_lessequal_p( GetNumData().get(), X.GetNumData().get() ) ) );
+					GetNumData().lessequal_p( X.GetNumData() ) ) );
 
 		case VARTYPE_String:
 			return VariableBasePtr(
@@ -896,7 +1453,7 @@ VariableBasePtr Variable::operator>( const VariableBase& X ) const
 		case VARTYPE_NUM:
 			return VariableBasePtr(
 				CreateVariable<Variable>( SS_BASE_ARGS_DEFAULTS,
-					mpfr_greater_p( GetNumData().get(), X.GetNumData().get() ) ) );
+					GetNumData().greater_p( X.GetNumData() ) ) );
 
 		case VARTYPE_String:
 			return VariableBasePtr(
@@ -931,7 +1488,7 @@ VariableBasePtr Variable::operator<( const VariableBase& X ) const
 		case VARTYPE_NUM:
 			return VariableBasePtr(
 				CreateVariable<Variable>( SS_BASE_ARGS_DEFAULTS,
-					mpfr_less_p( GetNumData().get(), X.GetNumData().get() ) ) );
+					GetNumData().less_p( X.GetNumData() ) ) );
 
 		case VARTYPE_String:
 			return VariableBasePtr(
@@ -991,7 +1548,7 @@ VariableBasePtr Variable::op_neg() const
 	default:
 	{
 		VariablePtr tmp = CreateVariable<Variable>( SS_BASE_ARGS_DEFAULTS, false );
-		mpfr_neg( tmp->mNumPart.get(), this->GetNumData().get(), LangOpts::Instance().RoundingMode );
+		tmp->mNumPart.neg( this->GetNumData() );
 		tmp->mCurrentType = VARTYPE_NUM;
 		
 		return tmp;
@@ -1028,12 +1585,17 @@ void Variable::ForceConversion( VarType Type )
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 NumType Variable::GetNumData() const
 {
-	if( ! mpfr_nan_p(mNumPart.get()) ) return mNumPart;
+	return ConvertNum();
+}
+
+const NumType& Variable::ConvertNum() const
+{
+	if( ! mNumPart.nan_p() ) return mNumPart;
 
 	if( mCurrentType == VARTYPE_BOOL )
 	{
 		if( mBoolPart ) mNumPart.set( 1 ); //I'm not sure if this a good idea, or what.
-		else mNumPart = gpNANConst->mNumPart;
+		else mNumPart = RuntimeContext::Current().GetNANConst()->mNumPart;
 	}
 	else if( mCurrentType == VARTYPE_String )
 	{
@@ -1052,7 +1614,7 @@ BoolType Variable::GetBoolData() const
 
 	if( mCurrentType == VARTYPE_NUM )
 	{
-		if( mpfr_nan_p( mNumPart.get() ) ) mBoolPart = false;
+		if( mNumPart.nan_p() ) mBoolPart = false;
 		else                              mBoolPart = true;
 	}
 	else if( mCurrentType == VARTYPE_String )
@@ -1066,6 +1628,11 @@ BoolType Variable::GetBoolData() const
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 StringType Variable::GetStringData() const
+{
+	return ConvertString();
+}
+
+const StringType& Variable::ConvertString() const
 {
 	if( !mStringPart.empty() ) return mStringPart;
 
@@ -1085,7 +1652,7 @@ StringType Variable::GetStringData() const
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 NumType& Variable::GetActualNumData()
 {
-	GetNumData(); //To make sure it has been converted.
+	ConvertNum(); //To make sure it has been converted.
 	return mNumPart;
 }
 
@@ -1100,7 +1667,7 @@ BoolType& Variable::GetActualBoolData()
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
 StringType& Variable::GetActualStringData()
 {
-	GetStringData();
+	ConvertString();
 	return mStringPart;
 }
 	
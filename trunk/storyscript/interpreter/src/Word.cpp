@@ -34,6 +34,23 @@ SS::String SS::CollapseCompoundString( const SS::CompoundString& S )
 }
 
 
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~FUNCTION~~~~~~
+ NOTES: Same thing for interned identifiers.
+*/
+SS::String SS::CollapseCompoundSymbol( const SS::CompoundSymbol& S )
+{
+	String tmp;
+	size_t i = 0;
+	for( i = 0; i < S.size(); i++ )
+	{
+		tmp += SymbolTable::Instance().GetString( S[i] );
+		if( i != S.size() - 1 ) tmp += LC_ScopeResolution;
+	}
+	
+	return tmp;	
+}
+
+
 SS::CompoundString SS::MakeCompoundString( const SS::String& S )
 {
 	return CompoundString( 1, S );	
@@ -88,7 +105,7 @@ Word::Word( WordType Type, ExtraDesc Extra /*=EXTRA_NULL*/ )
 }
 
 Word::Word( const Word& SomeWord )
-	: Str(SomeWord.Str), Type(SomeWord.Type), Extra(SomeWord.Extra)
+	: Str(SomeWord.Str), Sym(SomeWord.Sym), Type(SomeWord.Type), Extra(SomeWord.Extra)
 {
 }
 
@@ -97,6 +114,7 @@ Word::Word( const Word& SomeWord )
 Word& Word::operator=( const Word& W )
 {
 	Str = W.Str;
+	Sym = W.Sym;
 	Type = W.Type;
 	Extra = W.Extra;
 
@@ -183,6 +201,7 @@ void Word::DivideAndAssignString( const SS::String& S )
 {
 	if( S.length() == 0 ) return;
 	Str.clear();
+	Sym.clear();
 	String tmp;
 	
 	size_t i;